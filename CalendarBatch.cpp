@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        CalendarBatch.cpp
+ * @summary     Host batch calendar conversion for logged RTC records
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#include "CalendarBatch.h"
+
+#if !defined(ARDUINO)
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Register bits that are not part of the BCD value, per image position
+static const uint8_t FIELD_MASK[CCalendarBatch::IMAGE_SIZE] =
+{
+    0x7F, // clock halt
+    0x7F,
+    0x3F, // 12/24 hour select
+    0x07,
+    0x3F,
+    0x1F, // century
+    0xFF,
+};
+
+// Decoded values are staged through the stack in blocks of this many records
+static const size_t BLOCK_RECORDS = 256;
+
+// Split [0, count) into one contiguous range per thread
+template <typename F>
+static void Parallel(const size_t count, const unsigned threads, F function)
+{
+    size_t workers = (threads != 0) ? threads : std::max(1u, std::thread::hardware_concurrency());
+
+    workers = std::min(workers, std::max((size_t)1, count / CCalendarBatch::PARALLEL_MIN));
+
+    if (workers <= 1)
+    {
+        function(0, count);
+        return;
+    }
+
+    std::vector<std::thread> pool;
+    size_t step = (count + workers - 1) / workers;
+
+    for (size_t begin = step; begin < count; begin += step)
+    {
+        pool.emplace_back(function, begin, std::min(count, begin + step));
+    }
+
+    function(0, step); // Caller takes the first range
+
+    for (std::thread &thread : pool)
+    {
+        thread.join();
+    }
+}
+
+
+size_t CCalendarBatch::DecodeRegisters(const uint8_t images[], uint32_t epochs[],
+                                       const size_t count, const unsigned threads)
+{
+    std::atomic<size_t> invalid{0};
+
+    Parallel(count, threads, [&](const size_t begin, const size_t end)
+    {
+        invalid += DecodeSpan(&images[begin * IMAGE_SIZE], &epochs[begin], end - begin);
+    });
+
+    return invalid;
+}
+
+
+void CCalendarBatch::ToCalendar(const uint32_t epochs[], CRTC::RTC rtc[],
+                                const size_t count, const unsigned threads)
+{
+    Parallel(count, threads, [&](const size_t begin, const size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            CRTC::Timestamp(epochs[i]).ToRTC(rtc[i]);
+        }
+    });
+}
+
+
+void CCalendarBatch::WeekDays(const uint32_t epochs[], uint8_t week_days[],
+                              const size_t count, const unsigned threads)
+{
+    Parallel(count, threads, [&](const size_t begin, const size_t end)
+    {
+        // Plain arithmetic; left for the compiler to vectorize
+        for (size_t i = begin; i < end; i++)
+        {
+            week_days[i] = 1 + (((epochs[i] / 86400) + 6) % 7);
+        }
+    });
+}
+
+
+void CCalendarBatch::DaysOfYear(const uint32_t epochs[], uint16_t days[],
+                                const size_t count, const unsigned threads)
+{
+    Parallel(count, threads, [&](const size_t begin, const size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            days[i] = CRTC::Timestamp::DayOfYearFromDays(epochs[i] / 86400);
+        }
+    });
+}
+
+
+void CCalendarBatch::ISOWeeks(const uint32_t epochs[], uint8_t weeks[],
+                              const size_t count, const unsigned threads)
+{
+    Parallel(count, threads, [&](const size_t begin, const size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            weeks[i] = ISOWeek(epochs[i]);
+        }
+    });
+}
+
+
+/// Protected Functions ---------------------------------------
+
+void CCalendarBatch::DecodeBCD(const uint8_t images[], uint8_t decimal[], const size_t count)
+{
+    size_t bytes = count * IMAGE_SIZE;
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    // 16 records span exactly 7 vectors, so each vector has a fixed mask.
+    // Bytes holding an invalid digit decode to 0xFF.
+    const size_t BLOCK_BYTES = 16 * IMAGE_SIZE;
+    const __m128i low = _mm_set1_epi8(0x0F);
+    const __m128i nine = _mm_set1_epi8(9);
+    __m128i mask[IMAGE_SIZE];
+    uint8_t pattern[BLOCK_BYTES];
+
+    for (size_t b = 0; b < BLOCK_BYTES; b++)
+    {
+        pattern[b] = FIELD_MASK[b % IMAGE_SIZE];
+    }
+
+    for (size_t v = 0; v < IMAGE_SIZE; v++)
+    {
+        mask[v] = _mm_loadu_si128((const __m128i *)&pattern[16 * v]);
+    }
+
+    for (; (i + BLOCK_BYTES) <= bytes; i += BLOCK_BYTES)
+    {
+        for (size_t v = 0; v < IMAGE_SIZE; v++)
+        {
+            __m128i b = _mm_and_si128(_mm_loadu_si128((const __m128i *)&images[i + (16 * v)]), mask[v]);
+            __m128i ones = _mm_and_si128(b, low);
+            __m128i tens = _mm_and_si128(_mm_srli_epi16(b, 4), low);
+            __m128i bad = _mm_or_si128(_mm_cmpgt_epi8(ones, nine), _mm_cmpgt_epi8(tens, nine));
+
+            // tens * 10 = (tens << 3) + (tens << 1); nibbles never carry across bytes
+            __m128i d = _mm_add_epi8(_mm_add_epi8(_mm_slli_epi16(tens, 3), _mm_slli_epi16(tens, 1)), ones);
+            _mm_storeu_si128((__m128i *)&decimal[i + (16 * v)], _mm_or_si128(d, bad));
+        }
+    }
+#endif
+
+    for (; i < bytes; i++)
+    {
+        uint8_t b = images[i] & FIELD_MASK[i % IMAGE_SIZE];
+        uint8_t ones = b & 0x0F;
+        uint8_t tens = b >> 4;
+
+        decimal[i] = ((ones > 9) || (tens > 9)) ? 0xFF : ((10 * tens) + ones);
+    }
+}
+
+
+size_t CCalendarBatch::ToEpochs(const uint8_t decimal[], uint32_t epochs[], const size_t count)
+{
+    // Indexed by month & 0x0F so invalid months stay in bounds
+    static const uint8_t t[16] = {0, 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31, 0, 0, 0};
+    size_t invalid = 0;
+
+    // Branch free so the loop stays in the pipeline on random input
+    for (size_t i = 0; i < count; i++)
+    {
+        const uint8_t *d = &decimal[i * IMAGE_SIZE];
+        const uint8_t month = d[5];
+        const uint8_t year = d[6];
+        const bool valid = (d[0] < 60) & (d[1] < 60) & (d[2] < 24) & (year < 100) & (d[4] >= 1)
+            & (d[4] <= (t[month & 0x0F] - ((month == 2) & ((year % 4) != 0)))) & (month <= 12);
+        const uint32_t epoch = CRTC::Timestamp(year, month, d[4], d[2], d[1], d[0]).epoch;
+
+        epochs[i] = valid ? epoch : EPOCH_INVALID;
+        invalid += !valid;
+    }
+
+    return invalid;
+}
+
+
+size_t CCalendarBatch::DecodeSpan(const uint8_t images[], uint32_t epochs[], const size_t count)
+{
+    uint8_t decimal[BLOCK_RECORDS * IMAGE_SIZE];
+    size_t invalid = 0;
+
+    for (size_t i = 0; i < count; i += BLOCK_RECORDS)
+    {
+        size_t records = std::min(BLOCK_RECORDS, count - i);
+
+        DecodeBCD(&images[i * IMAGE_SIZE], decimal, records);
+        invalid += ToEpochs(decimal, &epochs[i], records);
+    }
+
+    return invalid;
+}
+
+
+uint8_t CCalendarBatch::ISOWeek(const uint32_t epoch)
+{
+    const uint16_t days = epoch / 86400;
+    const uint8_t year = CRTC::Timestamp::YearFromDays(days);
+    const int16_t day_of_year = CRTC::Timestamp::DayOfYearFromDays(days) + 1;
+    const uint8_t week_day = 1 + ((days + 5) % 7); // Monday = 1
+    int16_t week = (day_of_year - week_day + 10) / 7;
+
+    if (week < 1)
+    {
+        // Last week of the previous year: 53 when that year's 31 December
+        // fell on Thursday, or on Friday after a leap year starting Thursday
+        const uint8_t last = 1 + ((days - day_of_year + 5) % 7); // 31 December
+        const bool leap = (year != 0) && (((year - 1) % 4) == 0);
+
+        return ((last == 4) || ((last == 5) && leap)) ? 53 : 52;
+    }
+
+    if (week == 53)
+    {
+        // Same rule applied to the current year
+        const bool leap = ((year % 4) == 0);
+        const uint16_t days_in_year = leap ? 366 : 365;
+        const uint8_t last = 1 + ((days - day_of_year + days_in_year + 5) % 7);
+
+        if ((last != 4) && !((last == 5) && leap))
+        {
+            return 1;
+        }
+    }
+
+    return week;
+}
+#endif
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        CalendarBatch.h
+ * @summary     Host batch calendar conversion for logged RTC records
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#ifndef _CALENDAR_BATCH_H_
+#define _CALENDAR_BATCH_H_
+
+#include "nRTC.h"
+
+#if !defined(ARDUINO)
+#include <stddef.h>
+
+// Array versions of the per-record conversions for host post-processing.
+// Spans of at least PARALLEL_MIN records are split across threads
+// (0 = one per hardware thread). Register images use the DS1307/DS323x
+// layout: second, minute, hour, week day, day, month, year.
+class CCalendarBatch
+{
+    public:
+    static const uint32_t EPOCH_INVALID = 0xFFFFFFFF;
+    static const size_t IMAGE_SIZE = 7;
+    static const size_t PARALLEL_MIN = 65536;
+
+    // Clock halt and century bits are ignored. Records with bad BCD or
+    // out of range fields become EPOCH_INVALID; returns how many.
+    static size_t DecodeRegisters(const uint8_t images[], uint32_t epochs[],
+                                  const size_t count, const unsigned threads = 0);
+
+    static void ToCalendar(const uint32_t epochs[], CRTC::RTC rtc[],
+                           const size_t count, const unsigned threads = 0);
+
+    // Sunday = 1, as CRTC::Timestamp::WeekDay()
+    static void WeekDays(const uint32_t epochs[], uint8_t week_days[],
+                         const size_t count, const unsigned threads = 0);
+
+    // 0-365, as CRTC::Timestamp::DayOfYear()
+    static void DaysOfYear(const uint32_t epochs[], uint16_t days[],
+                           const size_t count, const unsigned threads = 0);
+
+    // ISO 8601 week number 1-53 (weeks start Monday)
+    static void ISOWeeks(const uint32_t epochs[], uint8_t weeks[],
+                         const size_t count, const unsigned threads = 0);
+
+    protected:
+    static void DecodeBCD(const uint8_t images[], uint8_t decimal[], const size_t count);
+    static size_t ToEpochs(const uint8_t decimal[], uint32_t epochs[], const size_t count);
+    static size_t DecodeSpan(const uint8_t images[], uint32_t epochs[], const size_t count);
+    static uint8_t ISOWeek(const uint32_t epoch);
+};
+#endif
+
+#endif
@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Checkpoint.cpp
+ * @summary     A/B checkpoint of application state in RTC SRAM
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#include "Checkpoint.h"
+#include "nCRC.h"
+
+CCheckpoint::CCheckpoint(CRTC &rtc, const uint8_t offset, uint8_t image[], const uint8_t bytes, const uint8_t version)
+    : m_rtc(rtc)
+    , m_image{image}
+    , m_offset{offset}
+    , m_bytes{0}
+    , m_version{version}
+    , m_slot{SLOT_NONE}
+    , m_sequence{0}
+    , m_dirty{0}
+    , m_stale{0}
+{
+    uint8_t size = rtc.GetSRAMSize();
+
+    // Two headers and two images must fit in SRAM
+    if ((bytes == 0) || (offset >= size) || ((2 * (HEADER_SIZE + (uint16_t)bytes)) > (size - offset)))
+    {
+        return; // No usable capacity
+    }
+
+    m_bytes = bytes;
+    Select(SLOT_NONE, 0, GetAllChunks());
+}
+
+
+CRTC::status_t CCheckpoint::Restore(CRTC::RTC &rtc)
+{
+    uint8_t data[RESTORE_SIZE];
+    uint8_t headers[2 * HEADER_SIZE];
+    uint8_t region = (2 * (HEADER_SIZE + m_bytes));
+    bool burst = (region <= RESTORE_SIZE);
+
+    if (m_bytes == 0)
+    {
+        return CRTC::STATUS_ERROR;
+    }
+
+    // Both headers, and both images when they fit, come with the time
+    CRTC::status_t status = m_rtc.GetRTCAndSRAM(rtc, m_offset, data, burst ? region : (2 * HEADER_SIZE));
+
+    if ((status != CRTC::STATUS_OK) && (status != CRTC::STATUS_HALTED) && (status != CRTC::STATUS_INVALID))
+    {
+        return status; // Bus failure
+    }
+
+    // Keep the headers apart so the whole buffer is free for a slot
+    for (uint8_t i = 0; i < sizeof(headers); i++)
+    {
+        headers[i] = data[i];
+    }
+
+    // Newest first; sequence numbers wrap, compare by signed difference
+    uint8_t newest = ((int8_t)(headers[HEADER_SIZE + 1] - headers[1]) > 0) ? 1 : 0;
+
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        uint8_t slot = (i == 0) ? newest : (1 - newest);
+        const uint8_t *header = &headers[slot * HEADER_SIZE];
+        uint32_t stale = GetAllChunks();
+
+        if (header[0] != m_version)
+        {
+            continue;
+        }
+
+        if (burst)
+        {
+            const uint8_t *image = &data[GetImageOffset(slot)];
+            const uint8_t *other = &data[GetImageOffset(1 - slot)];
+
+            if (!IsValid(header, image))
+            {
+                continue;
+            }
+
+            for (uint8_t j = 0; j < m_bytes; j++)
+            {
+                m_image[j] = image[j];
+            }
+
+            // Later saves to the other slot only need what differs
+            if (IsValid(&headers[(1 - slot) * HEADER_SIZE], other))
+            {
+                stale = Compare(image, other);
+            }
+        }
+        else
+        {
+            // One read per slot, checked in the buffer when it fits so a
+            // rejected slot never reaches the image
+            uint8_t *image = (m_bytes <= RESTORE_SIZE) ? data : m_image;
+            CRTC::status_t sram = m_rtc.GetSRAM(m_offset + GetImageOffset(slot), image, m_bytes);
+
+            if (sram != CRTC::STATUS_OK)
+            {
+                return sram;
+            }
+
+            if (!IsValid(header, image))
+            {
+                continue;
+            }
+
+            for (uint8_t j = 0; (image != m_image) && (j < m_bytes); j++)
+            {
+                m_image[j] = image[j];
+            }
+        }
+
+        Select(slot, header[1], stale);
+        return status;
+    }
+
+    Select(SLOT_NONE, 0, GetAllChunks());
+    return CRTC::STATUS_ERROR;
+}
+
+
+void CCheckpoint::Mark(const uint8_t offset, const uint8_t bytes)
+{
+    if ((bytes == 0) || (offset >= m_bytes))
+    {
+        return;
+    }
+
+    uint8_t last = (((uint16_t)offset + bytes) < m_bytes) ? (offset + bytes - 1) : (m_bytes - 1);
+
+    for (uint8_t chunk = (offset / CHUNK_SIZE); chunk <= (last / CHUNK_SIZE); chunk++)
+    {
+        m_dirty |= (1UL << chunk);
+    }
+}
+
+
+CRTC::status_t CCheckpoint::Save(void)
+{
+    uint8_t target = (m_slot == 0) ? 1 : 0;
+    uint8_t base = m_offset + GetImageOffset(target);
+    uint32_t pending = (m_dirty | m_stale);
+    uint8_t header[2 * HEADER_SIZE] = {0};
+    CRTC::status_t status;
+
+    if (m_bytes == 0)
+    {
+        return CRTC::STATUS_ERROR;
+    }
+
+    if ((m_dirty == 0) && (m_slot != SLOT_NONE))
+    {
+        return CRTC::STATUS_OK; // Nothing changed
+    }
+
+    // One write per run of pending chunks
+    for (uint8_t chunk = 0; chunk < GetChunks(); )
+    {
+        if (!(pending & (1UL << chunk)))
+        {
+            chunk++;
+            continue;
+        }
+
+        uint16_t start = (chunk * CHUNK_SIZE);
+
+        while ((chunk < GetChunks()) && (pending & (1UL << chunk)))
+        {
+            chunk++;
+        }
+
+        uint16_t end = ((chunk * CHUNK_SIZE) < m_bytes) ? (chunk * CHUNK_SIZE) : m_bytes;
+        status = m_rtc.SetSRAM(base + start, &m_image[start], end - start);
+
+        if (status != CRTC::STATUS_OK)
+        {
+            m_stale = GetAllChunks(); // Target now holds a partial image
+            return status;
+        }
+    }
+
+    uint8_t *slot = &header[target * HEADER_SIZE];
+    uint16_t crc;
+
+    slot[0] = m_version;
+    slot[1] = (m_sequence + 1);
+    crc = GetCRC(slot, m_image);
+    slot[2] = (crc >> 8);
+    slot[3] = crc;
+
+    if (m_slot == SLOT_NONE)
+    {
+        // Clear the other header in the same write; an image left there
+        // by an earlier run could otherwise carry a newer sequence
+        status = m_rtc.SetSRAM(m_offset, header, sizeof(header));
+    }
+    else
+    {
+        // Commit point: the header makes the new image current
+        status = m_rtc.SetSRAM(m_offset + (target * HEADER_SIZE), slot, HEADER_SIZE);
+    }
+
+    if (status != CRTC::STATUS_OK)
+    {
+        m_stale = GetAllChunks();
+        return status;
+    }
+
+    // The previous slot now lacks the changes just saved
+    Select(target, slot[1], (m_slot == SLOT_NONE) ? GetAllChunks() : m_dirty);
+    return CRTC::STATUS_OK;
+}
+
+
+CRTC::status_t CCheckpoint::Invalidate(void)
+{
+    uint8_t header[2 * HEADER_SIZE] = {0};
+
+    if (m_bytes == 0)
+    {
+        return CRTC::STATUS_ERROR;
+    }
+
+    Select(SLOT_NONE, 0, GetAllChunks());
+    return m_rtc.SetSRAM(m_offset, header, sizeof(header));
+}
+
+
+uint8_t CCheckpoint::GetSize(void)
+{
+    return m_bytes;
+}
+
+
+/// Protected Functions ---------------------------------------
+
+bool CCheckpoint::IsValid(const uint8_t header[], const uint8_t image[])
+{
+    // CRC stored big-endian, as in the event log header
+    return (header[0] == m_version) && (GetCRC(header, image) == ((header[2] << 8) | header[3]));
+}
+
+
+uint16_t CCheckpoint::GetCRC(const uint8_t header[], const uint8_t image[])
+{
+    // Version and sequence are covered so a torn header cannot validate
+    return CCRC::CRC16(image, m_bytes, CCRC::CRC16(header, 2));
+}
+
+
+uint32_t CCheckpoint::Compare(const uint8_t a[], const uint8_t b[])
+{
+    uint32_t differ = 0;
+
+    for (uint8_t i = 0; i < m_bytes; i++)
+    {
+        if (a[i] != b[i])
+        {
+            differ |= (1UL << (i / CHUNK_SIZE));
+        }
+    }
+
+    return differ;
+}
+
+
+uint8_t CCheckpoint::GetChunks(void)
+{
+    return ((m_bytes + CHUNK_SIZE - 1) / CHUNK_SIZE);
+}
+
+
+uint32_t CCheckpoint::GetAllChunks(void)
+{
+    return (GetChunks() >= 32) ? 0xFFFFFFFFUL : ((1UL << GetChunks()) - 1);
+}
+
+
+uint8_t CCheckpoint::GetImageOffset(const uint8_t slot)
+{
+    return (2 * HEADER_SIZE) + (slot * m_bytes);
+}
+
+
+void CCheckpoint::Select(const uint8_t slot, const uint8_t sequence, const uint32_t stale)
+{
+    m_slot = slot;
+    m_sequence = sequence;
+    m_stale = stale;
+    m_dirty = (slot == SLOT_NONE) ? GetAllChunks() : 0;
+}
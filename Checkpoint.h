@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Checkpoint.h
+ * @summary     A/B checkpoint of application state in RTC SRAM
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#ifndef _CHECKPOINT_H_
+#define _CHECKPOINT_H_
+
+#include "nRTC.h"
+
+// Application state image kept in battery backed SRAM across resets. The
+// region holds both slot headers [version][sequence][crc16, MSB first]
+// followed by both images. Saves go to the older slot and write its header
+// last, so an interrupted save leaves the newer image intact. Only chunks
+// changed since that slot was written are sent.
+class CCheckpoint
+{
+    public:
+    enum config_t : uint8_t
+    {
+        HEADER_SIZE     = 4,    // version, sequence, crc16
+        CHUNK_SIZE      = 8,    // Change tracking granularity
+        RESTORE_SIZE    = 32,   // Restore buffer; one burst holds images up to 12 bytes
+    };
+
+    protected:
+    enum slot_t : uint8_t
+    {
+        SLOT_NONE       = 0xFF,
+    };
+
+    CRTC &m_rtc;
+    uint8_t *m_image;
+    uint8_t m_offset;
+    uint8_t m_bytes;
+    uint8_t m_version;
+    uint8_t m_slot;         // Slot holding the newest image
+    uint8_t m_sequence;     // Sequence of the newest image
+    uint32_t m_dirty;       // Chunks changed since the last save
+    uint32_t m_stale;       // Chunks the older slot lacks
+
+    public:
+    // Checkpoint of image[0, bytes) in SRAM from offset. version identifies
+    // the image layout; an image saved with another version is ignored.
+    CCheckpoint(CRTC &rtc, const uint8_t offset, uint8_t image[], const uint8_t bytes, const uint8_t version);
+
+    // Load the newest valid image and read the time. Both slots of an image
+    // up to 12 bytes come with the time in one burst; a larger image takes
+    // one more read per slot tried. Returns the time status, or STATUS_ERROR
+    // when no valid image exists (cold boot); the image is then left as it
+    // was, except that an image over RESTORE_SIZE holds the last slot that
+    // carried this version but failed its CRC.
+    CRTC::status_t Restore(CRTC::RTC &rtc);
+
+    // Record that image[offset, offset + bytes) changed
+    void Mark(const uint8_t offset, const uint8_t bytes);
+
+    // Write marked changes; nothing is sent when none were marked
+    CRTC::status_t Save(void);
+
+    // Discard both slots so the next boot takes the cold path
+    CRTC::status_t Invalidate(void);
+
+    // Image size, 0 when the region does not fit in SRAM
+    uint8_t GetSize(void);
+
+    protected:
+    bool IsValid(const uint8_t header[], const uint8_t image[]);
+    uint16_t GetCRC(const uint8_t header[], const uint8_t image[]);
+    uint32_t Compare(const uint8_t a[], const uint8_t b[]);
+    uint8_t GetChunks(void);
+    uint32_t GetAllChunks(void);
+    uint8_t GetImageOffset(const uint8_t slot);
+    void Select(const uint8_t slot, const uint8_t sequence, const uint32_t stale);
+};
+
+#endif
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        ClockService.cpp
+ * @summary     Seqlock published RTC snapshot for lock-free readers
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#include "ClockService.h"
+#include "RTCPlatform.h"
+
+static uint32_t DefaultTick(void)
+{
+    return millis();
+}
+
+#if defined(ARDUINO)
+#define Barrier() __asm__ __volatile__("" ::: "memory")
+
+static inline uint32_t LoadRelaxed(const volatile uint32_t &word)
+{
+    return word;
+}
+
+static inline uint32_t LoadAcquire(const volatile uint32_t &word)
+{
+    uint32_t value = word;
+    Barrier();
+    return value;
+}
+
+static inline void StoreRelaxed(volatile uint32_t &word, const uint32_t value)
+{
+    word = value;
+}
+
+static inline void StoreRelease(volatile uint32_t &word, const uint32_t value)
+{
+    Barrier();
+    word = value;
+}
+
+static inline void FenceAcquire(void)
+{
+    Barrier();
+}
+
+static inline void FenceRelease(void)
+{
+    Barrier();
+}
+#else
+static inline uint32_t LoadRelaxed(const std::atomic<uint32_t> &word)
+{
+    return word.load(std::memory_order_relaxed);
+}
+
+static inline uint32_t LoadAcquire(const std::atomic<uint32_t> &word)
+{
+    return word.load(std::memory_order_acquire);
+}
+
+static inline void StoreRelaxed(std::atomic<uint32_t> &word, const uint32_t value)
+{
+    word.store(value, std::memory_order_relaxed);
+}
+
+static inline void StoreRelease(std::atomic<uint32_t> &word, const uint32_t value)
+{
+    word.store(value, std::memory_order_release);
+}
+
+static inline void FenceAcquire(void)
+{
+    std::atomic_thread_fence(std::memory_order_acquire);
+}
+
+static inline void FenceRelease(void)
+{
+    std::atomic_thread_fence(std::memory_order_release);
+}
+#endif
+
+
+CClockService::CClockService(CRTC &rtc)
+    : CClockService(rtc, DefaultTick)
+{
+    // empty
+}
+
+
+CClockService::CClockService(CRTC &rtc, tick_t tick)
+    : m_rtc(rtc)
+    , m_tick{tick}
+    , m_sequence{0}
+    , m_epoch{0}
+    , m_poll_tick{0}
+    , m_status{CRTC::STATUS_ERROR}
+#if !defined(ARDUINO)
+    , m_thread()
+    , m_running{false}
+#endif
+{
+    // empty
+}
+
+
+CClockService::~CClockService(void)
+{
+#if !defined(ARDUINO)
+    Stop();
+#endif
+}
+
+
+CRTC::status_t CClockService::Poll(void)
+{
+    Snapshot snapshot;
+
+    // A failed read publishes the cached time flagged as stale
+    snapshot.status = m_rtc.GetTimestamp(snapshot.time);
+    snapshot.tick = m_tick();
+
+    Publish(snapshot);
+    return snapshot.status;
+}
+
+
+void CClockService::Publish(const Snapshot &snapshot)
+{
+    uint32_t sequence = LoadRelaxed(m_sequence);
+
+    // Odd sequence marks the update in progress
+    StoreRelaxed(m_sequence, sequence + 1);
+    FenceRelease();
+
+    StoreRelaxed(m_epoch, snapshot.time.epoch);
+    StoreRelaxed(m_poll_tick, snapshot.tick);
+    StoreRelaxed(m_status, snapshot.status);
+
+    StoreRelease(m_sequence, sequence + 2);
+}
+
+
+bool CClockService::Read(Snapshot &snapshot) const
+{
+    for (uint8_t attempt = 0; ; attempt++)
+    {
+#if defined(ARDUINO)
+        if (attempt >= READ_ATTEMPTS)
+        {
+            return false; // Owner was preempted by this reader
+        }
+#else
+        if (attempt >= READ_ATTEMPTS)
+        {
+            std::this_thread::yield(); // Owner thread may be descheduled
+        }
+#endif
+
+        uint32_t before = LoadAcquire(m_sequence);
+
+        if (before & 1)
+        {
+            continue; // Owner is mid-update
+        }
+
+        uint32_t epoch = LoadRelaxed(m_epoch);
+        uint32_t tick = LoadRelaxed(m_poll_tick);
+        uint32_t status = LoadRelaxed(m_status);
+
+        FenceAcquire();
+
+        if (LoadRelaxed(m_sequence) == before)
+        {
+            snapshot.time = CRTC::Timestamp(epoch);
+            snapshot.tick = tick;
+            snapshot.status = (CRTC::status_t)status;
+            return true;
+        }
+    }
+}
+
+
+CRTC::status_t CClockService::GetRTC(CRTC::RTC &rtc) const
+{
+    Snapshot snapshot;
+
+    if (!Read(snapshot))
+    {
+        return CRTC::STATUS_TIMEOUT;
+    }
+
+    snapshot.time.ToRTC(rtc);
+    return snapshot.status;
+}
+
+
+CRTC::status_t CClockService::GetEpoch(uint32_t &epoch) const
+{
+    Snapshot snapshot;
+
+    if (!Read(snapshot))
+    {
+        return CRTC::STATUS_TIMEOUT;
+    }
+
+    epoch = snapshot.time.epoch;
+    return snapshot.status;
+}
+
+
+uint32_t CClockService::GetGeneration(void) const
+{
+    return (LoadAcquire(m_sequence) / 2);
+}
+
+
+#if !defined(ARDUINO)
+void CClockService::Start(const uint32_t period_ms)
+{
+    Stop();
+    m_running = true;
+
+    m_thread = std::thread([this, period_ms]()
+    {
+        while (m_running.load(std::memory_order_relaxed))
+        {
+            Poll();
+            std::this_thread::sleep_for(std::chrono::milliseconds(period_ms));
+        }
+    });
+}
+
+
+void CClockService::Stop(void)
+{
+    m_running = false;
+
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+#endif
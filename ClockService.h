@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        ClockService.h
+ * @summary     Seqlock published RTC snapshot for lock-free readers
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#ifndef _CLOCK_SERVICE_H_
+#define _CLOCK_SERVICE_H_
+
+#include "nRTC.h"
+
+#if !defined(ARDUINO)
+#include <atomic>
+#include <thread>
+#endif
+
+// One owner polls the device and publishes each decoded read under a
+// sequence counter. Readers copy the snapshot and retry if the counter
+// was odd or changed meanwhile, so they never block the owner or touch
+// the bus. On AVR the owner may be preempted by an ISR reader, which then
+// gives up after a few attempts instead of spinning.
+class CClockService
+{
+    public:
+    // Millisecond tick source, e.g. millis()
+    typedef uint32_t (*tick_t)(void);
+
+    struct Snapshot
+    {
+        Snapshot()
+            : time()
+            , tick{0}
+            , status{CRTC::STATUS_ERROR}
+        {
+            // empty
+        }
+
+        CRTC::Timestamp time;
+        uint32_t tick;          // Tick when the device was read
+        CRTC::status_t status;  // Status of that read
+    };
+
+    protected:
+    enum config_t : uint8_t
+    {
+        READ_ATTEMPTS   = 8,    // Before giving up (AVR) or yielding (host)
+    };
+
+#if defined(ARDUINO)
+    typedef volatile uint32_t word_t;
+#else
+    typedef std::atomic<uint32_t> word_t;
+#endif
+
+    CRTC &m_rtc;
+    tick_t m_tick;
+    word_t m_sequence;
+    word_t m_epoch;
+    word_t m_poll_tick;
+    word_t m_status;
+
+#if !defined(ARDUINO)
+    std::thread m_thread;
+    std::atomic<bool> m_running;
+#endif
+
+    public:
+    CClockService(CRTC &rtc);
+    CClockService(CRTC &rtc, tick_t tick);
+    ~CClockService(void);
+
+    // Owner only: read the device and publish the result
+    CRTC::status_t Poll(void);
+    void Publish(const Snapshot &snapshot);
+
+    // Any reader: false on AVR when no consistent copy was obtained
+    bool Read(Snapshot &snapshot) const;
+    CRTC::status_t GetRTC(CRTC::RTC &rtc) const;
+    CRTC::status_t GetEpoch(uint32_t &epoch) const;
+
+    // Number of snapshots published so far
+    uint32_t GetGeneration(void) const;
+
+#if !defined(ARDUINO)
+    // Dedicated poller thread owning the device
+    void Start(const uint32_t period_ms);
+    void Stop(void);
+#endif
+};
+
+#endif
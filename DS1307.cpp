@@ -33,49 +33,6 @@ void CDS1307::Initialize(void)
 }
 
 
-void CDS1307::GetRTC(CRTC::RTC &rtc)
-{
-    uint8_t data[7];
-
-    if (CRTC::I2CRead(ADDRESS_TIME, data, 7) == CRTC::STATUS_OK)
-    {
-        // Clear clock halt bit from read data
-        data[0] &= ~(BITMASK_CLOCK_HALT); // clear bit
-        
-        m_rtc.second        = CRTC::BCD_to_DEC(data[0]);
-        m_rtc.minute        = CRTC::BCD_to_DEC(data[1]);
-        m_rtc.hour          = CRTC::BCD_to_DEC(data[2]);
-        m_rtc.day           = CRTC::BCD_to_DEC(data[4]);
-        m_rtc.month         = CRTC::BCD_to_DEC(data[5]); // month 1-12
-        m_rtc.year          = CRTC::BCD_to_DEC(data[6]); // year 0-99
-        m_rtc.week_day      = CRTC::BCD_to_DEC(data[3]); // week 1-7
-
-        m_rtc.am            = (m_rtc.hour < 12);
-        m_rtc.twelve_hour   = (m_rtc.hour % 12);
-        m_rtc.twelve_hour  += (m_rtc.twelve_hour == 0) ? 12 : 0;
-    }
-
-    rtc = m_rtc;
-}
-
-
-CRTC::status_t CDS1307::SetRTC(const CRTC::RTC &rtc)
-{
-    uint8_t data[7] =
-    {
-        CRTC::DEC_to_BCD(rtc.second),
-        CRTC::DEC_to_BCD(rtc.minute),
-        CRTC::DEC_to_BCD(rtc.hour),
-        CRTC::DEC_to_BCD(DayOfWeek(rtc.year, rtc.month, rtc.day)),
-        CRTC::DEC_to_BCD(rtc.day),
-        CRTC::DEC_to_BCD(rtc.month),
-        CRTC::DEC_to_BCD(rtc.year)
-    };
-
-    return CRTC::I2CWrite(ADDRESS_TIME, data, 7);
-}
-
-
 CRTC::status_t CDS1307::AlarmReset(void)
 {
     uint8_t data[3] =
@@ -103,7 +60,7 @@ CRTC::status_t CDS1307::SetAlarmRTC(const CRTC::RTC &rtc)
         return SetAlarmState(CRTC::State::ENABLE);
     }
 
-    return CRTC::STATUS_ERROR;
+    return m_status;
 }
 
 
@@ -114,16 +71,26 @@ CRTC::status_t CDS1307::SetAlarmState(const CRTC::State state)
 }
 
 
-void CDS1307::GetAlarmRTC(CRTC::RTC &rtc)
+CRTC::status_t CDS1307::GetAlarmRTC(CRTC::RTC &rtc)
 {
     uint8_t data[3];
+    CRTC::status_t status = CRTC::I2CRead(ADDRESS_ALARM, data, 3);
 
-    if (CRTC::I2CRead(ADDRESS_ALARM, data, 3) == CRTC::STATUS_OK)
+    if (status == CRTC::STATUS_OK)
     {
         rtc.second = data[0];
         rtc.minute = data[1];
         rtc.hour = data[2];
     }
+
+    return status;
+}
+
+
+CRTC::status_t CDS1307::GetAlarmState(CRTC::State &state)
+{
+    state = CRTC::State::ENABLE;
+    return CRTC::STATUS_OK;
 }
 
 
@@ -133,31 +100,54 @@ CRTC::State CDS1307::GetAlarmState(void)
 }
 
 
-bool CDS1307::IsAlarmTriggered(void)
+CRTC::status_t CDS1307::IsAlarmTriggered(bool &triggered)
 {
-    return (CRTC::GetAlarmSeconds() == CRTC::GetTimeSeconds());
+    uint32_t alarm = CRTC::GetAlarmSeconds();
+
+    // A failed read leaves stale values that must not be compared
+    if (m_status != CRTC::STATUS_OK)
+    {
+        return m_status;
+    }
+
+    uint32_t time = CRTC::GetTimeSeconds();
+
+    if (m_status == CRTC::STATUS_OK)
+    {
+        triggered = (alarm == time);
+    }
+
+    return m_status;
 }
 
 
-CRTC::status_t CDS1307::GetSRAM(const uint8_t offset, uint8_t data[], const uint8_t bytes)
+bool CDS1307::IsAlarmTriggered(void)
 {
-    return CRTC::I2CRead(ADDRESS_SRAM + offset, data, CRTC::FitSRAMRange(offset, bytes));
+    bool triggered = false;
+
+    IsAlarmTriggered(triggered);
+    return triggered;
 }
 
 
-CRTC::status_t CDS1307::SetSRAM(const uint8_t offset, const uint8_t data[], const uint8_t bytes)
+uint32_t CDS1307::GetReferenceFrequency(void)
 {
-    return CRTC::I2CWrite(ADDRESS_SRAM + offset, data, CRTC::FitSRAMRange(offset, bytes));
+    return 32768;
 }
 
 
-uint8_t CDS1307::GetSRAMSize(void)
+CRTC::status_t CDS1307::StartReference(uint8_t &saved)
 {
-    return SRAM_SIZE;
+    if (CRTC::I2CReadByte(ADDRESS_CONTROL, saved) == CRTC::STATUS_OK)
+    {
+        return CRTC::I2CWriteByte(ADDRESS_CONTROL, BITMASK_SQUARE_WAVE);
+    }
+
+    return m_status;
 }
 
 
-uint8_t CDS1307::GetI2CAddress(void)
+CRTC::status_t CDS1307::StopReference(const uint8_t saved)
 {
-    return ADDRESS_I2C;
+    return CRTC::I2CWriteByte(ADDRESS_CONTROL, saved);
 }
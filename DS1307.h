@@ -28,55 +28,52 @@
 #ifndef _DS1307_H_
 #define _DS1307_H_
 
-#include "nRTC.h"
-#define UNUSED(x) (void)(x)
+#include "RegisterMap.h"
 
-class CDS1307 : public CRTC
+struct DS1307Map : public RegisterMap
+{
+    static constexpr uint8_t I2C        = 0x68;
+    static constexpr uint8_t HALT_MASK  = 0x80; // Clock halt
+    static constexpr uint8_t SRAM       = 0x0B; // Reserve 0x8-0xA for Alarm
+    static constexpr uint8_t SRAM_SIZE  = (0x3F - SRAM);
+
+    typedef RegisterSpan<0x00, 0x0A> Scope; // Time, control and SRAM alarm
+};
+
+class CDS1307 : public CMappedRTC<DS1307Map>
 {
     private:
-    enum I2C : uint8_t
-    {
-        ADDRESS_I2C         = 0x68,
-    };
-    
     enum address_t : uint8_t
     {
         ADDRESS_TIME        = 0x00,
         ADDRESS_DAY         = 0x03,
         ADDRESS_DATE        = 0x04,
+        ADDRESS_CONTROL     = 0x07,
         ADDRESS_ALARM       = 0x08,
-        ADDRESS_SRAM        = 0x0B, // Reserve 0x8-0xA for Alarm
     };
     
     enum bitmask_t : uint8_t
     {
-        BITMASK_CLOCK_HALT  = 0x80,
-    };
-    
-    enum sram_t : uint8_t
-    {
-        SRAM_SIZE           = (0x3F - ADDRESS_SRAM),
+        BITMASK_SQUARE_WAVE = 0x13, // SQWE with RS1:0 at 32.768kHz
     };
     
     public:
     
     void Initialize(void);
-    void GetRTC(CRTC::RTC &rtc);
-    CRTC::status_t SetRTC(const CRTC::RTC &rtc);
     
     CRTC::status_t AlarmReset(void);
     CRTC::status_t SetAlarmRTC(const CRTC::RTC &rtc);
     CRTC::status_t SetAlarmState(const CRTC::State state);
-    void GetAlarmRTC(CRTC::RTC &rtc);
+    CRTC::status_t GetAlarmRTC(CRTC::RTC &rtc);
+    CRTC::status_t GetAlarmState(CRTC::State &state);
     CRTC::State GetAlarmState(void);
+    CRTC::status_t IsAlarmTriggered(bool &triggered);
     bool IsAlarmTriggered(void);
-
-    CRTC::status_t GetSRAM(const uint8_t offset, uint8_t data[], const uint8_t bytes);
-    CRTC::status_t SetSRAM(const uint8_t offset, const uint8_t data[], const uint8_t bytes);
     
-    private:
-    uint8_t GetSRAMSize(void);
-    uint8_t GetI2CAddress(void);
+    // 32.768kHz SQW/OUT as calibration reference
+    uint32_t GetReferenceFrequency(void);
+    CRTC::status_t StartReference(uint8_t &saved);
+    CRTC::status_t StopReference(const uint8_t saved);
 };
 
 #endif
@@ -29,60 +29,43 @@
 
 void CDS3231::Initialize(void)
 {
-    CRTC::Initialize(); // Setup i2c
-    uint8_t b = CRTC::I2CReadByte(ADDRESS_STATUS);
-    b &= ~(BITMASK_32KHZ_OUTPUT); // disable 32KHZ output
-    CRTC::I2CWriteByte(ADDRESS_STATUS, b);
-}
-
+    uint8_t b;
 
-void CDS3231::GetRTC(CRTC::RTC &rtc)
-{
-    uint8_t data[7];
+    CRTC::Initialize(); // Setup i2c
 
-    if (CRTC::I2CRead(ADDRESS_TIME, data, 7) == CRTC::STATUS_OK)
+    if (CRTC::I2CReadByte(ADDRESS_STATUS, b) == CRTC::STATUS_OK)
     {
-        // Clear clock halt bit from read data
-        data[0] &= ~(BITMASK_CLOCK_HALT); // clear bit
-
-        m_rtc.second        = CRTC::BCD_to_DEC(data[0]);
-        m_rtc.minute        = CRTC::BCD_to_DEC(data[1]);
-        m_rtc.hour          = CRTC::BCD_to_DEC(data[2]);
-        m_rtc.day           = CRTC::BCD_to_DEC(data[4]);
-        m_rtc.month         = CRTC::BCD_to_DEC(data[5]); // month 1-12
-        m_rtc.year          = CRTC::BCD_to_DEC(data[6]); // year 0-99
-        m_rtc.week_day      = CRTC::BCD_to_DEC(data[3]); // week 1-7
-
-        m_rtc.am            = (m_rtc.hour < 12);
-        m_rtc.twelve_hour   = (m_rtc.hour % 12);
-        m_rtc.twelve_hour  += (m_rtc.twelve_hour == 0) ? 12 : 0;
+        b &= ~(BITMASK_32KHZ_OUTPUT); // disable 32KHZ output
+        CRTC::I2CWriteByte(ADDRESS_STATUS, b);
     }
-
-    rtc = m_rtc;
 }
 
 
-CRTC::status_t CDS3231::SetRTC(const CRTC::RTC &rtc)
+CRTC::status_t CDS3231::GetSnapshot(CRTC::RTC &rtc)
 {
-    uint8_t data[7] =
+    uint8_t data[ADDRESS_STATUS + 1];
+
+    // Time through status in one burst so OSF comes at no extra transaction
+    if (CRTC::I2CRead(ADDRESS_TIME, data, sizeof(data)) == CRTC::STATUS_OK)
     {
-        CRTC::DEC_to_BCD(rtc.second),
-        CRTC::DEC_to_BCD(rtc.minute),
-        CRTC::DEC_to_BCD(rtc.hour),
-        CRTC::DEC_to_BCD(DayOfWeek(rtc.year, rtc.month, rtc.day)),
-        CRTC::DEC_to_BCD(rtc.day),
-        CRTC::DEC_to_BCD(rtc.month),
-        CRTC::DEC_to_BCD(rtc.year)
-    };
+        return Decode(data, rtc, (data[ADDRESS_STATUS] & BITMASK_OSF));
+    }
 
-    return CRTC::I2CWrite(ADDRESS_TIME, data, 7);
+    m_time.ToRTC(rtc); // Fall back to cached value
+    return CRTC::STATUS_STALE;
 }
 
 
 CRTC::status_t CDS3231::AlarmReset(void)
 {
+    uint8_t b;
+
+    if (CRTC::I2CReadByte(ADDRESS_STATUS, b) != CRTC::STATUS_OK)
+    {
+        return m_status;
+    }
+
     // Clear alarm flag
-    uint8_t b = CRTC::I2CReadByte(ADDRESS_STATUS);
     b &= ~(BITMASK_ALARM_FLAG);
 
     return CRTC::I2CWriteByte(ADDRESS_STATUS, b);
@@ -104,14 +87,19 @@ CRTC::status_t CDS3231::SetAlarmRTC(const CRTC::RTC &rtc)
         return SetAlarmState(CRTC::State::ENABLE);
     }
 
-    return CRTC::STATUS_ERROR;
+    return m_status;
 }
 
 
 CRTC::status_t CDS3231::SetAlarmState(const CRTC::State state)
 {
+    uint8_t b;
+
     // Read alarm flag
-    uint8_t b = CRTC::I2CReadByte(ADDRESS_CTRL);
+    if (CRTC::I2CReadByte(ADDRESS_CTRL, b) != CRTC::STATUS_OK)
+    {
+        return m_status;
+    }
 
     // Set bit
     b ^= (-(state == CRTC::State::ENABLE) ^ b) & (BITMASK_ALARM_FLAG);
@@ -122,64 +110,143 @@ CRTC::status_t CDS3231::SetAlarmState(const CRTC::State state)
         return AlarmReset();
     }
 
-    return CRTC::STATUS_ERROR;
+    return m_status;
 }
 
 
-void CDS3231::GetAlarmRTC(CRTC::RTC &rtc)
+CRTC::status_t CDS3231::GetAlarmRTC(CRTC::RTC &rtc)
 {
     uint8_t data[3];
+    CRTC::status_t status = CRTC::I2CRead(ADDRESS_ALARM, data, 3);
 
-    if (CRTC::I2CRead(ADDRESS_ALARM, data, 3) == CRTC::STATUS_OK)
+    if (status == CRTC::STATUS_OK)
     {
         rtc.second  = CRTC::BCD_to_DEC(data[0] & ~BITMASK_ALARM_TOGGLE);
         rtc.minute  = CRTC::BCD_to_DEC(data[1] & ~BITMASK_ALARM_TOGGLE);
         rtc.hour    = CRTC::BCD_to_DEC(data[2] & ~BITMASK_ALARM_TOGGLE);
     }
+
+    return status;
+}
+
+
+CRTC::status_t CDS3231::GetAlarmState(CRTC::State &state)
+{
+    uint8_t b;
+
+    if (CRTC::I2CReadByte(ADDRESS_CTRL, b) == CRTC::STATUS_OK)
+    {
+        state = (b & BITMASK_ALARM_FLAG) ? CRTC::State::ENABLE : CRTC::State::DISABLE;
+    }
+
+    return m_status;
 }
 
 
 CRTC::State CDS3231::GetAlarmState(void)
+{
+    CRTC::State state = CRTC::State::DISABLE;
+
+    GetAlarmState(state);
+    return state;
+}
+
+
+CRTC::status_t CDS3231::IsAlarmTriggered(bool &triggered)
 {
     uint8_t b;
 
-    if ((b = CRTC::I2CReadByte(ADDRESS_CTRL)))
+    if (CRTC::I2CReadByte(ADDRESS_STATUS, b) == CRTC::STATUS_OK)
     {
-        return (b & BITMASK_ALARM_FLAG) ? CRTC::State::ENABLE : CRTC::State::DISABLE;
+        triggered = !!(b & BITMASK_ALARM_FLAG);
     }
 
-    return CRTC::State::DISABLE;
+    return m_status;
 }
 
 
 bool CDS3231::IsAlarmTriggered(void)
 {
-    uint8_t b;
+    bool triggered = false;
+
+    IsAlarmTriggered(triggered);
+    return triggered;
+}
+
 
-    if ((b = CRTC::I2CReadByte(ADDRESS_STATUS)))
+CRTC::status_t CDS3231::GetTemperature(float &temperature)
+{
+    uint8_t data[2];
+
+    // Read MSB and LSB in one burst so they belong to the same conversion
+    if (CRTC::I2CRead(ADDRESS_TEMPERATURE, data, 2) == CRTC::STATUS_OK)
     {
-        return !!(b & BITMASK_ALARM_FLAG);
+        // Two's complement with 0.25C resolution
+        temperature = ((int16_t)((data[0] << 8) | data[1]) >> 6) / 4.0f;
     }
 
-    return false;
+    return m_status;
 }
 
 
 float CDS3231::GetTemperature(void)
 {
-    uint16_t msb, lsb;
+    float temperature = 0;
+
+    GetTemperature(temperature);
+    return temperature;
+}
 
-    msb = CRTC::I2CReadByte(ADDRESS_TEMPERATURE);
-    lsb = CRTC::I2CReadByte(ADDRESS_TEMPERATURE + 1);
 
-    return (((msb << 8) | lsb) >> 6) / 4.0f;
+CRTC::status_t CDS3231::GetAgingOffset(int8_t &offset)
+{
+    uint8_t b;
+
+    if (CRTC::I2CReadByte(ADDRESS_AGING, b) == CRTC::STATUS_OK)
+    {
+        offset = (int8_t)b;
+    }
+
+    return m_status;
+}
+
+
+int8_t CDS3231::GetAgingOffset(void)
+{
+    int8_t offset = 0;
+
+    GetAgingOffset(offset);
+    return offset;
+}
+
+
+CRTC::status_t CDS3231::SetAgingOffset(const int8_t offset)
+{
+    if (CRTC::I2CWriteByte(ADDRESS_AGING, (uint8_t)offset) == CRTC::STATUS_OK)
+    {
+        uint8_t b;
+
+        // Offset is applied on the next temperature conversion; force one now
+        if (CRTC::I2CReadByte(ADDRESS_CTRL, b) == CRTC::STATUS_OK)
+        {
+            b |= BITMASK_CONVERT;
+            return CRTC::I2CWriteByte(ADDRESS_CTRL, b);
+        }
+    }
+
+    return m_status;
 }
 
 
 CRTC::status_t CDS3231::SetSquareWave(const bool state, const uint8_t frequency)
 {
+    uint8_t b;
+
     // Read control register
-    uint8_t b = CRTC::I2CReadByte(ADDRESS_CTRL);
+    if (CRTC::I2CReadByte(ADDRESS_CTRL, b) != CRTC::STATUS_OK)
+    {
+        return m_status;
+    }
 
     if (state)
     {
@@ -197,13 +264,56 @@ CRTC::status_t CDS3231::SetSquareWave(const bool state, const uint8_t frequency)
 }
 
 
-void CDS3231::GetSquareWave(bool &state, uint8_t &frequency)
+CRTC::status_t CDS3231::GetSquareWave(bool &state, uint8_t &frequency)
 {
+    uint8_t b;
+
     // Read control register
-    uint8_t b = CRTC::I2CReadByte(ADDRESS_CTRL);
+    if (CRTC::I2CReadByte(ADDRESS_CTRL, b) == CRTC::STATUS_OK)
+    {
+        state = ((b & BITMASK_SQUARE_WAVE) >> 2);
+        frequency = ((b & BITMASK_FREQUENCY) >> 3);
+    }
+
+    return m_status;
+}
+
+
+uint32_t CDS3231::GetReferenceFrequency(void)
+{
+    return 32768;
+}
+
+
+CRTC::status_t CDS3231::StartReference(uint8_t &saved)
+{
+    uint8_t b;
+
+    if (CRTC::I2CReadByte(ADDRESS_STATUS, b) != CRTC::STATUS_OK)
+    {
+        return m_status;
+    }
+
+    saved = (b & BITMASK_EN32KHZ);
+
+    // Flags written as 1 are left alone, so one raised since the read is kept
+    return CRTC::I2CWriteByte(ADDRESS_STATUS, b | BITMASK_EN32KHZ | BITMASK_STATUS_FLAGS);
+}
+
+
+CRTC::status_t CDS3231::StopReference(const uint8_t saved)
+{
+    uint8_t b;
+
+    if (CRTC::I2CReadByte(ADDRESS_STATUS, b) != CRTC::STATUS_OK)
+    {
+        return m_status;
+    }
+
+    b &= ~(BITMASK_EN32KHZ);
+    b |= (saved & BITMASK_EN32KHZ);
 
-    state = ((b & BITMASK_SQUARE_WAVE) >> 2);
-    frequency = ((b & BITMASK_FREQUENCY) >> 3);
+    return CRTC::I2CWriteByte(ADDRESS_STATUS, b | BITMASK_STATUS_FLAGS);
 }
 
 
@@ -225,7 +335,8 @@ uint8_t CDS3232::GetSRAMSize(void)
 }
 
 
-uint8_t CDS3231::GetI2CAddress(void)
+CRTC::status_t CDS3232::GetRTCAndSRAM(CRTC::RTC &rtc, const uint8_t offset, uint8_t data[], const uint8_t bytes)
 {
-    return ADDRESS_I2C;
+    return GetRTCAndRegisters<ADDRESS_SRAM + SNAPSHOT_SRAM - 1>(rtc, ADDRESS_SRAM + offset, data,
+        CRTC::FitSRAMRange(offset, bytes));
 }
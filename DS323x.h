@@ -28,9 +28,17 @@
 #ifndef _DS323X_H_
 #define _DS323X_H_
 
-#include "nRTC.h"
+#include "RegisterMap.h"
 
-class CDS3231 : public CRTC
+struct DS323xMap : public RegisterMap
+{
+    static constexpr uint8_t I2C = 0x68;
+
+    typedef RegisterSpan<0x00, 0x12> Scope; // Time through temperature
+    typedef RegisterSet<0x0E, 0x0F> Volatile; // CONV self-clears; flags clear only
+};
+
+class CDS3231 : public CMappedRTC<DS323xMap>
 {
     public:
     enum class Frequency : uint8_t
@@ -42,11 +50,6 @@ class CDS3231 : public CRTC
     };
     
     protected:
-    enum I2C : uint8_t
-    {
-        ADDRESS_I2C             = 0x68,
-    };
-        
     enum address_t : uint8_t
     {
         ADDRESS_TIME            = 0x00,
@@ -55,38 +58,50 @@ class CDS3231 : public CRTC
         ADDRESS_ALARM           = 0x07,
         ADDRESS_CTRL            = 0x0E,
         ADDRESS_STATUS          = 0x0F,
+        ADDRESS_AGING           = 0x10,
         ADDRESS_TEMPERATURE     = 0x11,
     };
     
     enum bitmask_t : uint8_t
     {   
         BITMASK_32KHZ_OUTPUT    = 0x48,
-        BITMASK_CLOCK_HALT      = 0x80,
+        BITMASK_EN32KHZ         = 0x08,
+        BITMASK_STATUS_FLAGS    = 0x83, // OSF, A2F, A1F
+        BITMASK_OSF             = 0x80,
         BITMASK_ALARM_TOGGLE    = 0x80,
         BITMASK_ALARM_FLAG      = 0x01,
         BITMASK_SQUARE_WAVE     = 0x04,
         BITMASK_FREQUENCY       = 0x18,
+        BITMASK_CONVERT         = 0x20,
     };
 
     public:
     
     void Initialize(void);
-    void GetRTC(CRTC::RTC &rtc);
-    CRTC::status_t SetRTC(const CRTC::RTC &rtc);
+    CRTC::status_t GetSnapshot(CRTC::RTC &rtc);
     
     CRTC::status_t AlarmReset(void);
     CRTC::status_t SetAlarmRTC(const CRTC::RTC &rtc);
     CRTC::status_t SetAlarmState(const CRTC::State state);
-    void GetAlarmRTC(CRTC::RTC &rtc);
+    CRTC::status_t GetAlarmRTC(CRTC::RTC &rtc);
+    CRTC::status_t GetAlarmState(CRTC::State &state);
     CRTC::State GetAlarmState(void);
+    CRTC::status_t IsAlarmTriggered(bool &triggered);
     bool IsAlarmTriggered(void);
     
+    // Value left unchanged when the read fails
+    CRTC::status_t GetTemperature(float &temperature);
     float GetTemperature(void);
+    CRTC::status_t GetAgingOffset(int8_t &offset);
+    int8_t GetAgingOffset(void);
+    CRTC::status_t SetAgingOffset(const int8_t offset);
     CRTC::status_t SetSquareWave(const bool state, const uint8_t frequency);
-    void GetSquareWave(bool &state, uint8_t &frequency);
+    CRTC::status_t GetSquareWave(bool &state, uint8_t &frequency);
     
-    protected:
-    uint8_t GetI2CAddress(void);
+    // 32kHz output as calibration reference
+    uint32_t GetReferenceFrequency(void);
+    CRTC::status_t StartReference(uint8_t &saved);
+    CRTC::status_t StopReference(const uint8_t saved);
 };
 
 
@@ -107,9 +122,8 @@ class CDS3232 : public CDS3231
     
     CRTC::status_t GetSRAM(const uint8_t offset, uint8_t data[], const uint8_t bytes);
     CRTC::status_t SetSRAM(const uint8_t offset, const uint8_t data[], const uint8_t bytes);
-    
-    protected:
     uint8_t GetSRAMSize(void);
+    CRTC::status_t GetRTCAndSRAM(CRTC::RTC &rtc, const uint8_t offset, uint8_t data[], const uint8_t bytes);
 };
 
 #endif
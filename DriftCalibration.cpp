@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        DriftCalibration.cpp
+ * @summary     Drift estimation and DS3231 aging offset calibration
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#include "DriftCalibration.h"
+
+CDriftCalibration::CDriftCalibration(CDS3231 &rtc, reference_t reference)
+    : m_rtc(rtc)
+    , m_reference{reference}
+    , m_origin{0}
+    , m_origin_offset{0}
+    , m_min_span{21600} // 6 hours resolves ~0.1ppm with ms sampling
+    , m_head{0}
+    , m_count{0}
+{
+    // empty
+}
+
+
+void CDriftCalibration::SetMinimumSpan(const uint32_t seconds)
+{
+    m_min_span = seconds;
+}
+
+
+CRTC::status_t CDriftCalibration::AddSample(void)
+{
+    uint64_t start = m_reference();
+    uint32_t epoch;
+    CRTC::status_t status = m_rtc.GetEpoch(epoch);
+
+    if (status != CRTC::STATUS_OK)
+    {
+        return status;
+    }
+
+    // Wait for the seconds rollover so the RTC phase is known to the ms
+    while ((m_reference() - start) <= 1100)
+    {
+        uint32_t current;
+
+        if ((m_rtc.GetEpoch(current) == CRTC::STATUS_OK) && (current != epoch))
+        {
+            uint64_t reference = m_reference();
+            int64_t offset = (int64_t)(1000ULL * current) - (int64_t)reference;
+            float temperature;
+
+            if (m_rtc.GetTemperature(temperature) != CRTC::STATUS_OK)
+            {
+                return m_rtc.GetStatus();
+            }
+
+            if (m_count == 0)
+            {
+                m_origin = reference;
+                m_origin_offset = offset;
+            }
+
+            Sample &sample = m_sample[m_head];
+            sample.time = (uint32_t)(reference - m_origin);
+            sample.offset = (int32_t)(offset - m_origin_offset);
+            sample.temperature = (int8_t)(temperature + ((temperature < 0) ? -0.5f : 0.5f));
+
+            m_head = (m_head + 1) % WINDOW_SIZE;
+            m_count += (m_count < WINDOW_SIZE);
+
+            // Overwriting the oldest sample moves the origin to the next one
+            Rebase();
+
+            return CRTC::STATUS_OK;
+        }
+    }
+
+    return CRTC::STATUS_ERROR;
+}
+
+
+CRTC::status_t CDriftCalibration::GetDrift(float &ppm)
+{
+    if ((m_count < 3) || (GetSpan() < m_min_span))
+    {
+        return CRTC::STATUS_ERROR;
+    }
+
+    int64_t sum_time = 0;
+    int64_t sum_offset = 0;
+    int8_t low = INT8_MAX;
+    int8_t high = INT8_MIN;
+
+    for (uint8_t i = 0; i < m_count; i++)
+    {
+        sum_time += m_sample[i].time;
+        sum_offset += m_sample[i].offset;
+        low = (m_sample[i].temperature < low) ? m_sample[i].temperature : low;
+        high = (m_sample[i].temperature > high) ? m_sample[i].temperature : high;
+    }
+
+    // Drift is temperature dependent; only trust isothermal windows
+    if ((high - low) > TEMPERATURE_SPREAD)
+    {
+        return CRTC::STATUS_ERROR;
+    }
+
+    float covariance = 0;
+    float variance = 0;
+
+    // Deviations from the mean, scaled by m_count to stay integer until here
+    for (uint8_t i = 0; i < m_count; i++)
+    {
+        float dt = (float)(((int64_t)m_count * m_sample[i].time) - sum_time);
+        covariance += dt * (float)(((int64_t)m_count * m_sample[i].offset) - sum_offset);
+        variance += dt * dt;
+    }
+
+    if (variance <= 0)
+    {
+        return CRTC::STATUS_ERROR;
+    }
+
+    // Slope in ms per ms equals 1e6 ppm
+    ppm = 1.0e6f * (covariance / variance);
+    return CRTC::STATUS_OK;
+}
+
+
+uint32_t CDriftCalibration::GetResyncInterval(const uint16_t tolerance_ms)
+{
+    float ppm;
+
+    if ((GetDrift(ppm) != CRTC::STATUS_OK) || (ppm == 0))
+    {
+        return 0;
+    }
+
+    float interval = (1000.0f * tolerance_ms) / ((ppm < 0) ? -ppm : ppm);
+    return (interval > 4.0e9f) ? UINT32_MAX : (uint32_t)interval;
+}
+
+
+CRTC::status_t CDriftCalibration::Calibrate(void)
+{
+    float ppm;
+
+    if (GetDrift(ppm) != CRTC::STATUS_OK)
+    {
+        return CRTC::STATUS_ERROR;
+    }
+
+    // One aging LSB is ~0.1ppm; positive values slow the oscillator
+    int16_t correction = (int16_t)((10.0f * ppm) + ((ppm < 0) ? -0.5f : 0.5f));
+
+    if (correction == 0)
+    {
+        return CRTC::STATUS_OK;
+    }
+
+    int8_t aging;
+
+    // A failed read must not be taken as offset 0 and overwrite the trim
+    if (m_rtc.GetAgingOffset(aging) != CRTC::STATUS_OK)
+    {
+        return m_rtc.GetStatus();
+    }
+
+    int16_t offset = aging + correction;
+    offset = (offset > INT8_MAX) ? INT8_MAX : (offset < INT8_MIN) ? INT8_MIN : offset;
+
+    if (m_rtc.SetAgingOffset((int8_t)offset) == CRTC::STATUS_OK)
+    {
+        // Samples taken before the correction no longer apply
+        Reset();
+        return CRTC::STATUS_OK;
+    }
+
+    return CRTC::STATUS_ERROR;
+}
+
+
+void CDriftCalibration::Reset(void)
+{
+    m_head = 0;
+    m_count = 0;
+}
+
+
+/// Protected Functions ---------------------------------------
+
+uint32_t CDriftCalibration::GetSpan(void)
+{
+    uint8_t newest = (m_head + WINDOW_SIZE - 1) % WINDOW_SIZE;
+    uint8_t oldest = (m_count < WINDOW_SIZE) ? 0 : m_head;
+
+    return ((m_sample[newest].time - m_sample[oldest].time) / 1000);
+}
+
+
+void CDriftCalibration::Rebase(void)
+{
+    if (m_count < WINDOW_SIZE)
+    {
+        return; // The oldest sample is still the origin
+    }
+
+    uint32_t time = m_sample[m_head].time;
+    int32_t offset = m_sample[m_head].offset;
+
+    for (uint8_t i = 0; i < WINDOW_SIZE; i++)
+    {
+        m_sample[i].time -= time;
+        m_sample[i].offset -= offset;
+    }
+
+    m_origin += time;
+    m_origin_offset += offset;
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        DriftCalibration.h
+ * @summary     Drift estimation and DS3231 aging offset calibration
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#ifndef _DRIFT_CALIBRATION_H_
+#define _DRIFT_CALIBRATION_H_
+
+#include "DS323x.h"
+
+class CDriftCalibration
+{
+    public:
+    // Reference time in milliseconds since 2000-01-01 00:00:00
+    typedef uint64_t (*reference_t)(void);
+
+    protected:
+    enum config_t : uint8_t
+    {
+        WINDOW_SIZE         = 16,   // Samples used for the estimate
+        TEMPERATURE_SPREAD  = 3,    // Max spread (C) for a valid estimate
+    };
+
+    // Relative to the oldest retained sample, so a window may span up to
+    // 49 days however long sampling runs
+    struct Sample
+    {
+        uint32_t time;      // Reference ms
+        int32_t offset;     // RTC minus reference (ms)
+        int8_t temperature; // C
+    };
+
+    CDS3231 &m_rtc;
+    reference_t m_reference;
+    uint64_t m_origin;
+    int64_t m_origin_offset;
+    uint32_t m_min_span;
+    Sample m_sample[WINDOW_SIZE];
+    uint8_t m_head;
+    uint8_t m_count;
+
+    public:
+    CDriftCalibration(CDS3231 &rtc, reference_t reference);
+
+    // Minimum window span (seconds) before an estimate is trusted
+    void SetMinimumSpan(const uint32_t seconds);
+
+    // Record one sample aligned to the next RTC seconds rollover
+    CRTC::status_t AddSample(void);
+
+    // Least squares drift over the window (positive = RTC fast)
+    CRTC::status_t GetDrift(float &ppm);
+
+    // Seconds until the estimated drift accumulates the given error
+    uint32_t GetResyncInterval(const uint16_t tolerance_ms);
+
+    // Write an aging offset correction when the estimate is trusted
+    CRTC::status_t Calibrate(void);
+
+    void Reset(void);
+
+    protected:
+    uint32_t GetSpan(void);
+    void Rebase(void);
+};
+
+#endif
@@ -0,0 +1,455 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        EventLog.cpp
+ * @summary     Append-only event ring log in RTC battery backed SRAM
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#include "EventLog.h"
+#include "nCRC.h"
+
+CEventLog::CEventLog(CRTC &rtc, const uint8_t offset, const uint8_t bytes)
+    : m_rtc(rtc)
+    , m_offset{offset}
+    , m_capacity{0}
+    , m_head{0}
+    , m_used{0}
+    , m_sequence{0}
+    , m_slot{0}
+    , m_base{0}
+    , m_last{0}
+{
+    uint8_t size = rtc.GetSRAMSize();
+
+    if (offset >= size)
+    {
+        return; // No usable capacity
+    }
+
+    uint8_t length = ((size - offset) < bytes) ? (size - offset) : bytes;
+
+    // Ring must hold at least one entry and its terminator
+    if (length > ((2 * HEADER_SIZE) + MAX_ENTRY_SIZE))
+    {
+        m_capacity = (length - (2 * HEADER_SIZE));
+    }
+}
+
+
+CRTC::status_t CEventLog::Format(const uint32_t epoch)
+{
+    uint8_t end = TYPE_END;
+    uint8_t data[2 * HEADER_SIZE] = {0};
+
+    if (m_capacity == 0)
+    {
+        return CRTC::STATUS_ERROR;
+    }
+
+    data[1] = 0; // head
+    data[2] = (epoch >> 24);
+    data[3] = (epoch >> 16);
+    data[4] = (epoch >> 8);
+    data[5] = epoch;
+    SetHeaderCRC(data);
+
+    // Terminator first so the new header never points at stale entries
+    CRTC::status_t status = WriteRing(0, &end, 1);
+
+    if (status == CRTC::STATUS_OK)
+    {
+        status = m_rtc.SetSRAM(m_offset, data, sizeof(data));
+    }
+
+    if (status == CRTC::STATUS_OK)
+    {
+        m_head = 0;
+        m_used = 0;
+        m_sequence = 0;
+        m_slot = 0;
+        m_base = epoch;
+        m_last = epoch;
+    }
+
+    return status;
+}
+
+
+CRTC::status_t CEventLog::Recover(uint8_t buffer[])
+{
+    CRTC::status_t status = Load(buffer);
+
+    if (status != CRTC::STATUS_OK)
+    {
+        return status;
+    }
+
+    uint8_t head[2];
+    uint32_t base[2];
+    bool valid_a = ReadHeader(&buffer[0], head[0], base[0]);
+    bool valid_b = ReadHeader(&buffer[HEADER_SIZE], head[1], base[1]);
+
+    if (!valid_a && !valid_b)
+    {
+        return CRTC::STATUS_INVALID;
+    }
+
+    // Newest header by wrapping sequence number
+    uint8_t slot = valid_a ? 0 : 1;
+
+    if (valid_a && valid_b && ((int8_t)(buffer[HEADER_SIZE] - buffer[0]) > 0))
+    {
+        slot = 1;
+    }
+
+    m_slot = slot;
+    m_sequence = buffer[slot * HEADER_SIZE];
+    m_head = head[slot];
+    m_base = base[slot];
+
+    // Walk entries up to the terminator or the first torn entry
+    Cursor cursor;
+    Event event;
+
+    Begin(cursor);
+    cursor.remaining = (m_capacity - 1);
+    m_used = 0;
+    m_last = m_base;
+
+    while (Next(buffer, cursor, event))
+    {
+        m_used = (m_capacity - 1) - cursor.remaining;
+        m_last = event.epoch;
+    }
+
+    return CRTC::STATUS_OK;
+}
+
+
+CRTC::status_t CEventLog::Append(const uint8_t type, const uint32_t epoch)
+{
+    uint8_t data[MAX_ENTRY_SIZE + 1];
+
+    if ((m_capacity == 0) || (type == TYPE_END))
+    {
+        return CRTC::STATUS_INVALID;
+    }
+
+    // Clock set backwards keeps the order with a zero delta
+    uint32_t delta = (epoch > m_last) ? (epoch - m_last) : 0;
+    uint8_t length = Encode(data, type, delta);
+
+    data[length] = TYPE_END;
+
+    if ((m_used + length + 1) > m_capacity)
+    {
+        CRTC::status_t status = Evict((m_used + length + 1) - m_capacity);
+
+        if (status != CRTC::STATUS_OK)
+        {
+            return status;
+        }
+    }
+
+    CRTC::status_t status = WriteRing((m_head + m_used) % m_capacity, data, length + 1);
+
+    if (status == CRTC::STATUS_OK)
+    {
+        m_used += length;
+        m_last += delta;
+    }
+
+    return status;
+}
+
+
+CRTC::status_t CEventLog::Append(const uint8_t type)
+{
+    uint32_t epoch;
+    CRTC::status_t status = m_rtc.GetEpoch(epoch);
+
+    if (status != CRTC::STATUS_OK)
+    {
+        return status;
+    }
+
+    return Append(type, epoch);
+}
+
+
+CRTC::status_t CEventLog::Load(uint8_t buffer[])
+{
+    if (m_capacity == 0)
+    {
+        return CRTC::STATUS_ERROR;
+    }
+
+    return m_rtc.GetSRAM(m_offset, buffer, GetSize());
+}
+
+
+void CEventLog::Begin(Cursor &cursor)
+{
+    cursor.position = m_head;
+    cursor.remaining = m_used;
+    cursor.epoch = m_base;
+}
+
+
+bool CEventLog::Next(const uint8_t buffer[], Cursor &cursor, Event &event)
+{
+    uint8_t data[MAX_ENTRY_SIZE];
+    uint8_t length;
+    uint32_t delta;
+
+    if (cursor.remaining == 0)
+    {
+        return false;
+    }
+
+    CopyRing(buffer, cursor.position, data, MAX_ENTRY_SIZE);
+
+    if (!Decode(data, length, delta) || (length > cursor.remaining))
+    {
+        cursor.remaining = 0;
+        return false;
+    }
+
+    cursor.position = (cursor.position + length) % m_capacity;
+    cursor.remaining -= length;
+    cursor.epoch += delta;
+
+    event.type = data[0];
+    event.epoch = cursor.epoch;
+    return true;
+}
+
+
+uint8_t CEventLog::GetSize(void)
+{
+    return (m_capacity > 0) ? ((2 * HEADER_SIZE) + m_capacity) : 0;
+}
+
+
+uint8_t CEventLog::GetUsed(void)
+{
+    return m_used;
+}
+
+
+/// Protected Functions ---------------------------------------
+
+CRTC::status_t CEventLog::WriteHeader(void)
+{
+    uint8_t data[HEADER_SIZE];
+    uint8_t slot = (1 - m_slot);
+
+    data[0] = (m_sequence + 1);
+    data[1] = m_head;
+    data[2] = (m_base >> 24);
+    data[3] = (m_base >> 16);
+    data[4] = (m_base >> 8);
+    data[5] = m_base;
+    SetHeaderCRC(data);
+
+    // Overwrite the older copy so a torn write falls back to the other
+    CRTC::status_t status = m_rtc.SetSRAM(m_offset + (slot * HEADER_SIZE), data, HEADER_SIZE);
+
+    if (status == CRTC::STATUS_OK)
+    {
+        m_slot = slot;
+        m_sequence = data[0];
+    }
+
+    return status;
+}
+
+
+CRTC::status_t CEventLog::Evict(const uint8_t bytes)
+{
+    uint8_t head = m_head;
+    uint8_t used = m_used;
+    uint32_t base = m_base;
+    uint8_t freed = 0;
+
+    // Drop oldest entries, folding their deltas into the base epoch
+    while ((freed < bytes) && (m_used > 0))
+    {
+        uint8_t data[MAX_ENTRY_SIZE];
+        uint8_t length;
+        uint32_t delta;
+        CRTC::status_t status = ReadRing(m_head, data, MAX_ENTRY_SIZE);
+
+        if (status != CRTC::STATUS_OK)
+        {
+            m_head = head;
+            m_used = used;
+            m_base = base;
+            return status;
+        }
+
+        if (!Decode(data, length, delta) || (length > m_used))
+        {
+            m_base = m_last; // Unreadable, discard the remainder
+            m_head = ((m_head + m_used) % m_capacity);
+            m_used = 0;
+            break;
+        }
+
+        m_head = ((m_head + length) % m_capacity);
+        m_used -= length;
+        m_base += delta;
+        freed += length;
+    }
+
+    CRTC::status_t status = WriteHeader();
+
+    if (status != CRTC::STATUS_OK)
+    {
+        m_head = head;
+        m_used = used;
+        m_base = base;
+    }
+
+    return status;
+}
+
+
+CRTC::status_t CEventLog::ReadRing(const uint8_t position, uint8_t data[], const uint8_t bytes)
+{
+    uint8_t first = ((m_capacity - position) < bytes) ? (m_capacity - position) : bytes;
+    uint8_t address = (m_offset + (2 * HEADER_SIZE));
+    CRTC::status_t status = m_rtc.GetSRAM(address + position, data, first);
+
+    if ((status == CRTC::STATUS_OK) && (first < bytes))
+    {
+        status = m_rtc.GetSRAM(address, &data[first], bytes - first);
+    }
+
+    return status;
+}
+
+
+CRTC::status_t CEventLog::WriteRing(const uint8_t position, const uint8_t data[], const uint8_t bytes)
+{
+    uint8_t first = ((m_capacity - position) < bytes) ? (m_capacity - position) : bytes;
+    uint8_t address = (m_offset + (2 * HEADER_SIZE));
+
+    // Wrapped part first; the old terminator is only replaced last
+    if (first < bytes)
+    {
+        CRTC::status_t status = m_rtc.SetSRAM(address, &data[first], bytes - first);
+
+        if (status != CRTC::STATUS_OK)
+        {
+            return status;
+        }
+    }
+
+    return m_rtc.SetSRAM(address + position, data, first);
+}
+
+
+void CEventLog::CopyRing(const uint8_t buffer[], const uint8_t position, uint8_t data[], const uint8_t bytes)
+{
+    uint8_t index = position;
+
+    for (uint8_t i = 0; i < bytes; i++)
+    {
+        data[i] = buffer[(2 * HEADER_SIZE) + index];
+        index = ((index + 1) < m_capacity) ? (index + 1) : 0;
+    }
+}
+
+
+bool CEventLog::Decode(const uint8_t data[], uint8_t &length, uint32_t &delta)
+{
+    uint8_t i = 1;
+
+    if (data[0] == TYPE_END)
+    {
+        return false;
+    }
+
+    delta = 0;
+
+    // Little endian base 128, at most 5 bytes
+    do
+    {
+        if (i > 5)
+        {
+            return false;
+        }
+
+        delta |= ((uint32_t)(data[i] & 0x7F) << (7 * (i - 1)));
+    } while (data[i++] & 0x80);
+
+    length = (i + 1);
+    return (CCRC::CRC8(data, i) == data[i]);
+}
+
+
+uint8_t CEventLog::Encode(uint8_t data[], const uint8_t type, uint32_t delta)
+{
+    uint8_t i = 1;
+
+    data[0] = type;
+
+    do
+    {
+        data[i] = (delta & 0x7F);
+        delta >>= 7;
+
+        if (delta)
+        {
+            data[i] |= 0x80;
+        }
+    } while (data[i++] & 0x80);
+
+    data[i] = CCRC::CRC8(data, i);
+    return (i + 1);
+}
+
+
+bool CEventLog::ReadHeader(const uint8_t data[], uint8_t &head, uint32_t &base)
+{
+    uint16_t crc = CCRC::CRC16(data, HEADER_SIZE - 2);
+
+    if ((data[6] != (crc >> 8)) || (data[7] != (uint8_t)crc) || (data[1] >= m_capacity))
+    {
+        return false;
+    }
+
+    head = data[1];
+    base = ((uint32_t)data[2] << 24) | ((uint32_t)data[3] << 16) | ((uint32_t)data[4] << 8) | data[5];
+    return true;
+}
+
+
+void CEventLog::SetHeaderCRC(uint8_t data[])
+{
+    uint16_t crc = CCRC::CRC16(data, HEADER_SIZE - 2);
+
+    data[6] = (crc >> 8);
+    data[7] = crc;
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        EventLog.h
+ * @summary     Append-only event ring log in RTC battery backed SRAM
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#ifndef _EVENT_LOG_H_
+#define _EVENT_LOG_H_
+
+#include "nRTC.h"
+
+// Layout: two [sequence][head][base epoch x4][crc16] headers followed by a
+// byte ring of [type][varint delta][crc8] entries. The entry after the last
+// is always a 0x00 terminator, written in the same burst as the entry, so
+// appends never touch the header. Headers only change when old entries are
+// evicted, and alternate between copies to survive a torn write.
+class CEventLog
+{
+    public:
+    struct Event
+    {
+        uint8_t type;   // 0x01-0xFF
+        uint32_t epoch;
+    };
+
+    struct Cursor
+    {
+        uint8_t position;
+        uint8_t remaining;
+        uint32_t epoch;
+    };
+
+    enum config_t : uint8_t
+    {
+        HEADER_SIZE     = 8,
+        MAX_ENTRY_SIZE  = 7,    // type, 5 byte varint, crc
+        TYPE_END        = 0x00,
+    };
+
+    protected:
+    CRTC &m_rtc;
+    uint8_t m_offset;
+    uint8_t m_capacity;
+    uint8_t m_head;
+    uint8_t m_used;
+    uint8_t m_sequence;
+    uint8_t m_slot;
+    uint32_t m_base;    // Epoch preceding the oldest entry
+    uint32_t m_last;    // Epoch of the newest entry
+
+    public:
+    // Log occupying SRAM [offset, offset + bytes)
+    CEventLog(CRTC &rtc, const uint8_t offset, const uint8_t bytes);
+
+    // Start an empty log with the given base epoch
+    CRTC::status_t Format(const uint32_t epoch);
+
+    // Rebuild head and tail after reset; buffer must hold GetSize() bytes
+    CRTC::status_t Recover(uint8_t buffer[]);
+
+    // Single burst unless the entry wraps or old entries must be evicted
+    CRTC::status_t Append(const uint8_t type, const uint32_t epoch);
+    CRTC::status_t Append(const uint8_t type);
+
+    // Read the whole log in one transaction, then walk it with Next()
+    CRTC::status_t Load(uint8_t buffer[]);
+    void Begin(Cursor &cursor);
+    bool Next(const uint8_t buffer[], Cursor &cursor, Event &event);
+
+    uint8_t GetSize(void);
+    uint8_t GetUsed(void);
+
+    protected:
+    CRTC::status_t WriteHeader(void);
+    CRTC::status_t Evict(const uint8_t bytes);
+    CRTC::status_t ReadRing(const uint8_t position, uint8_t data[], const uint8_t bytes);
+    CRTC::status_t WriteRing(const uint8_t position, const uint8_t data[], const uint8_t bytes);
+    void CopyRing(const uint8_t buffer[], const uint8_t position, uint8_t data[], const uint8_t bytes);
+    bool Decode(const uint8_t data[], uint8_t &length, uint32_t &delta);
+    uint8_t Encode(uint8_t data[], const uint8_t type, uint32_t delta);
+    bool ReadHeader(const uint8_t data[], uint8_t &head, uint32_t &base);
+    void SetHeaderCRC(uint8_t data[]);
+};
+
+#endif
@@ -0,0 +1,435 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        MCP7940N.cpp
+ * @summary     Real Time Clock interface for MCP7940N
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#include "MCP7940N.h"
+#include "RTCPlatform.h"
+
+CMCP7940N::CMCP7940N(void)
+    : m_daily{false}
+{
+    // empty
+}
+
+
+void CMCP7940N::Initialize(void)
+{
+    uint8_t data[ADDRESS_WEEK_DAY + 1];
+
+    CRTC::Initialize(); // Setup i2c
+
+    if (CRTC::I2CRead(ADDRESS_TIME, data, sizeof(data)) != CRTC::STATUS_OK)
+    {
+        return;
+    }
+
+    // Enable battery backup and start the oscillator, keeping the stored time
+    if (!(data[ADDRESS_WEEK_DAY] & BITMASK_VBATEN))
+    {
+        CRTC::I2CWriteByte(ADDRESS_WEEK_DAY, data[ADDRESS_WEEK_DAY] | BITMASK_VBATEN);
+    }
+
+    if (!(data[ADDRESS_TIME] & BITMASK_ST))
+    {
+        CRTC::I2CWriteByte(ADDRESS_TIME, data[ADDRESS_TIME] | BITMASK_ST);
+    }
+
+    WaitOscillator(true, data[ADDRESS_WEEK_DAY]);
+}
+
+
+CRTC::status_t CMCP7940N::SetRTC(const CRTC::RTC &rtc)
+{
+    uint8_t data[TIME_BYTES];
+    uint8_t week_day;
+
+    Encode(rtc, data);
+
+    // Stop the oscillator so no counter rolls over during the write
+    if ((CRTC::I2CWriteByte(ADDRESS_TIME, 0x00) == CRTC::STATUS_OK)
+        && (WaitOscillator(false, week_day) == CRTC::STATUS_OK))
+    {
+        // Writing PWRFAIL as 0 would erase the power-fail timestamps
+        data[MCP7940NMap::WEEK_DAY] |= (week_day & BITMASK_PWRFAIL);
+
+        if (CRTC::I2CWrite(ADDRESS_TIME, data, TIME_BYTES) == CRTC::STATUS_OK)
+        {
+            return WaitOscillator(true, week_day);
+        }
+    }
+
+    return m_status;
+}
+
+
+CRTC::status_t CMCP7940N::AlarmReset(void)
+{
+    CRTC::RTC rtc;
+
+    // Re-arming for the next day also clears the flag
+    if (m_daily && (GetAlarmRTC(rtc) == CRTC::STATUS_OK))
+    {
+        return ArmDaily(rtc);
+    }
+
+    return AlarmReset(Alarm::ALARM_0);
+}
+
+
+CRTC::status_t CMCP7940N::SetAlarmRTC(const CRTC::RTC &rtc)
+{
+    CRTC::status_t status = ArmDaily(rtc);
+
+    if (status != CRTC::STATUS_OK)
+    {
+        return status;
+    }
+
+    m_daily = true;
+    return SetAlarmState(Alarm::ALARM_0, CRTC::State::ENABLE);
+}
+
+
+CRTC::status_t CMCP7940N::SetAlarmState(const CRTC::State state)
+{
+    return SetAlarmState(Alarm::ALARM_0, state);
+}
+
+
+CRTC::status_t CMCP7940N::GetAlarmRTC(CRTC::RTC &rtc)
+{
+    uint8_t data[3];
+    CRTC::status_t status = CRTC::I2CRead(ADDRESS_ALARM_0, data, 3);
+
+    if (status == CRTC::STATUS_OK)
+    {
+        rtc.second  = CRTC::BCD_to_DEC(data[0] & 0x7F);
+        rtc.minute  = CRTC::BCD_to_DEC(data[1] & 0x7F);
+        rtc.hour    = CRTC::BCD_to_DEC(data[2] & 0x3F);
+    }
+
+    return status;
+}
+
+
+CRTC::status_t CMCP7940N::GetAlarmState(CRTC::State &state)
+{
+    return GetAlarmState(Alarm::ALARM_0, state);
+}
+
+
+CRTC::State CMCP7940N::GetAlarmState(void)
+{
+    return GetAlarmState(Alarm::ALARM_0);
+}
+
+
+CRTC::status_t CMCP7940N::IsAlarmTriggered(bool &triggered)
+{
+    return IsAlarmTriggered(Alarm::ALARM_0, triggered);
+}
+
+
+bool CMCP7940N::IsAlarmTriggered(void)
+{
+    return IsAlarmTriggered(Alarm::ALARM_0);
+}
+
+
+CRTC::status_t CMCP7940N::SetAlarm(const Alarm alarm, const CRTC::RTC &rtc, const Match match)
+{
+    if (alarm == Alarm::ALARM_0)
+    {
+        m_daily = false; // Caller now owns alarm 0
+    }
+
+    return WriteAlarm(alarm, rtc, match);
+}
+
+
+CRTC::status_t CMCP7940N::SetAlarmState(const Alarm alarm, const CRTC::State state)
+{
+    uint8_t b;
+    uint8_t enable = (BITMASK_ALARM_0_ENABLE << (uint8_t)alarm);
+
+    if (CRTC::I2CReadByte(ADDRESS_CONTROL, b) != CRTC::STATUS_OK)
+    {
+        return m_status;
+    }
+
+    if (state == CRTC::State::ENABLE)
+    {
+        b |= enable;
+    }
+    else
+    {
+        b &= ~(enable);
+    }
+
+    if (CRTC::I2CWriteByte(ADDRESS_CONTROL, b) == CRTC::STATUS_OK)
+    {
+        return AlarmReset(alarm);
+    }
+
+    return m_status;
+}
+
+
+CRTC::status_t CMCP7940N::GetAlarmState(const Alarm alarm, CRTC::State &state)
+{
+    uint8_t b;
+
+    if (CRTC::I2CReadByte(ADDRESS_CONTROL, b) == CRTC::STATUS_OK)
+    {
+        state = (b & (BITMASK_ALARM_0_ENABLE << (uint8_t)alarm)) ? CRTC::State::ENABLE : CRTC::State::DISABLE;
+    }
+
+    return m_status;
+}
+
+
+CRTC::State CMCP7940N::GetAlarmState(const Alarm alarm)
+{
+    CRTC::State state = CRTC::State::DISABLE;
+
+    GetAlarmState(alarm, state);
+    return state;
+}
+
+
+CRTC::status_t CMCP7940N::IsAlarmTriggered(const Alarm alarm, bool &triggered)
+{
+    uint8_t b;
+
+    if (CRTC::I2CReadByte(GetAlarmAddress(alarm) + 3, b) == CRTC::STATUS_OK)
+    {
+        triggered = !!(b & BITMASK_ALARM_FLAG);
+    }
+
+    return m_status;
+}
+
+
+bool CMCP7940N::IsAlarmTriggered(const Alarm alarm)
+{
+    bool triggered = false;
+
+    IsAlarmTriggered(alarm, triggered);
+    return triggered;
+}
+
+
+CRTC::status_t CMCP7940N::AlarmReset(const Alarm alarm)
+{
+    uint8_t address = GetAlarmAddress(alarm) + 3;
+    uint8_t b;
+
+    if (CRTC::I2CReadByte(address, b) != CRTC::STATUS_OK)
+    {
+        return m_status;
+    }
+
+    // Clear alarm flag, keeping match mode and week day
+    b &= ~(BITMASK_ALARM_FLAG);
+
+    return CRTC::I2CWriteByte(address, b);
+}
+
+
+CRTC::status_t CMCP7940N::GetPowerFail(CRTC::RTC &down, CRTC::RTC &up)
+{
+    uint8_t data[8];
+
+    // Power-down and power-up stamps are adjacent; read both in one burst
+    if (CRTC::I2CRead(ADDRESS_POWER_DOWN, data, sizeof(data)) == CRTC::STATUS_OK)
+    {
+        DecodeTimestamp(&data[0], down);
+        DecodeTimestamp(&data[ADDRESS_POWER_UP - ADDRESS_POWER_DOWN], up);
+    }
+
+    return m_status;
+}
+
+
+CRTC::status_t CMCP7940N::IsPowerFail(bool &failed)
+{
+    uint8_t b;
+
+    if (CRTC::I2CReadByte(ADDRESS_WEEK_DAY, b) == CRTC::STATUS_OK)
+    {
+        failed = !!(b & BITMASK_PWRFAIL);
+    }
+
+    return m_status;
+}
+
+
+bool CMCP7940N::IsPowerFail(void)
+{
+    bool failed = false;
+
+    IsPowerFail(failed);
+    return failed;
+}
+
+
+CRTC::status_t CMCP7940N::PowerFailReset(void)
+{
+    uint8_t b;
+
+    if (CRTC::I2CReadByte(ADDRESS_WEEK_DAY, b) != CRTC::STATUS_OK)
+    {
+        return m_status;
+    }
+
+    // Clearing PWRFAIL also clears both timestamps
+    b &= ~(BITMASK_PWRFAIL);
+
+    return CRTC::I2CWriteByte(ADDRESS_WEEK_DAY, b);
+}
+
+
+uint32_t CMCP7940N::GetReferenceFrequency(void)
+{
+    return 32768;
+}
+
+
+CRTC::status_t CMCP7940N::StartReference(uint8_t &saved)
+{
+    uint8_t b;
+
+    if (CRTC::I2CReadByte(ADDRESS_CONTROL, b) != CRTC::STATUS_OK)
+    {
+        return m_status;
+    }
+
+    saved = (b & BITMASK_SQUARE_WAVE);
+
+    return CRTC::I2CWriteByte(ADDRESS_CONTROL, b | BITMASK_SQUARE_WAVE);
+}
+
+
+CRTC::status_t CMCP7940N::StopReference(const uint8_t saved)
+{
+    uint8_t b;
+
+    if (CRTC::I2CReadByte(ADDRESS_CONTROL, b) != CRTC::STATUS_OK)
+    {
+        return m_status;
+    }
+
+    b &= ~(BITMASK_SQUARE_WAVE);
+    b |= (saved & BITMASK_SQUARE_WAVE);
+
+    return CRTC::I2CWriteByte(ADDRESS_CONTROL, b);
+}
+
+
+/// Protected Functions ---------------------------------------
+
+CRTC::status_t CMCP7940N::WaitOscillator(const bool running, uint8_t &week_day)
+{
+    uint32_t start = millis();
+
+    // Poll the bus directly; a ReadScope would keep returning the cached OSCRUN
+    while (CRTC::I2CTransfer(false, ADDRESS_WEEK_DAY, &week_day, 1) == CRTC::STATUS_OK)
+    {
+        if (!!(week_day & BITMASK_OSCRUN) == running)
+        {
+            break;
+        }
+
+        if ((millis() - start) >= OSCILLATOR_TIMEOUT)
+        {
+            m_status = CRTC::STATUS_TIMEOUT;
+            break;
+        }
+    }
+
+    return m_status;
+}
+
+
+CRTC::status_t CMCP7940N::WriteAlarm(const Alarm alarm, const CRTC::RTC &rtc, const Match match)
+{
+    // Week day must agree with the date when every field is compared
+    uint8_t week_day = (match == Match::ALL) ? CRTC::DayOfWeek(rtc.year, rtc.month, rtc.day) : rtc.week_day;
+    uint8_t data[ALARM_BYTES] =
+    {
+        CRTC::DEC_to_BCD(rtc.second),
+        CRTC::DEC_to_BCD(rtc.minute),
+        CRTC::DEC_to_BCD(rtc.hour),
+        (uint8_t)((((uint8_t)match << 4) & BITMASK_ALARM_MATCH) | (week_day & BITMASK_WEEK_DAY)), // Clears flag
+        CRTC::DEC_to_BCD(rtc.day),
+        CRTC::DEC_to_BCD(rtc.month),
+    };
+
+    return CRTC::I2CWrite(GetAlarmAddress(alarm), data, ALARM_BYTES);
+}
+
+
+CRTC::status_t CMCP7940N::ArmDaily(const CRTC::RTC &rtc)
+{
+    CRTC::Timestamp now;
+    CRTC::status_t status = GetTimestamp(now);
+
+    if (status != CRTC::STATUS_OK)
+    {
+        return status;
+    }
+
+    // No hour-minute-second match mode exists, so match the full date of
+    // the next occurrence and move it forward after each trigger
+    CRTC::Timestamp next(now.epoch - (now.epoch % 86400) + CRTC::GetSeconds(rtc));
+    CRTC::RTC alarm;
+
+    if (next.epoch <= now.epoch)
+    {
+        next.epoch += 86400;
+    }
+
+    next.ToRTC(alarm);
+    return WriteAlarm(Alarm::ALARM_0, alarm, Match::ALL);
+}
+
+
+void CMCP7940N::DecodeTimestamp(const uint8_t data[], CRTC::RTC &rtc)
+{
+    rtc.second      = 0;
+    rtc.minute      = CRTC::BCD_to_DEC(data[0] & 0x7F);
+    rtc.hour        = CRTC::BCD_to_DEC(data[1] & 0x3F);
+    rtc.day         = CRTC::BCD_to_DEC(data[2] & 0x3F);
+    rtc.month       = CRTC::BCD_to_DEC(data[3] & 0x1F);
+    rtc.week_day    = (data[3] >> 5);
+    rtc.year        = m_time.Year(); // Not recorded by the device
+}
+
+
+uint8_t CMCP7940N::GetAlarmAddress(const Alarm alarm)
+{
+    return (alarm == Alarm::ALARM_0) ? ADDRESS_ALARM_0 : ADDRESS_ALARM_1;
+}
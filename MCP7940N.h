@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        MCP7940N.h
+ * @summary     Real Time Clock interface for MCP7940N
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#ifndef _MCP7940N_H_
+#define _MCP7940N_H_
+
+#include "RegisterMap.h"
+
+struct MCP7940NMap : public RegisterMap
+{
+    static constexpr uint8_t I2C            = 0x6F;
+    static constexpr uint8_t RUN_MASK       = 0x20; // OSCRUN
+    static constexpr uint8_t SECOND_SET     = 0x80; // ST starts the oscillator
+    static constexpr uint8_t WEEK_DAY_SET   = 0x08; // VBATEN keeps battery backup on
+
+    static constexpr uint8_t SRAM           = 0x20;
+    static constexpr uint8_t SRAM_SIZE      = 64;
+
+    typedef RegisterSpan<0x00, 0x10> Scope; // Time, control and alarm 0
+    typedef RegisterSet<0x03, 0x0D> Volatile; // OSCRUN/PWRFAIL and ALM0IF
+};
+
+class CMCP7940N : public CMappedRTC<MCP7940NMap>
+{
+    public:
+    enum class Alarm : uint8_t
+    {
+        ALARM_0,
+        ALARM_1,
+    };
+
+    // Fields compared by an alarm
+    enum class Match : uint8_t
+    {
+        SECOND      = 0,
+        MINUTE      = 1,
+        HOUR        = 2,
+        WEEK_DAY    = 3,
+        DAY         = 4,
+        ALL         = 7, // Second, minute, hour, week day, day and month
+    };
+
+    protected:
+    enum address_t : uint8_t
+    {
+        ADDRESS_TIME            = 0x00,
+        ADDRESS_WEEK_DAY        = 0x03,
+        ADDRESS_CONTROL         = 0x07,
+        ADDRESS_ALARM_0         = 0x0A,
+        ADDRESS_ALARM_1         = 0x11,
+        ADDRESS_POWER_DOWN      = 0x18,
+        ADDRESS_POWER_UP        = 0x1C,
+    };
+
+    enum bitmask_t : uint8_t
+    {
+        BITMASK_ST              = 0x80,
+        BITMASK_OSCRUN          = 0x20,
+        BITMASK_PWRFAIL         = 0x10,
+        BITMASK_VBATEN          = 0x08,
+        BITMASK_ALARM_0_ENABLE  = 0x10,
+        BITMASK_ALARM_MATCH     = 0x70,
+        BITMASK_ALARM_FLAG      = 0x08,
+        BITMASK_WEEK_DAY        = 0x07,
+        BITMASK_SQUARE_WAVE     = 0x43, // SQWEN with SQWFS1:0 at 32.768kHz
+    };
+
+    enum config_t : uint16_t
+    {
+        ALARM_BYTES             = 6,
+        OSCILLATOR_TIMEOUT      = 1000, // ms
+    };
+
+    bool m_daily; // CRTC alarm re-armed for the next day
+
+    public:
+    CMCP7940N(void);
+
+    void Initialize(void);
+    CRTC::status_t SetRTC(const CRTC::RTC &rtc);
+
+    // CRTC alarm interface, served by alarm 0 as a daily alarm
+    CRTC::status_t AlarmReset(void);
+    CRTC::status_t SetAlarmRTC(const CRTC::RTC &rtc);
+    CRTC::status_t SetAlarmState(const CRTC::State state);
+    CRTC::status_t GetAlarmRTC(CRTC::RTC &rtc);
+    CRTC::status_t GetAlarmState(CRTC::State &state);
+    CRTC::State GetAlarmState(void);
+    CRTC::status_t IsAlarmTriggered(bool &triggered);
+    bool IsAlarmTriggered(void);
+
+    // Either alarm with any match mode
+    CRTC::status_t SetAlarm(const Alarm alarm, const CRTC::RTC &rtc, const Match match);
+    CRTC::status_t SetAlarmState(const Alarm alarm, const CRTC::State state);
+    CRTC::status_t GetAlarmState(const Alarm alarm, CRTC::State &state);
+    CRTC::State GetAlarmState(const Alarm alarm);
+    CRTC::status_t IsAlarmTriggered(const Alarm alarm, bool &triggered);
+    bool IsAlarmTriggered(const Alarm alarm);
+    CRTC::status_t AlarmReset(const Alarm alarm);
+
+    // Power-fail timestamps (minute resolution, year taken from the last read)
+    CRTC::status_t GetPowerFail(CRTC::RTC &down, CRTC::RTC &up);
+    CRTC::status_t IsPowerFail(bool &failed);
+    bool IsPowerFail(void);
+    CRTC::status_t PowerFailReset(void);
+
+    // 32.768kHz on MFP as calibration reference; alarms do not reach MFP
+    // while it is enabled
+    uint32_t GetReferenceFrequency(void);
+    CRTC::status_t StartReference(uint8_t &saved);
+    CRTC::status_t StopReference(const uint8_t saved);
+
+    protected:
+    CRTC::status_t WaitOscillator(const bool running, uint8_t &week_day);
+    CRTC::status_t WriteAlarm(const Alarm alarm, const CRTC::RTC &rtc, const Match match);
+    CRTC::status_t ArmDaily(const CRTC::RTC &rtc);
+    void DecodeTimestamp(const uint8_t data[], CRTC::RTC &rtc);
+
+    static uint8_t GetAlarmAddress(const Alarm alarm);
+};
+
+#endif
@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        MonotonicClock.cpp
+ * @summary     Millisecond monotonic clock derived from RTC and MCU ticks
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#include "MonotonicClock.h"
+#include "RTCPlatform.h"
+
+static uint32_t DefaultTick(void)
+{
+    return millis();
+}
+
+
+CMonotonicClock::CMonotonicClock(CRTC &rtc)
+    : CMonotonicClock(rtc, DefaultTick)
+{
+    // empty
+}
+
+
+CMonotonicClock::CMonotonicClock(CRTC &rtc, tick_t tick)
+    : m_rtc(rtc)
+    , m_tick{tick}
+    , m_base{0}
+    , m_last{0}
+    , m_error{0}
+    , m_rate{RATE_NOMINAL}
+    , m_latch_tick{0}
+    , m_latch_epoch{0}
+    , m_poll_tick{0}
+    , m_poll_epoch{0}
+    , m_reference_tick{0}
+    , m_reference_epoch{0}
+    , m_edge_tick{0}
+    , m_edge{false}
+    , m_synchronized{false}
+{
+    // empty
+}
+
+
+CRTC::status_t CMonotonicClock::Synchronize(void)
+{
+    uint32_t start = m_tick();
+    uint32_t previous = start;
+    uint32_t epoch;
+    CRTC::status_t status = m_rtc.GetEpoch(epoch);
+
+    if (status != CRTC::STATUS_OK)
+    {
+        return status;
+    }
+
+    // Poll until the seconds register rolls over (at most one second)
+    while ((m_tick() - start) <= 1100)
+    {
+        uint32_t tick = m_tick();
+        uint32_t current;
+
+        // Failed reads keep the last good poll as the lower bound
+        if (m_rtc.GetEpoch(current) != CRTC::STATUS_OK)
+        {
+            continue;
+        }
+
+        if (current != epoch)
+        {
+            // Rollover happened somewhere between the last two polls
+            Latch(current, previous + ((tick - previous) / 2));
+            m_poll_tick = tick;
+            m_poll_epoch = current;
+            return CRTC::STATUS_OK;
+        }
+
+        previous = tick;
+    }
+
+    return CRTC::STATUS_TIMEOUT;
+}
+
+
+bool CMonotonicClock::Update(void)
+{
+    if (m_edge)
+    {
+        uint32_t edge;
+#if defined(ARDUINO)
+        uint8_t sreg = SREG;
+
+        cli();
+#endif
+        edge = m_edge_tick;
+        m_edge = false;
+#if defined(ARDUINO)
+        SREG = sreg;
+#endif
+
+        if (m_synchronized)
+        {
+            // Count elapsed seconds from ticks instead of reading the bus
+            uint64_t elapsed = ((uint64_t)(edge - m_latch_tick) * m_rate) >> 24;
+            Latch(m_latch_epoch + (uint32_t)((elapsed + 500) / 1000), edge);
+            return true;
+        }
+
+        // First edge must be paired with a read within the same second
+        uint32_t epoch;
+
+        if ((m_rtc.GetEpoch(epoch) == CRTC::STATUS_OK) && ((m_tick() - edge) < 500))
+        {
+            Latch(epoch, edge);
+            return true;
+        }
+
+        return false;
+    }
+
+    uint32_t epoch;
+    bool latched = false;
+
+    if (m_rtc.GetEpoch(epoch) != CRTC::STATUS_OK)
+    {
+        return false;
+    }
+
+    uint32_t tick = m_tick();
+
+    // Only latch when the previous poll was close enough to bound the edge
+    if ((epoch == (m_poll_epoch + 1)) && ((tick - m_poll_tick) <= POLL_WINDOW))
+    {
+        Latch(epoch, m_poll_tick + ((tick - m_poll_tick) / 2));
+        latched = true;
+    }
+
+    m_poll_tick = tick;
+    m_poll_epoch = epoch;
+
+    return latched;
+}
+
+
+void CMonotonicClock::OnSecondEdge(void)
+{
+    m_edge_tick = m_tick();
+    m_edge = true;
+}
+
+
+uint64_t CMonotonicClock::Now(void)
+{
+    uint64_t value = Project(m_tick());
+
+    if (value < m_last)
+    {
+        value = m_last;
+    }
+
+    m_last = value;
+    return value;
+}
+
+
+int32_t CMonotonicClock::GetDrift(void)
+{
+    return (int32_t)((((int64_t)m_rate - RATE_NOMINAL) * 1000000) / RATE_NOMINAL);
+}
+
+
+bool CMonotonicClock::IsSynchronized(void)
+{
+    return m_synchronized;
+}
+
+
+/// Protected Functions ---------------------------------------
+
+uint64_t CMonotonicClock::Project(const uint32_t tick)
+{
+    uint32_t elapsed = (tick - m_latch_tick);
+    int32_t limit = (int32_t)(elapsed >> SLEW_SHIFT);
+    int32_t slew = m_error;
+
+    // Apply outstanding correction gradually
+    if (slew > limit)
+    {
+        slew = limit;
+    }
+    else if (slew < -limit)
+    {
+        slew = -limit;
+    }
+
+    return m_base + (((uint64_t)elapsed * m_rate) >> 24) + slew;
+}
+
+
+void CMonotonicClock::Latch(const uint32_t epoch, const uint32_t tick)
+{
+    uint64_t target = (1000ULL * epoch);
+
+    if (m_synchronized)
+    {
+        // Continue from the projected value and slew towards the RTC
+        uint64_t projected = Project(tick);
+        int64_t error = (int64_t)(target - projected);
+
+        m_base = projected;
+        m_error = (error > INT32_MAX) ? INT32_MAX : (error < INT32_MIN) ? INT32_MIN : (int32_t)error;
+        Calibrate(epoch, tick);
+    }
+    else
+    {
+        m_base = target;
+        m_error = 0;
+        m_reference_tick = tick;
+        m_reference_epoch = epoch;
+        m_synchronized = true;
+    }
+
+    m_latch_tick = tick;
+    m_latch_epoch = epoch;
+}
+
+
+void CMonotonicClock::Calibrate(const uint32_t epoch, const uint32_t tick)
+{
+    uint32_t span = (epoch - m_reference_epoch);
+
+    if (span < CALIBRATION_PERIOD)
+    {
+        return;
+    }
+
+    // Measured RTC milliseconds per MCU tick over the reference span
+    uint64_t rate = ((1000ULL * span) << 24) / (tick - m_reference_tick);
+    int32_t deviation = (int32_t)((int64_t)rate - RATE_NOMINAL);
+
+    if ((deviation <= (int32_t)RATE_LIMIT) && (deviation >= -(int32_t)RATE_LIMIT))
+    {
+        // Low-pass filter the crystal error estimate
+        m_rate += ((int32_t)rate - (int32_t)m_rate) / 4;
+    }
+
+    m_reference_tick = tick;
+    m_reference_epoch = epoch;
+}
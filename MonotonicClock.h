@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        MonotonicClock.h
+ * @summary     Millisecond monotonic clock derived from RTC and MCU ticks
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#ifndef _MONOTONIC_CLOCK_H_
+#define _MONOTONIC_CLOCK_H_
+
+#include "nRTC.h"
+
+class CMonotonicClock
+{
+    public:
+    // Millisecond tick source, e.g. millis()
+    typedef uint32_t (*tick_t)(void);
+
+    protected:
+    enum config_t : uint32_t
+    {
+        RATE_NOMINAL        = (1UL << 24),  // Q24 ms per tick
+        RATE_LIMIT          = (1UL << 24) / 100, // Reject rates beyond 1%
+        POLL_WINDOW         = 20,           // Max poll gap for a rollover latch (ms)
+        SLEW_SHIFT          = 4,            // Slew at most 1 ms per 16 ms
+        CALIBRATION_PERIOD  = 256,          // Min seconds between rate updates
+    };
+
+    CRTC &m_rtc;
+    tick_t m_tick;
+
+    uint64_t m_base;            // Clock value (ms) at m_latch_tick
+    uint64_t m_last;            // Last value returned by Now()
+    int32_t m_error;            // Correction (ms) still to be slewed in
+    uint32_t m_rate;            // Q24 ms per tick
+    uint32_t m_latch_tick;
+    uint32_t m_latch_epoch;
+    uint32_t m_poll_tick;
+    uint32_t m_poll_epoch;
+    uint32_t m_reference_tick;
+    uint32_t m_reference_epoch;
+    volatile uint32_t m_edge_tick;
+    volatile bool m_edge;
+    bool m_synchronized;
+
+    public:
+    CMonotonicClock(CRTC &rtc);
+    CMonotonicClock(CRTC &rtc, tick_t tick);
+
+    // Block until the next seconds rollover and latch it
+    CRTC::status_t Synchronize(void);
+
+    // Opportunistic update; returns true when a rollover was latched
+    bool Update(void);
+
+    // Call from the 1Hz square wave edge interrupt (no bus access)
+    void OnSecondEdge(void);
+
+    // Milliseconds since 2000-01-01 00:00:00, never decreasing
+    uint64_t Now(void);
+
+    // MCU tick error relative to the RTC in ppm (positive = MCU slow)
+    int32_t GetDrift(void);
+
+    bool IsSynchronized(void);
+
+    protected:
+    uint64_t Project(const uint32_t tick);
+    void Latch(const uint32_t epoch, const uint32_t tick);
+    void Calibrate(const uint32_t epoch, const uint32_t tick);
+};
+
+#endif
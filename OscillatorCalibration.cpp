@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        OscillatorCalibration.cpp
+ * @summary     MCU oscillator calibration against the RTC reference output
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#include "OscillatorCalibration.h"
+
+COscillatorCalibration::COscillatorCalibration(CRTC &rtc, capture_t capture, trim_t trim, const uint32_t frequency)
+    : m_rtc(rtc)
+    , m_capture{capture}
+    , m_trim{trim}
+    , m_frequency{frequency}
+    , m_gate{GATE_PERIODS}
+    , m_min{0}
+    , m_max{TRIM_MAX}
+    , m_error{0}
+{
+    // empty
+}
+
+
+void COscillatorCalibration::SetGate(const uint32_t periods)
+{
+    m_gate = (periods > 0) ? periods : 1;
+}
+
+
+void COscillatorCalibration::SetRange(const uint8_t min, const uint8_t max)
+{
+    m_min = (min < max) ? min : max;
+    m_max = (min < max) ? max : min;
+}
+
+
+CRTC::status_t COscillatorCalibration::Calibrate(uint8_t &trim)
+{
+    uint32_t reference = m_rtc.GetReferenceFrequency();
+    CRTC::status_t status;
+    uint8_t saved;
+
+    if (reference == 0)
+    {
+        return CRTC::STATUS_ERROR;
+    }
+
+    status = m_rtc.StartReference(saved);
+
+    if (status != CRTC::STATUS_OK)
+    {
+        return status;
+    }
+
+    // MCU ticks expected over one gate
+    uint32_t target = (uint32_t)(((uint64_t)m_frequency * m_gate) / reference);
+    uint8_t low = m_min;
+    uint8_t high = m_max;
+    uint32_t ticks = 0;
+    uint32_t below = 0;
+
+    // Lowest trim running at or above the target
+    while ((low < high) && (status == CRTC::STATUS_OK))
+    {
+        uint8_t middle = low + ((high - low) / 2);
+
+        status = Measure(middle, ticks);
+
+        if (ticks < target)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    // Either it or its slower neighbour is closest
+    if (status == CRTC::STATUS_OK)
+    {
+        status = Measure(low, ticks);
+    }
+
+    if ((status == CRTC::STATUS_OK) && (low > m_min))
+    {
+        status = Measure(low - 1, below);
+
+        if (Distance(below, target) < Distance(ticks, target))
+        {
+            low--;
+            ticks = below;
+        }
+    }
+
+    // Output is restored even when a measurement failed
+    CRTC::status_t restore = m_rtc.StopReference(saved);
+
+    if (status != CRTC::STATUS_OK)
+    {
+        m_trim(trim);
+        return status;
+    }
+
+    m_trim(low);
+    trim = low;
+    m_error = (target > 0) ? (int32_t)((((int64_t)ticks - target) * 1000000) / target) : 0;
+
+    return restore;
+}
+
+
+int32_t COscillatorCalibration::GetError(void)
+{
+    return m_error;
+}
+
+
+/// Protected Functions ---------------------------------------
+
+CRTC::status_t COscillatorCalibration::Measure(const uint8_t trim, uint32_t &ticks)
+{
+    m_trim(trim);
+    ticks = m_capture(m_gate);
+
+    return (ticks > 0) ? CRTC::STATUS_OK : CRTC::STATUS_TIMEOUT;
+}
+
+
+uint32_t COscillatorCalibration::Distance(const uint32_t ticks, const uint32_t target)
+{
+    return (ticks > target) ? (ticks - target) : (target - ticks);
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        OscillatorCalibration.h
+ * @summary     MCU oscillator calibration against the RTC reference output
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#ifndef _OSCILLATOR_CALIBRATION_H_
+#define _OSCILLATOR_CALIBRATION_H_
+
+#include "nRTC.h"
+
+// Trims the MCU RC oscillator (e.g. OSCCAL) against the RTC's precise clock
+// output. Each step times a fixed number of reference periods with the MCU
+// clock, so a calibration costs about log2(range) + 2 gates.
+class COscillatorCalibration
+{
+    public:
+    // MCU ticks over the given number of reference periods, e.g. timer input
+    // capture on the reference pin; 0 on failure. Should discard the first
+    // edge after a trim change so the oscillator has settled.
+    typedef uint32_t (*capture_t)(const uint32_t periods);
+
+    // Apply a trim value, e.g. OSCCAL = trim
+    typedef void (*trim_t)(const uint8_t trim);
+
+    protected:
+    enum config_t : uint16_t
+    {
+        GATE_PERIODS    = 4096, // 125ms at 32768Hz
+        TRIM_MAX        = 127,  // ATmega328P OSCCAL lower range
+    };
+
+    CRTC &m_rtc;
+    capture_t m_capture;
+    trim_t m_trim;
+    uint32_t m_frequency;
+    uint32_t m_gate;
+    uint8_t m_min;
+    uint8_t m_max;
+    int32_t m_error;
+
+    public:
+    // frequency is the nominal MCU clock (Hz), e.g. F_CPU
+    COscillatorCalibration(CRTC &rtc, capture_t capture, trim_t trim, const uint32_t frequency);
+
+    // Reference periods per measurement; longer is finer but slower
+    void SetGate(const uint32_t periods);
+
+    // Trim search range; the oscillator must speed up as trim increases
+    void SetRange(const uint8_t min, const uint8_t max);
+
+    // Binary search for the trim closest to the nominal frequency. trim is
+    // the current value on entry, applied again if a step fails, and the
+    // calibrated value on return. The reference output is restored after.
+    CRTC::status_t Calibrate(uint8_t &trim);
+
+    // Residual error (ppm) of the last calibration, positive = MCU fast
+    int32_t GetError(void);
+
+    protected:
+    CRTC::status_t Measure(const uint8_t trim, uint32_t &ticks);
+    static uint32_t Distance(const uint32_t ticks, const uint32_t target);
+};
+
+#endif
@@ -26,27 +26,30 @@
  */
 
 #include "PCF2129.h"
-#include <Arduino.h>
+#include "RTCPlatform.h"
 
 void CPCF2129::Initialize(void)
 {
-    uint8_t byte;
-    
     CRTC::Initialize();                     // Setup i2c
     delay(250);                             // Wait for i2c
-    CRTC::I2CReadByte(ADDRESS_TIME);        // Send stop bit
-    byte = CRTC::I2CReadByte(ADDRESS_TIME); // Read OSF
     
-    // Check if Oscillator Stop Flag is set
-    if (byte & BITMASK_OSF)
+    CRTC::RTC rtc;
+    CRTC::status_t status = GetRTC(rtc);
+    
+    // Oscillator Stop Flag is reported by the time read itself; registers
+    // are undefined after power-on, so out of range contents also reset
+    if ((status == CRTC::STATUS_HALTED) || (status == CRTC::STATUS_INVALID))
     {
+        // Encoded by the compiler; written without a read or conversion
+        constexpr TimeImage<PCF2129Map> DEFAULT_TIME = "2000-01-01T00:00:00"_rtc;
+        constexpr CRTC::AlarmImage DEFAULT_ALARM = AlarmDaily(0, 0);
+        
         //I2CWriteByte(ADDRESS_CONTROL_3, 0xA0);                    // Adjust power management
         CRTC::I2CWriteByte(ADDRESS_TIMESTAMP, BITMASK_TSOFF);       // Disable timestamp
         CRTC::I2CWriteByte(ADDRESS_CONTROL_1, 0x00);                // Clear Power-On-Reset Override
         CRTC::I2CWriteByte(ADDRESS_CLOCKOUT, BITMASK_CLOCK_OUT_F);  // Disable Clock-out & clear OTPR
-        CRTC::SetTime(0, 0, 0);                                     // Set default time
-        CRTC::SetDate(0, 1, 1);                                     // Set default date
-        CRTC::SetAlarmTime(0, 0, 0);                                // Set default alarm
+        SetRTC(DEFAULT_TIME);                                       // Set default date & time, clear OSF
+        SetAlarmImage(DEFAULT_ALARM);                               // Set default alarm
         delay(1750);                                                // Wait for oscillator to stabilize
         CRTC::I2CWriteByte(ADDRESS_CLOCKOUT, BITMASK_OTP_REFRESH | BITMASK_CLOCK_OUT_F); // Perform OTP refresh
         delay(100); // Wait for OTP refresh to complete
@@ -54,64 +57,39 @@ void CPCF2129::Initialize(void)
 }
 
 
-void CPCF2129::GetRTC(CRTC::RTC &rtc)
+CRTC::status_t CPCF2129::AlarmReset(void)
 {
-    uint8_t data[7];
+    uint8_t b;
 
-    if (CRTC::I2CRead(ADDRESS_TIME, data, 7) == CRTC::STATUS_OK)
+    if (CRTC::I2CReadByte(ADDRESS_CONTROL_2, b) != CRTC::STATUS_OK)
     {
-        // Clear clock halt bit from read data
-        data[0] &= ~(BITMASK_OSF); // clear OSF bit
-        
-        m_rtc.second        = CRTC::BCD_to_DEC(data[0]);
-        m_rtc.minute        = CRTC::BCD_to_DEC(data[1]);
-        m_rtc.hour          = CRTC::BCD_to_DEC(data[2]);
-        m_rtc.day           = CRTC::BCD_to_DEC(data[3]);
-        m_rtc.week_day      = CRTC::BCD_to_DEC(data[4]) + 1; // week 0-6
-        m_rtc.month         = CRTC::BCD_to_DEC(data[5]); // month 1-12
-        m_rtc.year          = CRTC::BCD_to_DEC(data[6]); // year 0-99
-
-        m_rtc.am            = (m_rtc.hour < 12);
-        m_rtc.twelve_hour   = (m_rtc.hour % 12);
-        m_rtc.twelve_hour  += (m_rtc.twelve_hour == 0) ? 12 : 0;
+        return m_status;
     }
 
-    rtc = m_rtc;
+    // Clear alarm flag; MSF, WDTF and the interrupt enables are kept
+    b &= ~(BITMASK_ALARM_FLAG);
+
+    return CRTC::I2CWriteByte(ADDRESS_CONTROL_2, b);
 }
 
 
-CRTC::status_t CPCF2129::SetRTC(const CRTC::RTC &rtc)
+CRTC::status_t CPCF2129::SetAlarmRTC(const CRTC::RTC &rtc)
 {
-    uint8_t data[7] =
+    uint8_t data[3] =
     {
         CRTC::DEC_to_BCD(rtc.second),
         CRTC::DEC_to_BCD(rtc.minute),
         CRTC::DEC_to_BCD(rtc.hour),
-        CRTC::DEC_to_BCD(rtc.day),
-        CRTC::DEC_to_BCD(DayOfWeek(rtc.year, rtc.month, rtc.day) - 1),
-        CRTC::DEC_to_BCD(rtc.month),
-        CRTC::DEC_to_BCD(rtc.year)
     };
-
-    return CRTC::I2CWrite(ADDRESS_TIME, data, 7);
+    
+    return CRTC::I2CWrite(ADDRESS_ALARM, data, 3);
 }
 
 
-CRTC::status_t CPCF2129::AlarmReset(void)
+CRTC::status_t CPCF2129::SetAlarmImage(const CRTC::AlarmImage &alarm)
 {
-    // Clear alarm flag
-    return CRTC::I2CWriteByte(ADDRESS_CONTROL_2, 0x00);
-}
-
-
-CRTC::status_t CPCF2129::SetAlarmRTC(const CRTC::RTC &rtc)
-{
-    uint8_t data[3] =
-    {
-        CRTC::DEC_to_BCD(rtc.second),
-        CRTC::DEC_to_BCD(rtc.minute),
-        CRTC::DEC_to_BCD(rtc.hour),
-    };
+    // Alarm registers hold plain BCD with the enable bits clear
+    uint8_t data[3] = {alarm.second, alarm.minute, alarm.hour};
     
     return CRTC::I2CWrite(ADDRESS_ALARM, data, 3);
 }
@@ -134,50 +112,236 @@ CRTC::status_t CPCF2129::SetAlarmState(const CRTC::State state)
         }
     }
 
-    return CRTC::STATUS_ERROR;
+    return m_status;
 }
 
 
-void CPCF2129::GetAlarmRTC(CRTC::RTC &rtc)
+CRTC::status_t CPCF2129::GetAlarmRTC(CRTC::RTC &rtc)
 {
     uint8_t data[3];
+    CRTC::status_t status = CRTC::I2CRead(ADDRESS_ALARM, data, 3);
 
-    if (CRTC::I2CRead(ADDRESS_ALARM, data, 3) == CRTC::STATUS_OK)
+    if (status == CRTC::STATUS_OK)
     {
         rtc.second  = CRTC::BCD_to_DEC(data[0] & ~BITMASK_ALARM_TOGGLE);
         rtc.minute  = CRTC::BCD_to_DEC(data[1] & ~BITMASK_ALARM_TOGGLE);
         rtc.hour    = CRTC::BCD_to_DEC(data[2] & ~BITMASK_ALARM_TOGGLE);
     }
+
+    return status;
+}
+
+
+CRTC::status_t CPCF2129::GetAlarmState(CRTC::State &state)
+{
+    uint8_t b;
+
+    if (CRTC::I2CReadByte(ADDRESS_ALARM, b) == CRTC::STATUS_OK)
+    {
+        state = (b & BITMASK_ALARM_TOGGLE) ? CRTC::State::DISABLE : CRTC::State::ENABLE;
+    }
+
+    return m_status;
 }
 
 
 CRTC::State CPCF2129::GetAlarmState(void)
+{
+    CRTC::State state = CRTC::State::DISABLE;
+
+    GetAlarmState(state);
+    return state;
+}
+
+
+CRTC::status_t CPCF2129::IsAlarmTriggered(bool &triggered)
 {
     uint8_t b;
 
-    if ((b = CRTC::I2CReadByte(ADDRESS_ALARM)))
+    if (CRTC::I2CReadByte(ADDRESS_CONTROL_2, b) == CRTC::STATUS_OK)
     {
-        return (b & BITMASK_ALARM_TOGGLE) ? CRTC::State::DISABLE : CRTC::State::ENABLE;
+        triggered = !!(b & BITMASK_ALARM_FLAG);
     }
 
-    return CRTC::State::DISABLE;
+    return m_status;
 }
 
 
 bool CPCF2129::IsAlarmTriggered(void)
+{
+    bool triggered = false;
+
+    IsAlarmTriggered(triggered);
+    return triggered;
+}
+
+
+CRTC::status_t CPCF2129::SetCountdown(const TimerClock clock, const uint8_t value, const bool pulse)
+{
+    uint8_t data[2] =
+    {
+        (uint8_t)(((value != 0) ? BITMASK_WD_CD : 0)
+            | (pulse ? BITMASK_TI_TP : 0)
+            | ((uint8_t)clock & BITMASK_TIMER_CLOCK)),
+        value,
+    };
+
+    // Control and value in one burst; loading the value restarts the count
+    return CRTC::I2CWrite(ADDRESS_WATCHDOG_CTRL, data, 2);
+}
+
+
+CRTC::status_t CPCF2129::ReloadCountdown(const uint8_t value)
+{
+    // Also clears WDTF and releases INT
+    return CRTC::I2CWriteByte(ADDRESS_WATCHDOG_VALUE, value);
+}
+
+
+CRTC::status_t CPCF2129::IsCountdownTriggered(bool &triggered)
+{
+    uint8_t b;
+
+    if (CRTC::I2CReadByte(ADDRESS_CONTROL_2, b) == CRTC::STATUS_OK)
+    {
+        triggered = !!(b & BITMASK_WDTF);
+    }
+
+    return m_status;
+}
+
+
+bool CPCF2129::IsCountdownTriggered(void)
+{
+    bool triggered = false;
+
+    IsCountdownTriggered(triggered);
+    return triggered;
+}
+
+
+CRTC::status_t CPCF2129::SetPeriodicInterrupt(const Periodic period, const bool pulse)
 {
     uint8_t b;
 
-    if ((b = CRTC::I2CReadByte(ADDRESS_CONTROL_2)))
+    if (SetPulse(pulse) != CRTC::STATUS_OK)
+    {
+        return m_status;
+    }
+
+    if (CRTC::I2CReadByte(ADDRESS_CONTROL_1, b) != CRTC::STATUS_OK)
+    {
+        return m_status;
+    }
+
+    b &= ~(BITMASK_SI | BITMASK_MI);
+
+    if (period == Periodic::SECOND)
     {
-        return !!(b & BITMASK_ALARM_FLAG);
+        b |= BITMASK_SI;
+    }
+    else if (period == Periodic::MINUTE)
+    {
+        b |= BITMASK_MI;
+    }
+
+    if (CRTC::I2CWriteByte(ADDRESS_CONTROL_1, b) == CRTC::STATUS_OK)
+    {
+        return PeriodicReset();
     }
 
-    return false;
+    return m_status;
 }
 
 
-uint8_t CPCF2129::GetI2CAddress(void)
+CRTC::status_t CPCF2129::PeriodicReset(void)
 {
-    return ADDRESS_I2C;
+    uint8_t b;
+
+    if (CRTC::I2CReadByte(ADDRESS_CONTROL_2, b) != CRTC::STATUS_OK)
+    {
+        return m_status;
+    }
+
+    // Flags clear on writing 0; writing back 1 leaves the others unchanged
+    b &= ~(BITMASK_MSF);
+
+    return CRTC::I2CWriteByte(ADDRESS_CONTROL_2, b);
+}
+
+
+CRTC::status_t CPCF2129::IsPeriodicTriggered(bool &triggered)
+{
+    uint8_t b;
+
+    if (CRTC::I2CReadByte(ADDRESS_CONTROL_2, b) == CRTC::STATUS_OK)
+    {
+        triggered = !!(b & BITMASK_MSF);
+    }
+
+    return m_status;
+}
+
+
+bool CPCF2129::IsPeriodicTriggered(void)
+{
+    bool triggered = false;
+
+    IsPeriodicTriggered(triggered);
+    return triggered;
+}
+
+
+uint32_t CPCF2129::GetReferenceFrequency(void)
+{
+    return 32768;
+}
+
+
+CRTC::status_t CPCF2129::StartReference(uint8_t &saved)
+{
+    uint8_t b;
+
+    if (CRTC::I2CReadByte(ADDRESS_CLOCKOUT, b) != CRTC::STATUS_OK)
+    {
+        return m_status;
+    }
+
+    saved = (b & BITMASK_CLOCK_OUT_F);
+
+    // COF 0 selects 32768Hz; OTPR kept clear so no refresh is started
+    return CRTC::I2CWriteByte(ADDRESS_CLOCKOUT, b & ~(BITMASK_CLOCK_OUT_F | BITMASK_OTP_REFRESH));
+}
+
+
+CRTC::status_t CPCF2129::StopReference(const uint8_t saved)
+{
+    uint8_t b;
+
+    if (CRTC::I2CReadByte(ADDRESS_CLOCKOUT, b) != CRTC::STATUS_OK)
+    {
+        return m_status;
+    }
+
+    b &= ~(BITMASK_CLOCK_OUT_F | BITMASK_OTP_REFRESH);
+    b |= (saved & BITMASK_CLOCK_OUT_F);
+
+    return CRTC::I2CWriteByte(ADDRESS_CLOCKOUT, b);
+}
+
+
+/// Protected Functions ---------------------------------------
+
+CRTC::status_t CPCF2129::SetPulse(const bool pulse)
+{
+    uint8_t b;
+
+    if (CRTC::I2CReadByte(ADDRESS_WATCHDOG_CTRL, b) != CRTC::STATUS_OK)
+    {
+        return m_status;
+    }
+
+    b ^= (-pulse ^ b) & (BITMASK_TI_TP);
+
+    return CRTC::I2CWriteByte(ADDRESS_WATCHDOG_CTRL, b);
 }
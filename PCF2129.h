@@ -28,18 +28,41 @@
 #ifndef _PCF2129_H_
 #define _PCF2129_H_
 
-#include "nRTC.h"
+#include "RegisterMap.h"
 
-class CPCF2129 : public CRTC
+struct PCF2129Map : public RegisterMap
+{
+    static constexpr uint8_t I2C            = 0x51;
+    static constexpr uint8_t TIME           = 0x03;
+    static constexpr uint8_t DAY            = 3;
+    static constexpr uint8_t WEEK_DAY       = 4;
+    static constexpr uint8_t WEEK_DAY_BASE  = 0;
+    static constexpr uint8_t HALT_MASK      = 0x80; // Oscillator stop flag
+
+    typedef RegisterSpan<0x00, 0x11> Scope; // Control, time, alarm and countdown
+    typedef RegisterSet<0x00, 0x01, 0x02, 0x11> Volatile; // Flags; countdown reload clears WDTF
+};
+
+class CPCF2129 : public CMappedRTC<PCF2129Map>
 {
     public:
-    
-    protected:
-    enum I2C : uint8_t
+    // Countdown source clock; period = value / frequency
+    enum class TimerClock : uint8_t
     {
-        ADDRESS_I2C = 0x51,
+        F4096HZ,
+        F64HZ,
+        F1HZ,
+        F1_60HZ,
+    };
+
+    enum class Periodic : uint8_t
+    {
+        DISABLE,
+        SECOND,
+        MINUTE,
     };
     
+    protected:
     enum address_t : uint8_t
     {
         ADDRESS_CONTROL_1       = 0x00,
@@ -49,6 +72,8 @@ class CPCF2129 : public CRTC
         ADDRESS_DATE            = 0x06,
         ADDRESS_ALARM           = 0x0A,
         ADDRESS_CLOCKOUT        = 0x0F,
+        ADDRESS_WATCHDOG_CTRL   = 0x10,
+        ADDRESS_WATCHDOG_VALUE  = 0x11,
         ADDRESS_TIMESTAMP       = 0x12,
     };
     
@@ -62,23 +87,51 @@ class CPCF2129 : public CRTC
         BITMASK_CLOCK_OUT_F     = 0x07,
         BITMASK_POWER_MNG       = 0xE0,
         BITMASK_TSOFF           = 0x40,
+        BITMASK_SI              = 0x01,
+        BITMASK_MI              = 0x02,
+        BITMASK_MSF             = 0x80,
+        BITMASK_WDTF            = 0x40,
+        BITMASK_WD_CD           = 0x80,
+        BITMASK_TI_TP           = 0x20,
+        BITMASK_TIMER_CLOCK     = 0x03,
     };
 
     public:
     
     void Initialize(void);
-    void GetRTC(CRTC::RTC &rtc);
-    CRTC::status_t SetRTC(const CRTC::RTC &rtc);
     
     CRTC::status_t AlarmReset(void);
     CRTC::status_t SetAlarmRTC(const CRTC::RTC &rtc);
+    CRTC::status_t SetAlarmImage(const CRTC::AlarmImage &alarm);
     CRTC::status_t SetAlarmState(const CRTC::State state);
-    void GetAlarmRTC(CRTC::RTC &rtc);
+    CRTC::status_t GetAlarmRTC(CRTC::RTC &rtc);
+    CRTC::status_t GetAlarmState(CRTC::State &state);
     CRTC::State GetAlarmState(void);
+    CRTC::status_t IsAlarmTriggered(bool &triggered);
     bool IsAlarmTriggered(void);
     
+    // Countdown (watchdog) timer on INT; value 0 stops it. The counter does
+    // not reload itself, so call ReloadCountdown for each further period.
+    // Pulse mode also applies to the second/minute interrupt.
+    CRTC::status_t SetCountdown(const TimerClock clock, const uint8_t value, const bool pulse);
+    CRTC::status_t ReloadCountdown(const uint8_t value);
+    CRTC::status_t IsCountdownTriggered(bool &triggered);
+    bool IsCountdownTriggered(void);
+    
+    // Second or minute interrupt on INT. In pulse mode INT repeats without
+    // any bus traffic; otherwise it stays low until PeriodicReset.
+    CRTC::status_t SetPeriodicInterrupt(const Periodic period, const bool pulse);
+    CRTC::status_t PeriodicReset(void);
+    CRTC::status_t IsPeriodicTriggered(bool &triggered);
+    bool IsPeriodicTriggered(void);
+    
+    // 32768Hz CLKOUT as calibration reference
+    uint32_t GetReferenceFrequency(void);
+    CRTC::status_t StartReference(uint8_t &saved);
+    CRTC::status_t StopReference(const uint8_t saved);
+    
     protected:
-    uint8_t GetI2CAddress(void);
+    CRTC::status_t SetPulse(const bool pulse);
 };
 
 #endif
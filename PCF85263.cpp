@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        PCF85263.cpp
+ * @summary     Real Time Clock interface for PCF85263A
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#include "PCF85263.h"
+
+void CPCF85263::Initialize(void)
+{
+    CRTC::Initialize(); // Setup i2c
+
+    uint8_t b;
+
+    // Enable 1/100 second counter
+    if (CRTC::I2CReadByte(ADDRESS_FUNCTION, b) == CRTC::STATUS_OK)
+    {
+        b |= BITMASK_CENTISECOND;
+        CRTC::I2CWriteByte(ADDRESS_FUNCTION, b);
+    }
+}
+
+
+CRTC::status_t CPCF85263::GetRTC(CRTC::RTCX &rtc)
+{
+    uint8_t data[8];
+
+    // Centiseconds are latched together with the time in a single burst
+    if (CRTC::I2CRead(ADDRESS_CENTISECOND, data, 8) == CRTC::STATUS_OK)
+    {
+        rtc.centisecond = CRTC::BCD_to_DEC(data[0]);
+        return Decode(&data[1], rtc, false);
+    }
+
+    m_time.ToRTC(rtc); // Fall back to cached value
+    return CRTC::STATUS_STALE;
+}
+
+
+CRTC::status_t CPCF85263::SetRTC(const CRTC::RTC &rtc)
+{
+    uint8_t data[1 + TIME_BYTES];
+
+    data[0] = 0; // centiseconds
+    Encode(rtc, &data[1]);
+
+    // Stop and clear prescaler so the new second starts on the write
+    if (Stop() == CRTC::STATUS_OK)
+    {
+        if (CRTC::I2CWrite(ADDRESS_CENTISECOND, data, sizeof(data)) == CRTC::STATUS_OK)
+        {
+            return Start();
+        }
+    }
+
+    return m_status;
+}
+
+
+CRTC::status_t CPCF85263::AlarmReset(void)
+{
+    // Clear alarm flag (writing 1 leaves other flags unchanged)
+    return CRTC::I2CWriteByte(ADDRESS_FLAGS, (uint8_t)~BITMASK_ALARM_FLAG);
+}
+
+
+CRTC::status_t CPCF85263::SetAlarmRTC(const CRTC::RTC &rtc)
+{
+    uint8_t data[3] =
+    {
+        CRTC::DEC_to_BCD(rtc.second),
+        CRTC::DEC_to_BCD(rtc.minute),
+        CRTC::DEC_to_BCD(rtc.hour),
+    };
+
+    if (CRTC::I2CWrite(ADDRESS_ALARM, data, 3) == CRTC::STATUS_OK)
+    {
+        return SetAlarmState(CRTC::State::ENABLE);
+    }
+
+    return m_status;
+}
+
+
+CRTC::status_t CPCF85263::SetAlarmState(const CRTC::State state)
+{
+    uint8_t enable;
+    uint8_t interrupt;
+
+    if ((CRTC::I2CReadByte(ADDRESS_ALARM_ENABLE, enable) != CRTC::STATUS_OK)
+        || (CRTC::I2CReadByte(ADDRESS_INTA_ENABLE, interrupt) != CRTC::STATUS_OK))
+    {
+        return m_status;
+    }
+
+    if (state == CRTC::State::ENABLE)
+    {
+        enable |= BITMASK_ALARM_ENABLE;
+        interrupt |= BITMASK_ALARM_INTERRUPT;
+    }
+    else
+    {
+        enable &= ~(BITMASK_ALARM_ENABLE);
+        interrupt &= ~(BITMASK_ALARM_INTERRUPT);
+    }
+
+    // Alarm when hour, minute and second match
+    if ((CRTC::I2CWriteByte(ADDRESS_ALARM_ENABLE, enable) == CRTC::STATUS_OK)
+        && (CRTC::I2CWriteByte(ADDRESS_INTA_ENABLE, interrupt) == CRTC::STATUS_OK))
+    {
+        return AlarmReset();
+    }
+
+    return m_status;
+}
+
+
+CRTC::status_t CPCF85263::GetAlarmRTC(CRTC::RTC &rtc)
+{
+    uint8_t data[3];
+    CRTC::status_t status = CRTC::I2CRead(ADDRESS_ALARM, data, 3);
+
+    if (status == CRTC::STATUS_OK)
+    {
+        rtc.second  = CRTC::BCD_to_DEC(data[0]);
+        rtc.minute  = CRTC::BCD_to_DEC(data[1]);
+        rtc.hour    = CRTC::BCD_to_DEC(data[2]);
+    }
+
+    return status;
+}
+
+
+CRTC::status_t CPCF85263::GetAlarmState(CRTC::State &state)
+{
+    uint8_t b;
+
+    if (CRTC::I2CReadByte(ADDRESS_ALARM_ENABLE, b) == CRTC::STATUS_OK)
+    {
+        state = ((b & BITMASK_ALARM_ENABLE) == BITMASK_ALARM_ENABLE) ? CRTC::State::ENABLE : CRTC::State::DISABLE;
+    }
+
+    return m_status;
+}
+
+
+CRTC::State CPCF85263::GetAlarmState(void)
+{
+    CRTC::State state = CRTC::State::DISABLE;
+
+    GetAlarmState(state);
+    return state;
+}
+
+
+CRTC::status_t CPCF85263::IsAlarmTriggered(bool &triggered)
+{
+    uint8_t b;
+
+    if (CRTC::I2CReadByte(ADDRESS_FLAGS, b) == CRTC::STATUS_OK)
+    {
+        triggered = !!(b & BITMASK_ALARM_FLAG);
+    }
+
+    return m_status;
+}
+
+
+bool CPCF85263::IsAlarmTriggered(void)
+{
+    bool triggered = false;
+
+    IsAlarmTriggered(triggered);
+    return triggered;
+}
+
+
+CRTC::status_t CPCF85263::SetMode(const Mode mode)
+{
+    uint8_t b;
+
+    if (CRTC::I2CReadByte(ADDRESS_FUNCTION, b) != CRTC::STATUS_OK)
+    {
+        return m_status;
+    }
+
+    if (mode == Mode::STOPWATCH)
+    {
+        b |= BITMASK_MODE;
+    }
+    else
+    {
+        b &= ~(BITMASK_MODE);
+    }
+
+    // Mode may only be changed while the counter is stopped
+    if (Stop() == CRTC::STATUS_OK)
+    {
+        if (CRTC::I2CWriteByte(ADDRESS_FUNCTION, b) == CRTC::STATUS_OK)
+        {
+            return Start();
+        }
+    }
+
+    return m_status;
+}
+
+
+CPCF85263::Mode CPCF85263::GetMode(void)
+{
+    uint8_t b = 0;
+
+    CRTC::I2CReadByte(ADDRESS_FUNCTION, b);
+    return (b & BITMASK_MODE) ? Mode::STOPWATCH : Mode::RTC;
+}
+
+
+CRTC::status_t CPCF85263::GetStopwatch(Stopwatch &stopwatch)
+{
+    uint8_t data[6];
+
+    if (CRTC::I2CRead(ADDRESS_CENTISECOND, data, 6) == CRTC::STATUS_OK)
+    {
+        // Clear oscillator stop and minute overflow bits from read data
+        data[1] &= ~(BITMASK_OS);
+        data[2] &= ~(BITMASK_EMON);
+
+        stopwatch.centisecond   = CRTC::BCD_to_DEC(data[0]);
+        stopwatch.second        = CRTC::BCD_to_DEC(data[1]);
+        stopwatch.minute        = CRTC::BCD_to_DEC(data[2]);
+        stopwatch.hour          = CRTC::BCD_to_DEC(data[3])
+                                + (100UL * CRTC::BCD_to_DEC(data[4]))
+                                + (10000UL * CRTC::BCD_to_DEC(data[5]));
+        return CRTC::STATUS_OK;
+    }
+
+    return m_status;
+}
+
+
+CRTC::status_t CPCF85263::SetStopwatch(const Stopwatch &stopwatch)
+{
+    uint8_t data[6] =
+    {
+        CRTC::DEC_to_BCD(stopwatch.centisecond),
+        CRTC::DEC_to_BCD(stopwatch.second),
+        CRTC::DEC_to_BCD(stopwatch.minute),
+        CRTC::DEC_to_BCD(stopwatch.hour % 100),
+        CRTC::DEC_to_BCD((stopwatch.hour / 100) % 100),
+        CRTC::DEC_to_BCD((stopwatch.hour / 10000) % 100),
+    };
+
+    if (Stop() == CRTC::STATUS_OK)
+    {
+        if (CRTC::I2CWrite(ADDRESS_CENTISECOND, data, 6) == CRTC::STATUS_OK)
+        {
+            return Start();
+        }
+    }
+
+    return m_status;
+}
+
+
+CRTC::status_t CPCF85263::SetStopwatchState(const CRTC::State state)
+{
+    return (state == CRTC::State::ENABLE) ? Start() : Stop();
+}
+
+
+/// Protected Functions ---------------------------------------
+
+CRTC::status_t CPCF85263::Stop(void)
+{
+    if (CRTC::I2CWriteByte(ADDRESS_STOP, BITMASK_STOP) == CRTC::STATUS_OK)
+    {
+        return CRTC::I2CWriteByte(ADDRESS_RESET, COMMAND_CLEAR_PRESCALER);
+    }
+
+    return m_status;
+}
+
+
+CRTC::status_t CPCF85263::Start(void)
+{
+    return CRTC::I2CWriteByte(ADDRESS_STOP, 0x00);
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        PCF85263.h
+ * @summary     Real Time Clock interface for PCF85263A
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#ifndef _PCF85263_H_
+#define _PCF85263_H_
+
+#include "RegisterMap.h"
+
+struct PCF85263Map : public RegisterMap
+{
+    static constexpr uint8_t I2C            = 0x51;
+    static constexpr uint8_t TIME           = 0x01;
+    static constexpr uint8_t DAY            = 3;
+    static constexpr uint8_t WEEK_DAY       = 4;
+    static constexpr uint8_t WEEK_DAY_BASE  = 0;
+    static constexpr uint8_t HALT_MASK      = 0x80; // Oscillator stop flag
+
+    typedef RegisterSpan<0x00, 0x10> Scope; // Centiseconds through alarm enables
+};
+
+class CPCF85263 : public CMappedRTC<PCF85263Map>
+{
+    public:
+    enum class Mode : uint8_t
+    {
+        RTC,
+        STOPWATCH,
+    };
+
+    // Stopwatch counter (hour 0-999999)
+    struct Stopwatch
+    {
+        Stopwatch()
+            : hour{0}
+            , minute{0}
+            , second{0}
+            , centisecond{0}
+        {
+            // empty
+        }
+
+        uint32_t hour;
+        uint8_t minute;
+        uint8_t second;
+        uint8_t centisecond;
+    };
+
+    protected:
+    enum address_t : uint8_t
+    {
+        ADDRESS_CENTISECOND     = 0x00,
+        ADDRESS_TIME            = 0x01,
+        ADDRESS_DATE            = 0x04,
+        ADDRESS_ALARM           = 0x08,
+        ADDRESS_ALARM_ENABLE    = 0x10,
+        ADDRESS_FUNCTION        = 0x28,
+        ADDRESS_INTA_ENABLE     = 0x29,
+        ADDRESS_FLAGS           = 0x2B,
+        ADDRESS_STOP            = 0x2E,
+        ADDRESS_RESET           = 0x2F,
+    };
+
+    enum bitmask_t : uint8_t
+    {
+        BITMASK_OS              = 0x80,
+        BITMASK_EMON            = 0x80,
+        BITMASK_CENTISECOND     = 0x80,
+        BITMASK_MODE            = 0x10,
+        BITMASK_STOP            = 0x01,
+        BITMASK_ALARM_ENABLE    = 0x07, // Alarm1 second, minute, hour
+        BITMASK_ALARM_FLAG      = 0x20,
+        BITMASK_ALARM_INTERRUPT = 0x10,
+    };
+
+    enum command_t : uint8_t
+    {
+        COMMAND_CLEAR_PRESCALER = 0xA4,
+    };
+
+    public:
+
+    void Initialize(void);
+    using CMappedRTC<PCF85263Map>::GetRTC;
+    CRTC::status_t GetRTC(CRTC::RTCX &rtc);
+    CRTC::status_t SetRTC(const CRTC::RTC &rtc);
+
+    CRTC::status_t AlarmReset(void);
+    CRTC::status_t SetAlarmRTC(const CRTC::RTC &rtc);
+    CRTC::status_t SetAlarmState(const CRTC::State state);
+    CRTC::status_t GetAlarmRTC(CRTC::RTC &rtc);
+    CRTC::status_t GetAlarmState(CRTC::State &state);
+    CRTC::State GetAlarmState(void);
+    CRTC::status_t IsAlarmTriggered(bool &triggered);
+    bool IsAlarmTriggered(void);
+
+    // Stopwatch functions
+    CRTC::status_t SetMode(const Mode mode);
+    Mode GetMode(void);
+    CRTC::status_t GetStopwatch(Stopwatch &stopwatch);
+    CRTC::status_t SetStopwatch(const Stopwatch &stopwatch);
+    CRTC::status_t SetStopwatchState(const CRTC::State state);
+
+    protected:
+    CRTC::status_t Stop(void);
+    CRTC::status_t Start(void);
+};
+
+#endif
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        RTCBus.cpp
+ * @summary     Bus transport interface for RTC devices
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#include "RTCBus.h"
+
+#if defined(__linux__) && !defined(ARDUINO)
+#include <fcntl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+CRTCBus* CRTCBus::GetDefault(void)
+{
+#if defined(ARDUINO)
+    static CNI2CBus bus;
+    return &bus;
+#else
+    return nullptr;
+#endif
+}
+
+
+uint32_t CRTCBus::GetTransferTime(const bool read, const uint8_t bytes, const Speed speed)
+{
+    // Address and register bytes, plus the repeated start address for reads
+    uint16_t frame = (read ? 3 : 2) + bytes;
+
+    // 9 clocks per byte plus start and stop
+    uint32_t clocks = (9UL * frame) + 2;
+
+    return (speed == Speed::FAST) ? ((clocks * 5) / 2) : (clocks * 10);
+}
+
+
+#if defined(ARDUINO)
+CNI2CBus::CNI2CBus(void)
+    : m_count{0}
+{
+    // empty
+}
+
+
+CRTCBus::handle_t CNI2CBus::RegisterDevice(const uint8_t address, const Speed speed)
+{
+    // Drivers register on every Initialize; nI2C slots are not released
+    for (uint8_t i = 0; i < m_count; i++)
+    {
+        if ((m_address[i] == address) && (m_speed[i] == speed))
+        {
+            return i;
+        }
+    }
+
+    if (m_count >= MAX_DEVICES)
+    {
+        return HANDLE_INVALID;
+    }
+
+    // One byte register address
+    m_handle[m_count] = nI2C->RegisterDevice(address, 1,
+        (speed == Speed::FAST) ? CI2C::Speed::FAST : CI2C::Speed::SLOW);
+    m_address[m_count] = address;
+    m_speed[m_count] = speed;
+
+    return m_count++;
+}
+
+
+uint8_t CNI2CBus::Write(const handle_t handle, const uint8_t reg, const uint8_t data[], const uint8_t bytes)
+{
+    if (handle >= m_count)
+    {
+        return 0xFF;
+    }
+
+    return nI2C->Write(m_handle[handle], reg, data, bytes);
+}
+
+
+uint8_t CNI2CBus::Read(const handle_t handle, const uint8_t reg, uint8_t data[], const uint8_t bytes)
+{
+    if (handle >= m_count)
+    {
+        return 0xFF;
+    }
+
+    return nI2C->Read(m_handle[handle], reg, data, bytes);
+}
+#endif
+
+
+#if defined(__linux__) && !defined(ARDUINO)
+CLinuxI2CBus::CLinuxI2CBus(void)
+    : m_fd{-1}
+    , m_count{0}
+{
+    // empty
+}
+
+
+CLinuxI2CBus::~CLinuxI2CBus(void)
+{
+    Close();
+}
+
+
+bool CLinuxI2CBus::Open(const uint8_t adapter)
+{
+    char path[16];
+
+    Close();
+    snprintf(path, sizeof(path), "/dev/i2c-%u", adapter);
+    m_fd = open(path, O_RDWR);
+
+    return (m_fd >= 0);
+}
+
+
+void CLinuxI2CBus::Close(void)
+{
+    if (m_fd >= 0)
+    {
+        close(m_fd);
+        m_fd = -1;
+    }
+}
+
+
+CRTCBus::handle_t CLinuxI2CBus::RegisterDevice(const uint8_t address, const Speed speed)
+{
+    (void)speed; // Set by the adapter (device tree / module parameter)
+
+    for (uint8_t i = 0; i < m_count; i++)
+    {
+        if (m_address[i] == address)
+        {
+            return i;
+        }
+    }
+
+    if (m_count >= MAX_DEVICES)
+    {
+        return HANDLE_INVALID;
+    }
+
+    m_address[m_count] = address;
+    return m_count++;
+}
+
+
+uint8_t CLinuxI2CBus::Write(const handle_t handle, const uint8_t reg, const uint8_t data[], const uint8_t bytes)
+{
+    uint8_t buffer[256 + 1];
+    struct i2c_msg message;
+    struct i2c_rdwr_ioctl_data transfer;
+
+    if (handle >= m_count)
+    {
+        return 0xFF;
+    }
+
+    // Register address and payload in a single message
+    buffer[0] = reg;
+    memcpy(&buffer[1], data, bytes);
+
+    message.addr = m_address[handle];
+    message.flags = 0;
+    message.len = (1 + bytes);
+    message.buf = buffer;
+
+    transfer.msgs = &message;
+    transfer.nmsgs = 1;
+
+    return (Transfer(transfer) == 1) ? 0 : 1;
+}
+
+
+uint8_t CLinuxI2CBus::Read(const handle_t handle, const uint8_t reg, uint8_t data[], const uint8_t bytes)
+{
+    uint8_t address = reg;
+    struct i2c_msg message[2];
+    struct i2c_rdwr_ioctl_data transfer;
+
+    if (handle >= m_count)
+    {
+        return 0xFF;
+    }
+
+    // Register pointer write and read joined by a repeated start
+    message[0].addr = m_address[handle];
+    message[0].flags = 0;
+    message[0].len = 1;
+    message[0].buf = &address;
+
+    message[1].addr = m_address[handle];
+    message[1].flags = I2C_M_RD;
+    message[1].len = bytes;
+    message[1].buf = data;
+
+    transfer.msgs = message;
+    transfer.nmsgs = 2;
+
+    return (Transfer(transfer) == 2) ? 0 : 1;
+}
+
+
+int CLinuxI2CBus::Transfer(i2c_rdwr_ioctl_data &transfer)
+{
+    if (m_fd < 0)
+    {
+        return -1;
+    }
+
+    // Returns the number of messages transferred
+    return ioctl(m_fd, I2C_RDWR, &transfer);
+}
+#endif
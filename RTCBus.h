@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        RTCBus.h
+ * @summary     Bus transport interface for RTC devices
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#ifndef _RTC_BUS_H_
+#define _RTC_BUS_H_
+
+#include <inttypes.h>
+
+#if defined(ARDUINO)
+#include <nI2C.h>
+#endif
+
+// Register oriented transport: every transfer addresses a register and
+// auto-increments from there. Transfers return 0 on success.
+class CRTCBus
+{
+    public:
+    typedef uint8_t handle_t;
+
+    enum class Speed : uint8_t
+    {
+        SLOW,   // 100 kHz
+        FAST,   // 400 kHz
+    };
+
+    enum : handle_t
+    {
+        HANDLE_INVALID = 0xFF,
+    };
+
+    virtual handle_t RegisterDevice(const uint8_t address, const Speed speed) = 0;
+    virtual uint8_t Write(const handle_t handle, const uint8_t reg, const uint8_t data[], const uint8_t bytes) = 0;
+    virtual uint8_t Read(const handle_t handle, const uint8_t reg, uint8_t data[], const uint8_t bytes) = 0;
+
+    // nI2C on Arduino, none on the host
+    static CRTCBus* GetDefault(void);
+
+    // Wire time (us) of a register transfer of the given payload size
+    static uint32_t GetTransferTime(const bool read, const uint8_t bytes, const Speed speed);
+};
+
+
+#if defined(ARDUINO)
+// AVR TWI through the nI2C singleton
+class CNI2CBus : public CRTCBus
+{
+    protected:
+    enum config_t : uint8_t
+    {
+        MAX_DEVICES = 4,
+    };
+
+    CI2C::Handle m_handle[MAX_DEVICES];
+    uint8_t m_address[MAX_DEVICES];
+    Speed m_speed[MAX_DEVICES];
+    uint8_t m_count;
+
+    public:
+    CNI2CBus(void);
+
+    // A device already registered at the same speed gets its handle back
+    handle_t RegisterDevice(const uint8_t address, const Speed speed);
+    uint8_t Write(const handle_t handle, const uint8_t reg, const uint8_t data[], const uint8_t bytes);
+    uint8_t Read(const handle_t handle, const uint8_t reg, uint8_t data[], const uint8_t bytes);
+};
+#endif
+
+
+#if defined(__linux__) && !defined(ARDUINO)
+struct i2c_rdwr_ioctl_data;
+
+// Linux /dev/i2c-N; register reads are one combined I2C_RDWR transfer
+// (write register, repeated start, read) instead of a write+read pair.
+// Bus speed is fixed by the adapter configuration, not per device.
+class CLinuxI2CBus : public CRTCBus
+{
+    protected:
+    enum config_t : uint8_t
+    {
+        MAX_DEVICES = 4,
+    };
+
+    int m_fd;
+    uint8_t m_address[MAX_DEVICES];
+    uint8_t m_count;
+
+    public:
+    CLinuxI2CBus(void);
+    ~CLinuxI2CBus(void);
+
+    // Open /dev/i2c-<adapter>, false on failure
+    bool Open(const uint8_t adapter);
+    void Close(void);
+
+    // A device already registered gets its handle back
+    handle_t RegisterDevice(const uint8_t address, const Speed speed);
+    uint8_t Write(const handle_t handle, const uint8_t reg, const uint8_t data[], const uint8_t bytes);
+    uint8_t Read(const handle_t handle, const uint8_t reg, uint8_t data[], const uint8_t bytes);
+
+    protected:
+    // Issue one I2C_RDWR ioctl; override to route messages elsewhere
+    virtual int Transfer(i2c_rdwr_ioctl_data &transfer);
+};
+#endif
+
+#endif
@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        RTCEvents.cpp
+ * @summary     RTC alarm, tick and timestamp events as Linux file descriptors
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#include "RTCEvents.h"
+
+#if defined(__linux__) && !defined(ARDUINO)
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+static const uint64_t NANOSECONDS = 1000000000ULL;
+
+CRTCEvents::CRTCEvents(CRTC &rtc)
+    : m_rtc(rtc)
+    , m_source{Source::PIN}
+    , m_alarm{-1}
+    , m_tick{-1}
+    , m_timestamp{-1, -1}
+    , m_epoch{0}
+    , m_edge{0}
+{
+    // empty
+}
+
+
+CRTCEvents::~CRTCEvents(void)
+{
+    Close();
+}
+
+
+bool CRTCEvents::Open(const Source source)
+{
+    Close();
+
+    m_source = source;
+    m_alarm = (source == Source::TIMER) ? timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)
+                                        : eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    m_tick = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if ((m_alarm < 0) || (m_tick < 0) || (pipe2(m_timestamp, O_NONBLOCK | O_CLOEXEC) != 0))
+    {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+
+void CRTCEvents::Close(void)
+{
+    int *fd[] = {&m_alarm, &m_tick, &m_timestamp[0], &m_timestamp[1]};
+
+    for (uint8_t i = 0; i < (sizeof(fd) / sizeof(fd[0])); i++)
+    {
+        if (*fd[i] >= 0)
+        {
+            close(*fd[i]);
+            *fd[i] = -1;
+        }
+    }
+}
+
+
+int CRTCEvents::GetDescriptor(const Event event)
+{
+    switch (event)
+    {
+        case Event::ALARM:
+            return m_alarm;
+        case Event::TICK:
+            return m_tick;
+        default:
+            return m_timestamp[0];
+    }
+}
+
+
+void CRTCEvents::OnAlarmEdge(void)
+{
+    if ((m_source == Source::PIN) && (m_alarm >= 0))
+    {
+        eventfd_write(m_alarm, 1);
+    }
+}
+
+
+void CRTCEvents::OnTickEdge(void)
+{
+    uint32_t epoch = (m_epoch.fetch_add(1) + 1);
+
+    m_edge.store(GetMonotonic());
+
+    if (m_tick < 0)
+    {
+        return;
+    }
+
+    // A full pipe drops the record; the TICK count still advances
+    ssize_t written = write(m_timestamp[1], &epoch, sizeof(epoch));
+    UNUSED(written);
+
+    eventfd_write(m_tick, 1);
+}
+
+
+CRTC::status_t CRTCEvents::Synchronize(void)
+{
+    uint32_t epoch;
+    CRTC::status_t status = m_rtc.GetEpoch(epoch);
+
+    if (status == CRTC::STATUS_OK)
+    {
+        m_epoch.store(epoch);
+    }
+
+    return status;
+}
+
+
+CRTC::status_t CRTCEvents::ArmAlarm(void)
+{
+    uint8_t hour;
+    uint8_t minute;
+    uint8_t second;
+    uint32_t epoch;
+    CRTC::status_t status;
+
+    if (m_source != Source::TIMER)
+    {
+        return CRTC::STATUS_ERROR;
+    }
+
+    if (((status = m_rtc.GetAlarmTime(hour, minute, second)) != CRTC::STATUS_OK)
+        || ((status = m_rtc.GetEpoch(epoch)) != CRTC::STATUS_OK))
+    {
+        return status;
+    }
+
+    uint64_t now = GetMonotonic();
+    uint64_t edge = m_edge.load();
+    uint32_t alarm = (3600UL * hour) + (60UL * minute) + second;
+    uint32_t delta = ((alarm + 86400) - (epoch % 86400)) % 86400;
+
+    // An alarm in the current second has already been handled
+    if (delta == 0)
+    {
+        delta = 86400;
+    }
+
+    // The current second began at a known tick edge; otherwise assume it
+    // began now, firing up to a second late
+    uint64_t start = (edge != 0) ? (now - ((now - edge) % NANOSECONDS)) : now;
+
+    return ArmTimer(start + (delta * NANOSECONDS) + (MARGIN_MS * 1000000ULL)) ? CRTC::STATUS_OK : CRTC::STATUS_ERROR;
+}
+
+
+uint32_t CRTCEvents::Acknowledge(const Event event)
+{
+    uint32_t count = 0;
+    uint32_t epoch;
+
+    switch (event)
+    {
+        case Event::ALARM:
+            if (ReadCounter(m_alarm) == 0)
+            {
+                return 0;
+            }
+
+            if (m_source == Source::TIMER)
+            {
+                bool triggered = false;
+
+                // Timer beat the RTC, or the read failed: look again shortly
+                if ((m_rtc.IsAlarmTriggered(triggered) != CRTC::STATUS_OK) || !triggered)
+                {
+                    ArmTimer(GetMonotonic() + (RETRY_MS * 1000000ULL));
+                    return 0;
+                }
+            }
+
+            m_rtc.AlarmReset(); // Releases INT for the next alarm
+
+            if (m_source == Source::TIMER)
+            {
+                ArmAlarm();
+            }
+
+            return 1;
+
+        case Event::TICK:
+            return (uint32_t)ReadCounter(m_tick);
+
+        default:
+            while (ReadTimestamp(epoch))
+            {
+                count++;
+            }
+
+            return count;
+    }
+}
+
+
+bool CRTCEvents::ReadTimestamp(uint32_t &epoch)
+{
+    return (m_timestamp[0] >= 0) && (read(m_timestamp[0], &epoch, sizeof(epoch)) == sizeof(epoch));
+}
+
+
+/// Protected Functions ---------------------------------------
+
+bool CRTCEvents::ArmTimer(const uint64_t deadline)
+{
+    struct itimerspec spec = {};
+
+    spec.it_value.tv_sec = (deadline / NANOSECONDS);
+    spec.it_value.tv_nsec = (deadline % NANOSECONDS);
+
+    return (timerfd_settime(m_alarm, TFD_TIMER_ABSTIME, &spec, nullptr) == 0);
+}
+
+
+uint64_t CRTCEvents::GetMonotonic(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * NANOSECONDS) + now.tv_nsec;
+}
+
+
+uint64_t CRTCEvents::ReadCounter(const int fd)
+{
+    uint64_t count = 0;
+
+    // eventfd and timerfd both return an 8 byte count
+    if ((fd < 0) || (read(fd, &count, sizeof(count)) != sizeof(count)))
+    {
+        return 0;
+    }
+
+    return count;
+}
+#endif
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        RTCEvents.h
+ * @summary     RTC alarm, tick and timestamp events as Linux file descriptors
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#ifndef _RTC_EVENTS_H_
+#define _RTC_EVENTS_H_
+
+#include "nRTC.h"
+
+#if defined(__linux__) && !defined(ARDUINO)
+#include <atomic>
+
+// RTC events as descriptors for an existing epoll/poll loop, so waiting
+// costs no CPU and no bus traffic. ALARM and TICK are counters (read with
+// Acknowledge); TIMESTAMP delivers the epoch of each tick, tracked without
+// bus access. Edges come from the INT and SQW lines (a GPIO line event, or
+// a simulated chip callback); without an INT line the alarm can instead be
+// predicted by a timer and confirmed with a single read.
+class CRTCEvents
+{
+    public:
+    enum class Event : uint8_t
+    {
+        ALARM,
+        TICK,
+        TIMESTAMP,
+    };
+
+    enum class Source : uint8_t
+    {
+        PIN,    // OnAlarmEdge from the INT line
+        TIMER,  // timerfd at the programmed alarm time
+    };
+
+    protected:
+    enum config_t : uint32_t
+    {
+        RETRY_MS    = 100,  // Re-check when the timer beat the RTC
+        MARGIN_MS   = 2,    // Past the predicted second edge
+    };
+
+    CRTC &m_rtc;
+    Source m_source;
+    int m_alarm;                    // eventfd, or timerfd for Source::TIMER
+    int m_tick;                     // eventfd
+    int m_timestamp[2];             // pipe read and write ends
+    std::atomic<uint32_t> m_epoch;  // Epoch since the last tick edge
+    std::atomic<uint64_t> m_edge;   // CLOCK_MONOTONIC (ns) of that edge, 0 before one
+
+    public:
+    CRTCEvents(CRTC &rtc);
+    ~CRTCEvents(void);
+
+    // Create the descriptors, false on failure
+    bool Open(const Source source);
+    void Close(void);
+
+    // Readable when the event is pending; -1 when closed
+    int GetDescriptor(const Event event);
+
+    // Pin edges. No bus access and async-signal-safe.
+    void OnAlarmEdge(void);
+    void OnTickEdge(void); // 1 Hz SQW edge at the seconds rollover
+
+    // Read the epoch once; later tick edges advance it
+    CRTC::status_t Synchronize(void);
+
+    // Source::TIMER: arm for the next occurrence of the programmed alarm
+    CRTC::status_t ArmAlarm(void);
+
+    // Drain a readable event and return its count. ALARM also clears the
+    // chip flag; with Source::TIMER it returns 0 and re-checks shortly when
+    // the RTC has not reached the alarm yet, else re-arms for the next day.
+    uint32_t Acknowledge(const Event event);
+
+    // Next TIMESTAMP record, false when none is queued
+    bool ReadTimestamp(uint32_t &epoch);
+
+    protected:
+    bool ArmTimer(const uint64_t deadline);
+    static uint64_t GetMonotonic(void);
+    static uint64_t ReadCounter(const int fd);
+};
+#endif
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        RTCLiteral.h
+ * @summary     Compile time date-time literals and alarm constants
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#ifndef _RTC_LITERAL_H_
+#define _RTC_LITERAL_H_
+
+#include "nRTC.h"
+#include <stddef.h>
+
+// Date-time literals and alarm constants checked by the compiler:
+//
+//   constexpr CRTC::Timestamp boot = "2026-10-17T06:30:00"_rtc;
+//   constexpr CRTC::AlarmImage wake = AlarmDaily(6, 30);
+//
+// A malformed or out of range value ends up calling one of the Invalid
+// functions below, which are not constexpr, so a constexpr declaration
+// fails to compile and names the problem. Outside a constant expression
+// nothing is checked; declare the constant constexpr.
+struct RTCLiteral
+{
+    // Accepts "YYYY-MM-DD", "YYYY-MM-DDTHH:MM:SS" or a space before the time
+    static constexpr CRTC::Timestamp Parse(const char *text, const size_t length)
+    {
+        return !IsFormat(text, length) ? CRTC::Timestamp(InvalidFormat())
+            : CRTC::Timestamp(Year(text), Month(text), Day(text),
+                Field(text, length, 11, 23), Field(text, length, 14, 59), Field(text, length, 17, 59));
+    }
+
+    static constexpr CRTC::AlarmImage Daily(const uint8_t hour, const uint8_t minute, const uint8_t second)
+    {
+        return ((hour > 23) || (minute > 59) || (second > 59)) ? CRTC::AlarmImage(InvalidAlarm(), 0, 0)
+            : CRTC::AlarmImage(ToBCD(second), ToBCD(minute), ToBCD(hour));
+    }
+
+    static constexpr uint8_t ToBCD(const uint8_t d)
+    {
+        return (d + (6 * (d / 10)));
+    }
+
+    protected:
+    static constexpr bool IsDigit(const char c)
+    {
+        return (c >= '0') && (c <= '9');
+    }
+
+    static constexpr bool IsFormat(const char *text, const size_t length)
+    {
+        return ((length == 10) || (length == 19))
+            && (text[4] == '-') && (text[7] == '-')
+            && ((length == 10) || (((text[10] == 'T') || (text[10] == ' '))
+                && (text[13] == ':') && (text[16] == ':')));
+    }
+
+    static constexpr uint8_t Digits(const char *text, const size_t index)
+    {
+        return (IsDigit(text[index]) && IsDigit(text[index + 1]))
+            ? (uint8_t)(((text[index] - '0') * 10) + (text[index + 1] - '0'))
+            : InvalidFormat();
+    }
+
+    // Chips count years 00-99 from 2000
+    static constexpr uint8_t Year(const char *text)
+    {
+        return ((text[0] == '2') && (text[1] == '0')) ? Digits(text, 2) : InvalidDate();
+    }
+
+    static constexpr uint8_t Month(const char *text)
+    {
+        return ((Digits(text, 5) >= 1) && (Digits(text, 5) <= 12)) ? Digits(text, 5) : InvalidDate();
+    }
+
+    static constexpr uint8_t DaysInMonth(const uint8_t y, const uint8_t m)
+    {
+        return (m == 2) ? (((y % 4) == 0) ? 29 : 28) : (((m == 4) || (m == 6) || (m == 9) || (m == 11)) ? 30 : 31);
+    }
+
+    static constexpr uint8_t Day(const char *text)
+    {
+        return ((Digits(text, 8) >= 1) && (Digits(text, 8) <= DaysInMonth(Year(text), Month(text))))
+            ? Digits(text, 8) : InvalidDate();
+    }
+
+    // Time of day field, 0 for a date only
+    static constexpr uint8_t Field(const char *text, const size_t length, const size_t index, const uint8_t limit)
+    {
+        return (length == 10) ? 0 : ((Digits(text, index) <= limit) ? Digits(text, index) : InvalidTime());
+    }
+
+    static uint8_t InvalidFormat(void) { return 0; }
+    static uint8_t InvalidDate(void) { return 0; }
+    static uint8_t InvalidTime(void) { return 0; }
+    static uint8_t InvalidAlarm(void) { return 0; }
+};
+
+
+constexpr CRTC::Timestamp operator"" _rtc(const char *text, const size_t length)
+{
+    return RTCLiteral::Parse(text, length);
+}
+
+
+// Alarm matching hour, minute and second every day
+constexpr CRTC::AlarmImage AlarmDaily(const uint8_t hour, const uint8_t minute, const uint8_t second = 0)
+{
+    return RTCLiteral::Daily(hour, minute, second);
+}
+
+#endif
@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        RegisterMap.h
+ * @summary     Declarative register maps generating RTC encode and decode
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#ifndef _REGISTER_MAP_H_
+#define _REGISTER_MAP_H_
+
+#include "RTCLiteral.h"
+
+// Smallest burst covering every listed register
+template <uint8_t FIRST, uint8_t... REST>
+struct RegisterSpan
+{
+    static constexpr uint8_t BEGIN = (FIRST < RegisterSpan<REST...>::BEGIN) ? FIRST : RegisterSpan<REST...>::BEGIN;
+    static constexpr uint8_t END = (FIRST > RegisterSpan<REST...>::END) ? FIRST : RegisterSpan<REST...>::END;
+    static constexpr uint8_t BYTES = END - BEGIN + 1;
+};
+
+template <uint8_t FIRST>
+struct RegisterSpan<FIRST>
+{
+    static constexpr uint8_t BEGIN = FIRST;
+    static constexpr uint8_t END = FIRST;
+    static constexpr uint8_t BYTES = 1;
+};
+
+struct RegisterSpanNone
+{
+    static constexpr uint8_t BEGIN = 0;
+    static constexpr uint8_t BYTES = 0;
+};
+
+// Bit set of individual registers below 0x40
+template <uint8_t... REGS>
+struct RegisterSet;
+
+template <>
+struct RegisterSet<>
+{
+    static constexpr uint64_t MASK = 0;
+};
+
+template <uint8_t FIRST, uint8_t... REST>
+struct RegisterSet<FIRST, REST...>
+{
+    static_assert(FIRST < 64, "Register set holds addresses below 0x40");
+    static constexpr uint64_t MASK = (1ULL << FIRST) | RegisterSet<REST...>::MASK;
+};
+
+// Chip description with DS1307 family defaults. A chip derives from it and
+// redeclares only what differs. Field positions are offsets within the
+// seven byte time burst starting at TIME.
+struct RegisterMap
+{
+    static constexpr uint8_t TIME           = 0x00;
+    static constexpr uint8_t SECOND         = 0;
+    static constexpr uint8_t MINUTE         = 1;
+    static constexpr uint8_t HOUR           = 2;
+    static constexpr uint8_t WEEK_DAY       = 3;
+    static constexpr uint8_t DAY            = 4;
+    static constexpr uint8_t MONTH          = 5;
+    static constexpr uint8_t YEAR           = 6;
+
+    // Value bits; the rest are control or status flags
+    static constexpr uint8_t SECOND_MASK    = 0x7F;
+    static constexpr uint8_t MINUTE_MASK    = 0x7F;
+    static constexpr uint8_t HOUR_MASK      = 0x3F;
+    static constexpr uint8_t WEEK_DAY_MASK  = 0x07;
+    static constexpr uint8_t DAY_MASK       = 0x3F;
+    static constexpr uint8_t MONTH_MASK     = 0x1F;
+
+    static constexpr uint8_t WEEK_DAY_BASE  = 1;    // First week day code
+    static constexpr uint8_t HALT_MASK      = 0x00; // Seconds bit set while stopped
+    static constexpr uint8_t RUN_MASK       = 0x00; // Week day bit set while running
+    static constexpr uint8_t SECOND_SET     = 0x00; // Seconds bits forced on write
+    static constexpr uint8_t WEEK_DAY_SET   = 0x00; // Week day bits forced on write
+
+    static constexpr uint8_t SRAM           = 0x00;
+    static constexpr uint8_t SRAM_SIZE      = 0;
+
+    typedef RegisterSpanNone Scope;                 // Window for CRTC::ReadScope
+    typedef RegisterSet<> Volatile;                 // Written value does not read back
+};
+
+// Time burst for a register map, encoded when the time is a constant:
+//   constexpr TimeImage<DS323xMap> image = "2026-10-17T06:30:00"_rtc;
+template <typename Map>
+struct TimeImage
+{
+    constexpr TimeImage(const CRTC::Timestamp time)
+        : data{Field(time, 0), Field(time, 1), Field(time, 2), Field(time, 3),
+            Field(time, 4), Field(time, 5), Field(time, 6)}
+    {
+        // empty
+    }
+
+    static constexpr uint8_t Field(const CRTC::Timestamp time, const uint8_t index)
+    {
+        return (index == Map::SECOND) ? (RTCLiteral::ToBCD(time.Second()) | Map::SECOND_SET)
+            : (index == Map::MINUTE) ? RTCLiteral::ToBCD(time.Minute())
+            : (index == Map::HOUR) ? RTCLiteral::ToBCD(time.Hour())
+            : (index == Map::WEEK_DAY) ? (RTCLiteral::ToBCD(time.WeekDay() - (1 - Map::WEEK_DAY_BASE)) | Map::WEEK_DAY_SET)
+            : (index == Map::DAY) ? RTCLiteral::ToBCD(time.Day())
+            : (index == Map::MONTH) ? RTCLiteral::ToBCD(time.Month())
+            : RTCLiteral::ToBCD(time.Year());
+    }
+
+    uint8_t data[7];
+};
+
+// Driver base implementing the calendar, SRAM and addressing entirely from
+// a register map. Field positions, masks and week day base are constants,
+// so encode and decode compile to the same code as a hand-written driver.
+// Drivers add alarms and chip features on top.
+template <typename Map>
+class CMappedRTC : public CRTC
+{
+    public:
+    // Length of the time burst
+    static constexpr uint8_t TIME_BYTES = RegisterSpan<Map::SECOND, Map::MINUTE, Map::HOUR,
+        Map::WEEK_DAY, Map::DAY, Map::MONTH, Map::YEAR>::END + 1;
+
+    static_assert(((1 << Map::SECOND) | (1 << Map::MINUTE) | (1 << Map::HOUR) | (1 << Map::WEEK_DAY)
+        | (1 << Map::DAY) | (1 << Map::MONTH) | (1 << Map::YEAR)) == 0x7F,
+        "Register map fields must fill seven distinct bytes");
+
+    CRTC::status_t GetRTC(CRTC::RTC &rtc)
+    {
+        uint8_t data[TIME_BYTES];
+
+        if (CRTC::I2CRead(Map::TIME, data, TIME_BYTES) == CRTC::STATUS_OK)
+        {
+            return Decode(data, rtc, false);
+        }
+
+        m_time.ToRTC(rtc); // Fall back to cached value
+        return CRTC::STATUS_STALE;
+    }
+
+    CRTC::status_t SetRTC(const CRTC::RTC &rtc)
+    {
+        uint8_t data[TIME_BYTES];
+
+        Encode(rtc, data);
+        return CRTC::I2CWrite(Map::TIME, data, TIME_BYTES);
+    }
+
+    // Burst a pre-encoded time; no encode, week day computation or read
+    CRTC::status_t SetRTC(const TimeImage<Map> &image)
+    {
+        return CRTC::I2CWrite(Map::TIME, image.data, TIME_BYTES);
+    }
+
+    CRTC::status_t GetSRAM(const uint8_t offset, uint8_t data[], const uint8_t bytes)
+    {
+        if (Map::SRAM_SIZE == 0)
+        {
+            return CRTC::GetSRAM(offset, data, bytes);
+        }
+
+        return CRTC::I2CRead(Map::SRAM + offset, data, CRTC::FitSRAMRange(offset, bytes));
+    }
+
+    CRTC::status_t SetSRAM(const uint8_t offset, const uint8_t data[], const uint8_t bytes)
+    {
+        if (Map::SRAM_SIZE == 0)
+        {
+            return CRTC::SetSRAM(offset, data, bytes);
+        }
+
+        return CRTC::I2CWrite(Map::SRAM + offset, data, CRTC::FitSRAMRange(offset, bytes));
+    }
+
+    uint8_t GetSRAMSize(void)
+    {
+        return Map::SRAM_SIZE;
+    }
+
+    CRTC::status_t GetRTCAndSRAM(CRTC::RTC &rtc, const uint8_t offset, uint8_t data[], const uint8_t bytes)
+    {
+        if (Map::SRAM_SIZE == 0)
+        {
+            return CRTC::GetRTCAndSRAM(rtc, offset, data, bytes);
+        }
+
+        return GetRTCAndRegisters<SNAPSHOT_END>(rtc, Map::SRAM + offset, data, CRTC::FitSRAMRange(offset, bytes));
+    }
+
+    protected:
+    // SRAM bytes read along with the time; requests reaching further take
+    // two reads, keeping the burst buffer off the stack of small targets
+    static constexpr uint8_t SNAPSHOT_SRAM = 32;
+
+    // Last register of the time and SRAM burst
+    static constexpr uint8_t SNAPSHOT_END = (Map::SRAM_SIZE == 0) ? (Map::TIME + TIME_BYTES - 1)
+        : (Map::SRAM + ((Map::SRAM_SIZE < SNAPSHOT_SRAM) ? Map::SRAM_SIZE : SNAPSHOT_SRAM) - 1);
+
+    // Time and the given registers, in one burst when they follow the time
+    // and end by register END
+    template <uint8_t END>
+    CRTC::status_t GetRTCAndRegisters(CRTC::RTC &rtc, const uint8_t address, uint8_t data[], const uint8_t bytes)
+    {
+        static_assert(END >= (Map::TIME + TIME_BYTES - 1), "Burst must cover the time registers");
+
+        uint8_t burst[END - Map::TIME + 1];
+        uint16_t length = ((uint16_t)address + bytes - Map::TIME);
+
+        if ((address < (Map::TIME + TIME_BYTES)) || (length > sizeof(burst)))
+        {
+            CRTC::status_t status = GetRTC(rtc);
+            CRTC::status_t registers = CRTC::I2CRead(address, data, bytes);
+
+            return (registers != CRTC::STATUS_OK) ? registers : status;
+        }
+
+        if (CRTC::I2CRead(Map::TIME, burst, length) != CRTC::STATUS_OK)
+        {
+            m_time.ToRTC(rtc); // Fall back to cached value
+            return m_status;
+        }
+
+        for (uint8_t i = 0; i < bytes; i++)
+        {
+            data[i] = burst[address - Map::TIME + i];
+        }
+
+        return Decode(burst, rtc, false);
+    }
+
+    // Decode a time burst; halted adds to the map's halt bit
+    CRTC::status_t Decode(const uint8_t data[], CRTC::RTC &rtc, const bool halted)
+    {
+        rtc.second          = CRTC::BCD_to_DEC(data[Map::SECOND] & Map::SECOND_MASK);
+        rtc.minute          = CRTC::BCD_to_DEC(data[Map::MINUTE] & Map::MINUTE_MASK);
+        rtc.hour            = CRTC::BCD_to_DEC(data[Map::HOUR] & Map::HOUR_MASK);
+        rtc.day             = CRTC::BCD_to_DEC(data[Map::DAY] & Map::DAY_MASK);
+        rtc.month           = CRTC::BCD_to_DEC(data[Map::MONTH] & Map::MONTH_MASK); // month 1-12
+        rtc.year            = CRTC::BCD_to_DEC(data[Map::YEAR]); // year 0-99
+        rtc.week_day        = CRTC::BCD_to_DEC(data[Map::WEEK_DAY] & Map::WEEK_DAY_MASK)
+                            + (1 - Map::WEEK_DAY_BASE); // week 1-7
+
+        return CRTC::ValidateRTC(rtc, halted || (data[Map::SECOND] & Map::HALT_MASK)
+            || ((Map::RUN_MASK != 0) && !(data[Map::WEEK_DAY] & Map::RUN_MASK)));
+    }
+
+    void Encode(const CRTC::RTC &rtc, uint8_t data[])
+    {
+        data[Map::SECOND]   = CRTC::DEC_to_BCD(rtc.second) | Map::SECOND_SET;
+        data[Map::MINUTE]   = CRTC::DEC_to_BCD(rtc.minute);
+        data[Map::HOUR]     = CRTC::DEC_to_BCD(rtc.hour);
+        data[Map::WEEK_DAY] = CRTC::DEC_to_BCD(CRTC::DayOfWeek(rtc.year, rtc.month, rtc.day)
+                            - (1 - Map::WEEK_DAY_BASE)) | Map::WEEK_DAY_SET;
+        data[Map::DAY]      = CRTC::DEC_to_BCD(rtc.day);
+        data[Map::MONTH]    = CRTC::DEC_to_BCD(rtc.month);
+        data[Map::YEAR]     = CRTC::DEC_to_BCD(rtc.year);
+    }
+
+    uint8_t GetI2CAddress(void)
+    {
+        return Map::I2C;
+    }
+
+    void GetScopeRange(uint8_t &address, uint8_t &bytes)
+    {
+        address = Map::Scope::BEGIN;
+        bytes = Map::Scope::BYTES;
+    }
+
+    bool IsScopeVolatile(const uint8_t address)
+    {
+        return (address < 64) && ((Map::Volatile::MASK >> address) & 1);
+    }
+};
+
+#endif
@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        SRAMStore.cpp
+ * @summary     Crash safe key-value store in RTC battery backed SRAM
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#include "SRAMStore.h"
+#include "nCRC.h"
+
+CSRAMStore::CSRAMStore(CRTC &rtc, const uint8_t offset, const uint8_t bytes, const uint8_t value_size)
+    : m_rtc(rtc)
+    , m_offset{offset}
+    , m_value_size{value_size}
+    , m_buckets{0}
+{
+    uint8_t size = rtc.GetSRAMSize();
+
+    if ((value_size == 0) || (value_size > MAX_VALUE_SIZE) || (offset >= size))
+    {
+        return; // No usable capacity
+    }
+
+    uint8_t length = ((size - offset) < bytes) ? (size - offset) : bytes;
+    m_buckets = (length / GetBucketSize());
+}
+
+
+CRTC::status_t CSRAMStore::Get(const uint8_t key, uint8_t value[])
+{
+    uint8_t data[2 * (MAX_VALUE_SIZE + RECORD_OVERHEAD)];
+    uint8_t bucket;
+
+    if ((key == KEY_EMPTY) || (key == KEY_REMOVED))
+    {
+        return CRTC::STATUS_INVALID;
+    }
+
+    CRTC::status_t status = Find(key, bucket, data);
+
+    if (status == CRTC::STATUS_OK)
+    {
+        const uint8_t *record = &data[GetNewest(data) * GetRecordSize()];
+
+        for (uint8_t i = 0; i < m_value_size; i++)
+        {
+            value[i] = record[2 + i];
+        }
+    }
+
+    return status;
+}
+
+
+CRTC::status_t CSRAMStore::Set(const uint8_t key, const uint8_t value[])
+{
+    uint8_t data[2 * (MAX_VALUE_SIZE + RECORD_OVERHEAD)];
+    uint8_t bucket;
+
+    if ((key == KEY_EMPTY) || (key == KEY_REMOVED))
+    {
+        return CRTC::STATUS_INVALID;
+    }
+
+    CRTC::status_t status = Find(key, bucket, data);
+
+    if (status == CRTC::STATUS_OK)
+    {
+        const uint8_t *record = &data[GetNewest(data) * GetRecordSize()];
+        bool changed = false;
+
+        for (uint8_t i = 0; i < m_value_size; i++)
+        {
+            changed |= (record[2 + i] != value[i]);
+        }
+
+        // Skip the write when nothing changed
+        if (!changed)
+        {
+            return CRTC::STATUS_OK;
+        }
+    }
+    else if ((status != CRTC::STATUS_ERROR) || (bucket == BUCKET_NONE))
+    {
+        return status; // Bus failure or store full
+    }
+
+    return Commit(bucket, data, key, value);
+}
+
+
+CRTC::status_t CSRAMStore::Remove(const uint8_t key)
+{
+    uint8_t data[2 * (MAX_VALUE_SIZE + RECORD_OVERHEAD)];
+    uint8_t value[MAX_VALUE_SIZE] = {0};
+    uint8_t bucket;
+
+    if ((key == KEY_EMPTY) || (key == KEY_REMOVED))
+    {
+        return CRTC::STATUS_INVALID;
+    }
+
+    CRTC::status_t status = Find(key, bucket, data);
+
+    if (status == CRTC::STATUS_OK)
+    {
+        return Commit(bucket, data, KEY_REMOVED, value);
+    }
+
+    return status;
+}
+
+
+CRTC::status_t CSRAMStore::Format(void)
+{
+    const uint8_t chunk = 16;
+    uint8_t data[chunk] = {0};
+    uint8_t length = (m_buckets * GetBucketSize());
+
+    for (uint8_t i = 0; i < length; i += chunk)
+    {
+        uint8_t bytes = ((length - i) < chunk) ? (length - i) : chunk;
+        CRTC::status_t status = m_rtc.SetSRAM(m_offset + i, data, bytes);
+
+        if (status != CRTC::STATUS_OK)
+        {
+            return status;
+        }
+    }
+
+    return CRTC::STATUS_OK;
+}
+
+
+uint8_t CSRAMStore::GetCapacity(void)
+{
+    return m_buckets;
+}
+
+
+/// Protected Functions ---------------------------------------
+
+CRTC::status_t CSRAMStore::Find(const uint8_t key, uint8_t &bucket, uint8_t data[])
+{
+    uint8_t free = BUCKET_NONE;
+    uint8_t last = BUCKET_NONE;
+    uint8_t index = (m_buckets > 0) ? ((uint8_t)(key * 151) % m_buckets) : 0;
+
+    bucket = BUCKET_NONE;
+
+    // Linear probing, each step reads both records in one burst
+    for (uint8_t i = 0; i < m_buckets; i++)
+    {
+        CRTC::status_t status = m_rtc.GetSRAM(m_offset + (index * GetBucketSize()), data, GetBucketSize());
+
+        if (status != CRTC::STATUS_OK)
+        {
+            return status;
+        }
+
+        last = index;
+        int8_t newest = GetNewest(data);
+        uint8_t owner = (newest < 0) ? (uint8_t)KEY_EMPTY : data[newest * GetRecordSize()];
+
+        if (owner == key)
+        {
+            bucket = index;
+            return CRTC::STATUS_OK;
+        }
+
+        if ((owner == KEY_EMPTY) || (owner == KEY_REMOVED))
+        {
+            if (free == BUCKET_NONE)
+            {
+                free = index;
+            }
+
+            // Probe chains never extend past an empty bucket
+            if (owner == KEY_EMPTY)
+            {
+                break;
+            }
+        }
+
+        index = ((index + 1) < m_buckets) ? (index + 1) : 0;
+    }
+
+    // Leave the insertion bucket contents in data
+    if ((free != BUCKET_NONE) && (free != last))
+    {
+        CRTC::status_t status = m_rtc.GetSRAM(m_offset + (free * GetBucketSize()), data, GetBucketSize());
+
+        if (status != CRTC::STATUS_OK)
+        {
+            return status;
+        }
+    }
+
+    bucket = free;
+    return CRTC::STATUS_ERROR;
+}
+
+
+CRTC::status_t CSRAMStore::Commit(const uint8_t bucket, const uint8_t data[], const uint8_t key, const uint8_t value[])
+{
+    uint8_t record[MAX_VALUE_SIZE + RECORD_OVERHEAD];
+    uint8_t size = GetRecordSize();
+    int8_t newest = GetNewest(data);
+    uint8_t slot = (newest < 0) ? 0 : (1 - newest);
+
+    record[0] = key;
+    record[1] = (newest < 0) ? 0 : (data[(newest * size) + 1] + 1);
+
+    for (uint8_t i = 0; i < m_value_size; i++)
+    {
+        record[2 + i] = value[i];
+    }
+
+    record[size - 1] = CCRC::CRC8(record, size - 1);
+
+    // Overwrite the older record only; the newest stays valid until the CRC lands
+    return m_rtc.SetSRAM(m_offset + (bucket * GetBucketSize()) + (slot * size), record, size);
+}
+
+
+int8_t CSRAMStore::GetNewest(const uint8_t data[])
+{
+    const uint8_t *a = &data[0];
+    const uint8_t *b = &data[GetRecordSize()];
+    bool valid_a = IsValid(a);
+    bool valid_b = IsValid(b);
+
+    if (valid_a && valid_b)
+    {
+        // Sequence numbers wrap, compare by signed difference
+        return ((int8_t)(b[1] - a[1]) > 0) ? 1 : 0;
+    }
+
+    return valid_a ? 0 : (valid_b ? 1 : -1);
+}
+
+
+bool CSRAMStore::IsValid(const uint8_t record[])
+{
+    uint8_t size = GetRecordSize();
+
+    return (record[0] != KEY_EMPTY) && (CCRC::CRC8(record, size - 1) == record[size - 1]);
+}
+
+
+uint8_t CSRAMStore::GetRecordSize(void)
+{
+    return (m_value_size + RECORD_OVERHEAD);
+}
+
+
+uint8_t CSRAMStore::GetBucketSize(void)
+{
+    return (2 * GetRecordSize());
+}
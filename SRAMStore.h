@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        SRAMStore.h
+ * @summary     Crash safe key-value store in RTC battery backed SRAM
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#ifndef _SRAM_STORE_H_
+#define _SRAM_STORE_H_
+
+#include "nRTC.h"
+
+// Each key owns a bucket of two records [key][sequence][value][crc8].
+// Updates overwrite the older record, so an interrupted write leaves the
+// previous value intact and a lookup is usually a single bucket read.
+class CSRAMStore
+{
+    public:
+    enum config_t : uint8_t
+    {
+        MAX_VALUE_SIZE  = 8,
+        RECORD_OVERHEAD = 3,    // key, sequence and crc
+    };
+
+    enum key_t : uint8_t
+    {
+        KEY_EMPTY       = 0x00, // Never valid, erased SRAM reads as empty
+        KEY_REMOVED     = 0xFF, // Tombstone, keeps probe chains intact
+    };
+
+    protected:
+    enum bucket_t : uint8_t
+    {
+        BUCKET_NONE     = 0xFF,
+    };
+
+    CRTC &m_rtc;
+    uint8_t m_offset;
+    uint8_t m_value_size;
+    uint8_t m_buckets;
+
+    public:
+    // Store occupying SRAM [offset, offset + bytes) with fixed size values
+    CSRAMStore(CRTC &rtc, const uint8_t offset, const uint8_t bytes, const uint8_t value_size);
+
+    // Keys 0x01-0xFE, STATUS_INVALID otherwise; STATUS_ERROR when the key is absent
+    CRTC::status_t Get(const uint8_t key, uint8_t value[]);
+
+    // STATUS_ERROR when the store is full
+    CRTC::status_t Set(const uint8_t key, const uint8_t value[]);
+    CRTC::status_t Remove(const uint8_t key);
+
+    // Erase all records
+    CRTC::status_t Format(void);
+
+    uint8_t GetCapacity(void);
+
+    protected:
+    CRTC::status_t Find(const uint8_t key, uint8_t &bucket, uint8_t data[]);
+    CRTC::status_t Commit(const uint8_t bucket, const uint8_t data[], const uint8_t key, const uint8_t value[]);
+    int8_t GetNewest(const uint8_t data[]);
+    bool IsValid(const uint8_t record[]);
+    uint8_t GetRecordSize(void);
+    uint8_t GetBucketSize(void);
+};
+
+#endif
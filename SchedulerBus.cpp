@@ -0,0 +1,497 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        SchedulerBus.cpp
+ * @summary     Priority scheduling of transfers on a shared RTC bus
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#include "SchedulerBus.h"
+#include "RTCPlatform.h"
+
+static uint32_t DefaultTick(void)
+{
+    return micros();
+}
+
+
+CSchedulerBus::CSchedulerBus(CRTCBus &bus)
+    : CSchedulerBus(bus, DefaultTick)
+{
+    // empty
+}
+
+
+CSchedulerBus::CSchedulerBus(CRTCBus &bus, tick_t tick)
+    : m_bus(bus)
+    , m_tick{tick}
+    , m_head{nullptr}
+    , m_tail{nullptr}
+    , m_count{0}
+    , m_chunk{DEFAULT_CHUNK}
+{
+    // empty
+}
+
+
+bool CSchedulerBus::SetPriority(const uint8_t address, const Priority priority, const uint32_t deadline)
+{
+    bool found = false;
+
+    for (uint8_t i = 0; i < m_count; i++)
+    {
+        if (m_address[i] == address)
+        {
+            m_priority[i] = priority;
+            m_deadline[i] = deadline;
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+
+void CSchedulerBus::SetChunkSize(const uint8_t bytes)
+{
+    m_chunk = (bytes < MIN_CHUNK) ? (uint8_t)MIN_CHUNK : bytes;
+}
+
+
+CRTCBus::handle_t CSchedulerBus::RegisterDevice(const uint8_t address, const Speed speed)
+{
+    // Drivers register on every Initialize; keep the entry and its priority
+    for (uint8_t i = 0; i < m_count; i++)
+    {
+        if (m_address[i] == address)
+        {
+            return i;
+        }
+    }
+
+    if (m_count >= MAX_DEVICES)
+    {
+        return HANDLE_INVALID;
+    }
+
+    m_address[m_count] = address;
+    m_handle[m_count] = m_bus.RegisterDevice(address, speed);
+    m_priority[m_count] = Priority::NORMAL;
+    m_deadline[m_count] = 0;
+    return m_count++;
+}
+
+
+uint8_t CSchedulerBus::Write(const handle_t handle, const uint8_t reg, const uint8_t data[], const uint8_t bytes)
+{
+    Request request;
+
+    request.handle = handle;
+    request.reg = reg;
+    request.read = false;
+    request.data = const_cast<uint8_t*>(data);
+    request.bytes = bytes;
+
+    if (handle < m_count)
+    {
+        request.priority = m_priority[handle];
+        request.deadline = m_deadline[handle];
+    }
+
+    return Run(request);
+}
+
+
+uint8_t CSchedulerBus::Read(const handle_t handle, const uint8_t reg, uint8_t data[], const uint8_t bytes)
+{
+    Request request;
+
+    request.handle = handle;
+    request.reg = reg;
+    request.read = true;
+    request.data = data;
+    request.bytes = bytes;
+
+    if (handle < m_count)
+    {
+        request.priority = m_priority[handle];
+        request.deadline = m_deadline[handle];
+    }
+
+    return Run(request);
+}
+
+
+bool CSchedulerBus::Submit(Request &request)
+{
+    if ((request.handle >= m_count) || request.pending)
+    {
+        return false;
+    }
+
+    request.result = 0;
+    request.m_done = 0;
+    request.m_next = nullptr;
+    request.m_submitted = m_tick();
+    request.pending = true;
+
+#if defined(ARDUINO)
+    uint8_t sreg = SREG;
+
+    cli();
+#endif
+    if (m_tail != nullptr)
+    {
+        m_tail->m_next = &request;
+    }
+    else
+    {
+        m_head = &request;
+    }
+
+    m_tail = &request;
+#if defined(ARDUINO)
+    SREG = sreg;
+#endif
+
+    return true;
+}
+
+
+bool CSchedulerBus::Service(void)
+{
+    Request *group[MAX_MERGE];
+    uint8_t members = 0;
+    uint8_t start = 0;
+    uint8_t length = 0;
+
+#if defined(ARDUINO)
+    uint8_t sreg = SREG;
+
+    cli();
+#endif
+    group[0] = Select();
+
+    if (group[0] != nullptr)
+    {
+        members = Gather(group, start, length);
+    }
+#if defined(ARDUINO)
+    SREG = sreg;
+#endif
+
+    if (members == 0)
+    {
+        return false;
+    }
+
+    Request &first = *group[0];
+    handle_t handle = m_handle[first.handle];
+    uint32_t now = m_tick();
+    uint8_t result;
+    bool finished = true;
+
+    for (uint8_t i = 0; i < members; i++)
+    {
+        if (group[i]->m_done == 0)
+        {
+            Stats &stats = m_stats[(uint8_t)group[i]->priority];
+            uint32_t delay = (now - group[i]->m_submitted);
+
+            stats.delay += delay;
+
+            if (delay > stats.max_delay)
+            {
+                stats.max_delay = delay;
+            }
+
+            if (i > 0)
+            {
+                stats.merged++;
+            }
+        }
+    }
+
+    m_stats[(uint8_t)first.priority].transfers++;
+
+    if (members == 1)
+    {
+        uint8_t bytes = (first.bytes - first.m_done);
+
+        // Preemption point: the rest is queued again behind any new arrival
+        if (bytes > m_chunk)
+        {
+            bytes = m_chunk;
+        }
+
+        result = first.read ? m_bus.Read(handle, first.reg + first.m_done, &first.data[first.m_done], bytes)
+                            : m_bus.Write(handle, first.reg + first.m_done, &first.data[first.m_done], bytes);
+
+        first.m_done += bytes;
+        finished = (result != 0) || (first.m_done >= first.bytes);
+    }
+    else if (first.read)
+    {
+        result = m_bus.Read(handle, start, m_buffer, length);
+
+        for (uint8_t i = 0; (result == 0) && (i < members); i++)
+        {
+            for (uint8_t j = 0; j < group[i]->bytes; j++)
+            {
+                group[i]->data[j] = m_buffer[(uint8_t)(group[i]->reg - start) + j];
+            }
+        }
+    }
+    else
+    {
+        for (uint8_t i = 0; i < members; i++)
+        {
+            for (uint8_t j = 0; j < group[i]->bytes; j++)
+            {
+                m_buffer[(uint8_t)(group[i]->reg - start) + j] = group[i]->data[j];
+            }
+        }
+
+        result = m_bus.Write(handle, start, m_buffer, length);
+    }
+
+    if (!finished)
+    {
+        return true;
+    }
+
+    now = m_tick();
+
+    for (uint8_t i = 0; i < members; i++)
+    {
+        Request &request = *group[i];
+        Stats &stats = m_stats[(uint8_t)request.priority];
+
+        Unlink(request);
+
+        stats.requests++;
+
+        if (request.deadline && ((now - request.m_submitted) > request.deadline))
+        {
+            stats.misses++;
+        }
+
+        request.result = result;
+        request.pending = false;
+
+        // May queue the request again
+        if (request.complete != nullptr)
+        {
+            request.complete(request);
+        }
+    }
+
+    return true;
+}
+
+
+void CSchedulerBus::Flush(void)
+{
+    while (Service())
+    {
+        // empty
+    }
+}
+
+
+bool CSchedulerBus::IsIdle(void)
+{
+    return (m_head == nullptr);
+}
+
+
+void CSchedulerBus::GetStats(const Priority priority, Stats &stats)
+{
+    stats = m_stats[(uint8_t)priority];
+}
+
+
+void CSchedulerBus::ResetStats(void)
+{
+    for (uint8_t i = 0; i < CLASSES; i++)
+    {
+        m_stats[i] = Stats();
+    }
+}
+
+
+/// Protected Functions ---------------------------------------
+
+uint8_t CSchedulerBus::Run(Request &request)
+{
+    if (!Submit(request))
+    {
+        return 0xFF;
+    }
+
+    // Higher priority transfers queued meanwhile go first
+    while (request.pending)
+    {
+        Service();
+    }
+
+    // Service already unlinked it; repeated so that no queue pointer can
+    // be seen to outlive the caller's stack frame
+    Unlink(request);
+
+    return request.result;
+}
+
+
+CSchedulerBus::Request* CSchedulerBus::Select(void)
+{
+    Request *best = nullptr;
+    uint8_t seen = 0;
+
+    // Only the oldest queued request of each device is eligible
+    for (Request *request = m_head; request != nullptr; request = request->m_next)
+    {
+        uint8_t bit = (1 << request->handle);
+
+        if (seen & bit)
+        {
+            continue;
+        }
+
+        seen |= bit;
+
+        if ((best == nullptr) || IsBefore(*request, *best))
+        {
+            best = request;
+        }
+    }
+
+    return best;
+}
+
+
+uint8_t CSchedulerBus::Gather(Request *group[], uint8_t &start, uint8_t &length)
+{
+    Request &first = *group[0];
+    uint8_t limit = (m_chunk < MAX_BURST) ? m_chunk : (uint8_t)MAX_BURST;
+    uint8_t members = 1;
+
+    start = first.reg;
+    length = first.bytes;
+
+    if ((first.m_done != 0) || (first.bytes > limit))
+    {
+        return members;
+    }
+
+    // Later requests of the same device extend the burst while they stay
+    // contiguous; the first one that does not ends the merge so the
+    // device still sees its transfers in submission order
+    for (Request *request = first.m_next; (request != nullptr) && (members < MAX_MERGE); request = request->m_next)
+    {
+        if (request->handle != first.handle)
+        {
+            continue;
+        }
+
+        if ((request->read != first.read) || ((length + request->bytes) > limit))
+        {
+            break;
+        }
+
+        if ((request->reg == (uint16_t)(start + length)) && ((start + length + request->bytes) <= 0x100))
+        {
+            length += request->bytes;
+        }
+        else if ((request->reg + request->bytes) == start)
+        {
+            start = request->reg;
+            length += request->bytes;
+        }
+        else
+        {
+            break;
+        }
+
+        group[members++] = request;
+    }
+
+    return members;
+}
+
+
+void CSchedulerBus::Unlink(Request &request)
+{
+    Request *previous = nullptr;
+
+#if defined(ARDUINO)
+    uint8_t sreg = SREG;
+
+    cli();
+#endif
+    for (Request *node = m_head; node != nullptr; node = node->m_next)
+    {
+        if (node == &request)
+        {
+            if (previous != nullptr)
+            {
+                previous->m_next = node->m_next;
+            }
+            else
+            {
+                m_head = node->m_next;
+            }
+
+            if (m_tail == node)
+            {
+                m_tail = previous;
+            }
+
+            break;
+        }
+
+        previous = node;
+    }
+#if defined(ARDUINO)
+    SREG = sreg;
+#endif
+
+    request.m_next = nullptr;
+}
+
+
+bool CSchedulerBus::IsBefore(const Request &a, const Request &b)
+{
+    if (a.priority != b.priority)
+    {
+        return (a.priority < b.priority);
+    }
+
+    if (a.deadline && b.deadline)
+    {
+        // Earliest absolute deadline, wrap safe
+        return ((int32_t)((a.m_submitted + a.deadline) - (b.m_submitted + b.deadline)) < 0);
+    }
+
+    // A deadline goes before none; otherwise keep submission order
+    return (a.deadline != 0) && (b.deadline == 0);
+}
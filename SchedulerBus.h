@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        SchedulerBus.h
+ * @summary     Priority scheduling of transfers on a shared RTC bus
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#ifndef _SCHEDULER_BUS_H_
+#define _SCHEDULER_BUS_H_
+
+#include "RTCBus.h"
+
+// Shares one bus between the RTC and co-resident devices. Transfers are
+// queued with a priority class and an optional deadline and issued one
+// unit at a time: the highest class first, then the earliest deadline,
+// then submission order. Transfers longer than the chunk size are split,
+// so a queued higher priority transfer runs between two chunks of a long
+// SRAM burst. Queued transfers to consecutive registers of a device are
+// merged into one burst. Each device is served in submission order, so
+// nothing is reordered against another transfer to the same device.
+//
+// Synchronous Read/Write (the CRTC helpers) queue a transfer with the
+// class set for the handle and service the queue until it completes.
+// Submit queues without blocking and may be called from an interrupt.
+class CSchedulerBus : public CRTCBus
+{
+    public:
+    // Microsecond tick source, e.g. micros()
+    typedef uint32_t (*tick_t)(void);
+
+    enum class Priority : uint8_t
+    {
+        HIGH,
+        NORMAL,
+        LOW,
+    };
+
+    struct Request;
+
+    // Called from Service once the request has completed
+    typedef void (*complete_t)(Request &request);
+
+    struct Request
+    {
+        Request()
+            : handle{HANDLE_INVALID}
+            , reg{0}
+            , read{true}
+            , data{nullptr}
+            , bytes{0}
+            , priority{Priority::NORMAL}
+            , deadline{0}
+            , complete{nullptr}
+            , context{nullptr}
+            , result{0}
+            , pending{false}
+            , m_done{0}
+            , m_submitted{0}
+            , m_next{nullptr}
+        {
+            // empty
+        }
+
+        handle_t handle;
+        uint8_t reg;
+        bool read;
+        uint8_t *data;
+        uint8_t bytes;
+        Priority priority;
+        uint32_t deadline;      // Microseconds after submission, 0 for none
+        complete_t complete;
+        void *context;
+
+        uint8_t result;         // Bus result once complete
+        volatile bool pending;
+
+        uint8_t m_done;         // Bytes transferred so far
+        uint32_t m_submitted;
+        Request *m_next;
+    };
+
+    // Per priority class, since the last ResetStats
+    struct Stats
+    {
+        Stats()
+            : requests{0}
+            , transfers{0}
+            , merged{0}
+            , delay{0}
+            , max_delay{0}
+            , misses{0}
+        {
+            // empty
+        }
+
+        uint32_t requests;      // Completed requests
+        uint32_t transfers;     // Bus transfers started for this class
+        uint32_t merged;        // Requests folded into another's burst
+        uint32_t delay;         // Sum of queueing delays (us)
+        uint32_t max_delay;     // Submission to first transfer (us)
+        uint32_t misses;        // Completed after their deadline
+    };
+
+    enum config_t : uint8_t
+    {
+        CLASSES         = 3,
+        MAX_DEVICES     = 4,
+        MAX_BURST       = 32,   // Merge buffer, the AVR TWI buffer size
+        MAX_MERGE       = 4,    // Requests per merged burst
+        MIN_CHUNK       = 8,    // Keeps a time block in one transfer
+        DEFAULT_CHUNK   = 16,
+    };
+
+    protected:
+    CRTCBus &m_bus;
+    tick_t m_tick;
+    Request *m_head;
+    Request *m_tail;
+    uint8_t m_address[MAX_DEVICES];
+    handle_t m_handle[MAX_DEVICES];
+    Priority m_priority[MAX_DEVICES];
+    uint32_t m_deadline[MAX_DEVICES];
+    uint8_t m_count;
+    uint8_t m_chunk;
+    uint8_t m_buffer[MAX_BURST];
+    Stats m_stats[CLASSES];
+
+    public:
+    CSchedulerBus(CRTCBus &bus);
+    CSchedulerBus(CRTCBus &bus, tick_t tick);
+
+    // Class and deadline (us, 0 for none) of synchronous transfers to a
+    // registered device, false when no device has the address
+    bool SetPriority(const uint8_t address, const Priority priority, const uint32_t deadline);
+
+    // Longest single transfer, at least MIN_CHUNK
+    void SetChunkSize(const uint8_t bytes);
+
+    handle_t RegisterDevice(const uint8_t address, const Speed speed);
+    uint8_t Write(const handle_t handle, const uint8_t reg, const uint8_t data[], const uint8_t bytes);
+    uint8_t Read(const handle_t handle, const uint8_t reg, uint8_t data[], const uint8_t bytes);
+
+    // Queue without blocking, false for a bad handle or a request already queued
+    bool Submit(Request &request);
+
+    // Issue one transfer, false when the queue is empty
+    bool Service(void);
+    void Flush(void);
+    bool IsIdle(void);
+
+    void GetStats(const Priority priority, Stats &stats);
+    void ResetStats(void);
+
+    protected:
+    // Queue a synchronous transfer and service until it completes
+    uint8_t Run(Request &request);
+    Request* Select(void);
+    uint8_t Gather(Request *group[], uint8_t &start, uint8_t &length);
+    void Unlink(Request &request);
+    bool IsBefore(const Request &a, const Request &b);
+};
+
+#endif
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        SimBus.cpp
+ * @summary     In-process simulated bus and devices
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#include "SimBus.h"
+
+CSimDevice::CSimDevice(const uint8_t address)
+    : m_address{address}
+{
+    // empty
+}
+
+
+uint8_t CSimDevice::GetAddress(void)
+{
+    return m_address;
+}
+
+
+CSimRegisterDevice::CSimRegisterDevice(const uint8_t address, uint8_t registers[], const uint16_t size)
+    : CSimDevice(address)
+    , m_register{registers}
+    , m_size{size}
+{
+    // empty
+}
+
+
+uint8_t CSimRegisterDevice::Write(const uint8_t reg, const uint8_t data[], const uint8_t bytes)
+{
+    for (uint8_t i = 0; i < bytes; i++)
+    {
+        m_register[(reg + i) % m_size] = data[i];
+    }
+
+    return 0;
+}
+
+
+uint8_t CSimRegisterDevice::Read(const uint8_t reg, uint8_t data[], const uint8_t bytes)
+{
+    for (uint8_t i = 0; i < bytes; i++)
+    {
+        data[i] = m_register[(reg + i) % m_size];
+    }
+
+    return 0;
+}
+
+
+uint8_t* CSimRegisterDevice::GetRegisters(void)
+{
+    return m_register;
+}
+
+
+CSimBus::CSimBus(void)
+    : m_devices{0}
+    , m_count{0}
+    , m_transfers{0}
+    , m_bytes{0}
+    , m_bus_time{0}
+    , m_fail{0xFFFFFFFF}
+{
+    // empty
+}
+
+
+bool CSimBus::Attach(CSimDevice &device)
+{
+    if (m_devices >= MAX_DEVICES)
+    {
+        return false;
+    }
+
+    m_device[m_devices++] = &device;
+    return true;
+}
+
+
+CRTCBus::handle_t CSimBus::RegisterDevice(const uint8_t address, const Speed speed)
+{
+    // Drivers register on every Initialize; reuse the handle as CNI2CBus does
+    for (uint8_t i = 0; i < m_count; i++)
+    {
+        if ((m_address[i] == address) && (m_speed[i] == speed))
+        {
+            return i;
+        }
+    }
+
+    if (m_count >= MAX_DEVICES)
+    {
+        return HANDLE_INVALID;
+    }
+
+    m_address[m_count] = address;
+    m_speed[m_count] = speed;
+    return m_count++;
+}
+
+
+uint8_t CSimBus::Write(const handle_t handle, const uint8_t reg, const uint8_t data[], const uint8_t bytes)
+{
+    CSimDevice *device = Find(handle);
+
+    if (device == nullptr)
+    {
+        return 2; // Address NACK
+    }
+
+    Account(handle, false, bytes);
+
+    if (Fail())
+    {
+        return 4;
+    }
+
+    return device->Write(reg, data, bytes);
+}
+
+
+uint8_t CSimBus::Read(const handle_t handle, const uint8_t reg, uint8_t data[], const uint8_t bytes)
+{
+    CSimDevice *device = Find(handle);
+
+    if (device == nullptr)
+    {
+        return 2; // Address NACK
+    }
+
+    Account(handle, true, bytes);
+
+    if (Fail())
+    {
+        return 4;
+    }
+
+    return device->Read(reg, data, bytes);
+}
+
+
+void CSimBus::InjectFailure(const uint32_t after)
+{
+    m_fail = after;
+}
+
+
+CRTCBus::Speed CSimBus::GetSpeed(const handle_t handle)
+{
+    return (handle < m_count) ? m_speed[handle] : Speed::SLOW;
+}
+
+
+uint32_t CSimBus::GetTransfers(void)
+{
+    return m_transfers;
+}
+
+
+uint32_t CSimBus::GetBytes(void)
+{
+    return m_bytes;
+}
+
+
+uint32_t CSimBus::GetBusTime(void)
+{
+    return m_bus_time;
+}
+
+
+/// Protected Functions ---------------------------------------
+
+CSimDevice* CSimBus::Find(const handle_t handle)
+{
+    if (handle >= m_count)
+    {
+        return nullptr;
+    }
+
+    for (uint8_t i = 0; i < m_devices; i++)
+    {
+        if (m_device[i]->GetAddress() == m_address[handle])
+        {
+            return m_device[i];
+        }
+    }
+
+    return nullptr;
+}
+
+
+bool CSimBus::Fail(void)
+{
+    if (m_fail == 0xFFFFFFFF)
+    {
+        return false;
+    }
+
+    if (m_fail == 0)
+    {
+        m_fail = 0xFFFFFFFF; // One shot
+        return true;
+    }
+
+    m_fail--;
+    return false;
+}
+
+
+void CSimBus::Account(const handle_t handle, const bool read, const uint8_t bytes)
+{
+    m_transfers++;
+    m_bytes += (read ? 3 : 2) + bytes; // address, register, repeated start address
+    m_bus_time += GetTransferTime(read, bytes, m_speed[handle]);
+}
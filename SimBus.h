@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        SimBus.h
+ * @summary     In-process simulated bus and devices
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#ifndef _SIM_BUS_H_
+#define _SIM_BUS_H_
+
+#include "RTCBus.h"
+
+// Device behind a simulated bus; return non-zero to NACK a transfer
+class CSimDevice
+{
+    protected:
+    uint8_t m_address;
+
+    public:
+    CSimDevice(const uint8_t address);
+
+    uint8_t GetAddress(void);
+
+    virtual uint8_t Write(const uint8_t reg, const uint8_t data[], const uint8_t bytes) = 0;
+    virtual uint8_t Read(const uint8_t reg, uint8_t data[], const uint8_t bytes) = 0;
+};
+
+
+// Plain auto-incrementing register file wrapping at the given size
+class CSimRegisterDevice : public CSimDevice
+{
+    protected:
+    uint8_t *m_register;
+    uint16_t m_size;
+
+    public:
+    CSimRegisterDevice(const uint8_t address, uint8_t registers[], const uint16_t size);
+
+    uint8_t Write(const uint8_t reg, const uint8_t data[], const uint8_t bytes);
+    uint8_t Read(const uint8_t reg, uint8_t data[], const uint8_t bytes);
+
+    uint8_t* GetRegisters(void);
+};
+
+
+class CSimBus : public CRTCBus
+{
+    protected:
+    enum config_t : uint8_t
+    {
+        MAX_DEVICES = 4,
+    };
+
+    CSimDevice *m_device[MAX_DEVICES];
+    uint8_t m_address[MAX_DEVICES];
+    Speed m_speed[MAX_DEVICES];
+    uint8_t m_devices;
+    uint8_t m_count;
+    uint32_t m_transfers;
+    uint32_t m_bytes;
+    uint32_t m_bus_time;
+    uint32_t m_fail;    // Transfers left before an injected failure
+
+    public:
+    CSimBus(void);
+
+    // Connect a device, false when the bus is full
+    bool Attach(CSimDevice &device);
+
+    handle_t RegisterDevice(const uint8_t address, const Speed speed);
+    uint8_t Write(const handle_t handle, const uint8_t reg, const uint8_t data[], const uint8_t bytes);
+    uint8_t Read(const handle_t handle, const uint8_t reg, uint8_t data[], const uint8_t bytes);
+
+    // Fail the transfer after the given number of successful ones
+    void InjectFailure(const uint32_t after);
+
+    Speed GetSpeed(const handle_t handle);
+    uint32_t GetTransfers(void);
+    uint32_t GetBytes(void);    // Payload plus register address bytes
+    uint32_t GetBusTime(void);  // Microseconds at the registered speeds
+
+    protected:
+    CSimDevice* Find(const handle_t handle);
+    bool Fail(void);
+    void Account(const handle_t handle, const bool read, const uint8_t bytes);
+};
+
+#endif
@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        SimDS323x.cpp
+ * @summary     Simulated DS3231/DS3232 running from a virtual clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#include "SimDS323x.h"
+#include "nRTC.h"
+
+CSimDS323x::CSimDS323x(CVirtualClock &clock)
+    : CSimDevice(ADDRESS_I2C)
+    , m_clock(clock)
+    , m_base_us{clock.Now()}
+    , m_base_epoch{0}
+    , m_base_week_day{1}
+    , m_base_century{false}
+    , m_next_alarm{CVirtualClock::NO_EVENT}
+    , m_next_edge{CVirtualClock::NO_EVENT}
+    , m_interrupt{nullptr}
+    , m_square_wave{nullptr}
+{
+    for (uint16_t i = 0; i < sizeof(m_register); i++)
+    {
+        m_register[i] = 0;
+    }
+
+    // Power-on state: INTCN set, 8 kHz rate bits, OSF and EN32kHz set, 25C
+    m_register[ADDRESS_CTRL] = 0x1C;
+    m_register[ADDRESS_STATUS] = 0x88;
+    m_register[ADDRESS_TEMPERATURE] = 0x19;
+    m_register[ADDRESS_DAY] = 0x01;
+    m_register[ADDRESS_DAY + 1] = 0x01;
+    m_register[ADDRESS_MONTH] = 0x01;
+
+    ScheduleAlarm();
+}
+
+
+uint8_t CSimDS323x::Write(const uint8_t reg, const uint8_t data[], const uint8_t bytes)
+{
+    bool time = false;
+    bool seconds = false;
+    bool schedule = false;
+
+    Sync();
+
+    for (uint8_t i = 0; i < bytes; i++)
+    {
+        uint8_t address = (reg + i);
+
+        if (address == ADDRESS_STATUS)
+        {
+            uint8_t b = m_register[address];
+
+            // Flags can only be cleared, BSY is read only
+            m_register[address] = (data[i] & ~(BITMASK_CLEAR_ONLY | BITMASK_READ_ONLY))
+                | (b & data[i] & BITMASK_CLEAR_ONLY);
+            continue;
+        }
+
+        if ((address == ADDRESS_TEMPERATURE) || (address == (ADDRESS_TEMPERATURE + 1)))
+        {
+            continue;
+        }
+
+        m_register[address] = data[i];
+
+        time |= (address <= ADDRESS_TIME + 6);
+        seconds |= (address == ADDRESS_TIME);
+        schedule |= ((address <= ADDRESS_ALARM_END) || (address == ADDRESS_CTRL));
+    }
+
+    if (time)
+    {
+        Latch(seconds);
+    }
+
+    if (schedule)
+    {
+        ScheduleAlarm();
+        ScheduleEdge();
+    }
+
+    return 0;
+}
+
+
+uint8_t CSimDS323x::Read(const uint8_t reg, uint8_t data[], const uint8_t bytes)
+{
+    Sync();
+
+    for (uint8_t i = 0; i < bytes; i++)
+    {
+        data[i] = m_register[(uint8_t)(reg + i)];
+    }
+
+    return 0;
+}
+
+
+uint64_t CSimDS323x::GetNextEvent(void)
+{
+    return (m_next_alarm < m_next_edge) ? m_next_alarm : m_next_edge;
+}
+
+
+void CSimDS323x::OnEvent(const uint64_t now)
+{
+    if (now >= m_next_alarm)
+    {
+        bool raised = !(m_register[ADDRESS_STATUS] & BITMASK_ALARM_FLAG);
+
+        m_register[ADDRESS_STATUS] |= BITMASK_ALARM_FLAG;
+
+        // INT only falls when the flag is newly set and routed to the pin
+        if (raised && m_interrupt
+            && ((m_register[ADDRESS_CTRL] & (BITMASK_INTCN | BITMASK_ALARM_IE)) == (BITMASK_INTCN | BITMASK_ALARM_IE)))
+        {
+            m_interrupt(now);
+        }
+
+        ScheduleAlarm();
+    }
+
+    if (now >= m_next_edge)
+    {
+        if (m_square_wave)
+        {
+            m_square_wave(now);
+        }
+
+        m_next_edge += 1000000;
+    }
+}
+
+
+void CSimDS323x::OnJump(const uint64_t now)
+{
+    (void)now;
+
+    // Events in the skipped interval are dropped
+    ScheduleAlarm();
+    ScheduleEdge();
+}
+
+
+void CSimDS323x::SetInterruptCallback(const callback_t callback)
+{
+    m_interrupt = callback;
+}
+
+
+void CSimDS323x::SetSquareWaveCallback(const callback_t callback)
+{
+    m_square_wave = callback;
+}
+
+
+uint32_t CSimDS323x::GetEpoch(void)
+{
+    return (uint32_t)(GetSeconds(m_clock.Now()) % CENTURY_SECONDS);
+}
+
+
+bool CSimDS323x::GetCentury(void)
+{
+    return m_base_century ^ !!((GetSeconds(m_clock.Now()) / CENTURY_SECONDS) & 1);
+}
+
+
+/// Protected Functions ---------------------------------------
+
+uint64_t CSimDS323x::GetSeconds(const uint64_t now)
+{
+    return m_base_epoch + ((now > m_base_us) ? ((now - m_base_us) / 1000000) : 0);
+}
+
+
+uint64_t CSimDS323x::GetSecondStart(const uint64_t seconds)
+{
+    return m_base_us + ((seconds - m_base_epoch) * 1000000);
+}
+
+
+uint8_t CSimDS323x::GetWeekDay(const uint64_t seconds)
+{
+    // Day register counts midnights independently of the date
+    uint32_t days = (uint32_t)((seconds / 86400) - (m_base_epoch / 86400));
+
+    return 1 + (((m_base_week_day - 1) + days) % 7);
+}
+
+
+void CSimDS323x::Sync(void)
+{
+    uint64_t seconds = GetSeconds(m_clock.Now());
+    CRTC::Timestamp time((uint32_t)(seconds % CENTURY_SECONDS));
+    bool century = m_base_century ^ !!((seconds / CENTURY_SECONDS) & 1);
+
+    // Always reported in 24 hour mode
+    m_register[ADDRESS_TIME + 0] = DEC_to_BCD(time.Second());
+    m_register[ADDRESS_TIME + 1] = DEC_to_BCD(time.Minute());
+    m_register[ADDRESS_TIME + 2] = DEC_to_BCD(time.Hour());
+    m_register[ADDRESS_TIME + 3] = GetWeekDay(seconds);
+    m_register[ADDRESS_TIME + 4] = DEC_to_BCD(time.Day());
+    m_register[ADDRESS_TIME + 5] = DEC_to_BCD(time.Month()) | (century ? BITMASK_CENTURY : 0);
+    m_register[ADDRESS_TIME + 6] = DEC_to_BCD(time.Year());
+}
+
+
+void CSimDS323x::Latch(const bool reset_countdown)
+{
+    uint64_t now = m_clock.Now();
+    uint8_t month = BCD_to_DEC(m_register[ADDRESS_TIME + 5] & 0x1F);
+    uint8_t day = BCD_to_DEC(m_register[ADDRESS_TIME + 4] & 0x3F);
+
+    // Writing seconds restarts the countdown chain, other fields keep phase
+    m_base_us = reset_countdown ? now : (now - ((now - m_base_us) % 1000000));
+    m_base_epoch = CRTC::Timestamp(BCD_to_DEC(m_register[ADDRESS_TIME + 6]),
+        ((month < 1) || (month > 12)) ? 1 : month, (day < 1) ? 1 : day,
+        DecodeHour(m_register[ADDRESS_TIME + 2]),
+        BCD_to_DEC(m_register[ADDRESS_TIME + 1] & 0x7F),
+        BCD_to_DEC(m_register[ADDRESS_TIME + 0] & 0x7F)).epoch;
+    m_base_week_day = (m_register[ADDRESS_TIME + 3] & 0x07);
+    m_base_century = !!(m_register[ADDRESS_TIME + 5] & BITMASK_CENTURY);
+
+    if (m_base_week_day == 0)
+    {
+        m_base_week_day = 7;
+    }
+}
+
+
+void CSimDS323x::ScheduleAlarm(void)
+{
+    const uint8_t *alarm = &m_register[ADDRESS_ALARM];
+    uint64_t current = GetSeconds(m_clock.Now());
+    uint64_t next = current + 1;
+    uint32_t second = BCD_to_DEC(alarm[0] & 0x7F);
+    uint32_t minute = BCD_to_DEC(alarm[1] & 0x7F);
+    uint32_t hour = DecodeHour(alarm[2] & 0x7F);
+
+    if (alarm[0] & BITMASK_ALARM_MASK)
+    {
+        // Once per second
+    }
+    else if (alarm[1] & BITMASK_ALARM_MASK)
+    {
+        next += (second + 60 - (next % 60)) % 60;
+    }
+    else if (alarm[2] & BITMASK_ALARM_MASK)
+    {
+        uint32_t offset = (60 * minute) + second;
+        next += (offset + 3600 - (next % 3600)) % 3600;
+    }
+    else
+    {
+        uint32_t offset = (3600 * hour) + (60 * minute) + second;
+        uint64_t day = (next / 86400);
+        bool found = false;
+
+        // Daily, or on a date / week day within the next few months
+        for (uint16_t i = 0; (i < 400) && !found; i++, day++)
+        {
+            uint64_t t = (86400 * day) + offset;
+
+            if (t < next)
+            {
+                continue;
+            }
+
+            if (alarm[3] & BITMASK_ALARM_MASK)
+            {
+                found = true;
+            }
+            else if (alarm[3] & BITMASK_DAY_DATE)
+            {
+                found = ((alarm[3] & 0x0F) == GetWeekDay(t));
+            }
+            else
+            {
+                found = (BCD_to_DEC(alarm[3] & 0x3F) == CRTC::Timestamp((uint32_t)(t % CENTURY_SECONDS)).Day());
+            }
+
+            if (found)
+            {
+                next = t;
+            }
+        }
+
+        if (!found)
+        {
+            m_next_alarm = CVirtualClock::NO_EVENT;
+            return;
+        }
+    }
+
+    m_next_alarm = GetSecondStart(next);
+}
+
+
+void CSimDS323x::ScheduleEdge(void)
+{
+    // Only the 1 Hz square wave is modelled as discrete events
+    if ((m_register[ADDRESS_CTRL] & (BITMASK_INTCN | BITMASK_RATE)) == 0)
+    {
+        m_next_edge = GetSecondStart(GetSeconds(m_clock.Now()) + 1);
+    }
+    else
+    {
+        m_next_edge = CVirtualClock::NO_EVENT;
+    }
+}
+
+
+uint8_t CSimDS323x::BCD_to_DEC(const uint8_t b)
+{
+    return ((b >> 4) * 10) + (b & 0x0F);
+}
+
+
+uint8_t CSimDS323x::DEC_to_BCD(const uint8_t d)
+{
+    return ((d / 10) << 4) | (d % 10);
+}
+
+
+uint8_t CSimDS323x::DecodeHour(const uint8_t b)
+{
+    if (b & BITMASK_12_HOUR)
+    {
+        uint8_t hour = BCD_to_DEC(b & 0x1F) % 12;
+        return (b & BITMASK_PM) ? (hour + 12) : hour;
+    }
+
+    return BCD_to_DEC(b & 0x3F);
+}
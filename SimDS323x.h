@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        SimDS323x.h
+ * @summary     Simulated DS3231/DS3232 running from a virtual clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#ifndef _SIM_DS323X_H_
+#define _SIM_DS323X_H_
+
+#include "SimBus.h"
+#include "VirtualClock.h"
+
+// Register level DS3231/DS3232 model. Time is derived from the virtual
+// clock on every access rather than ticked, so years of simulated time
+// cost only the alarm and square wave events that actually occur.
+// Supports alarm 1 (all mask modes), the INT/SQW pin at 1 Hz, status
+// flags, the century bit and the 2099 to 2000 wrap, and DS3232 SRAM.
+class CSimDS323x : public CSimDevice, public CVirtualClock::Listener
+{
+    public:
+    // Pin event at the given virtual time (us)
+    typedef void (*callback_t)(const uint64_t time);
+
+    protected:
+    enum address_t : uint8_t
+    {
+        ADDRESS_I2C         = 0x68,
+        ADDRESS_TIME        = 0x00,
+        ADDRESS_DAY         = 0x03,
+        ADDRESS_MONTH       = 0x05,
+        ADDRESS_ALARM       = 0x07,
+        ADDRESS_ALARM_END   = 0x0A,
+        ADDRESS_CTRL        = 0x0E,
+        ADDRESS_STATUS      = 0x0F,
+        ADDRESS_TEMPERATURE = 0x11,
+    };
+
+    enum bitmask_t : uint8_t
+    {
+        BITMASK_CENTURY     = 0x80,
+        BITMASK_ALARM_MASK  = 0x80,
+        BITMASK_DAY_DATE    = 0x40,
+        BITMASK_12_HOUR     = 0x40,
+        BITMASK_PM          = 0x20,
+        BITMASK_ALARM_IE    = 0x01,
+        BITMASK_INTCN       = 0x04,
+        BITMASK_RATE        = 0x18,
+        BITMASK_ALARM_FLAG  = 0x01,
+        BITMASK_CLEAR_ONLY  = 0x83, // OSF, A2F, A1F
+        BITMASK_READ_ONLY   = 0x04, // BSY
+    };
+
+    enum config_t : uint32_t
+    {
+        CENTURY_SECONDS     = 36525UL * 86400UL,
+    };
+
+    CVirtualClock &m_clock;
+    uint8_t m_register[256];
+    uint64_t m_base_us;     // Start of second m_base_epoch
+    uint64_t m_base_epoch;  // Seconds since 2000 at m_base_us, not wrapped
+    uint8_t m_base_week_day;
+    bool m_base_century;
+    uint64_t m_next_alarm;
+    uint64_t m_next_edge;
+    callback_t m_interrupt;
+    callback_t m_square_wave;
+
+    public:
+    CSimDS323x(CVirtualClock &clock);
+
+    uint8_t Write(const uint8_t reg, const uint8_t data[], const uint8_t bytes);
+    uint8_t Read(const uint8_t reg, uint8_t data[], const uint8_t bytes);
+
+    uint64_t GetNextEvent(void);
+    void OnEvent(const uint64_t now);
+    void OnJump(const uint64_t now);
+
+    // INT asserted by alarm 1, and 1 Hz SQW edges
+    void SetInterruptCallback(const callback_t callback);
+    void SetSquareWaveCallback(const callback_t callback);
+
+    // Device time as seconds since 2000-01-01 within the current century
+    uint32_t GetEpoch(void);
+    bool GetCentury(void);
+
+    protected:
+    uint64_t GetSeconds(const uint64_t now);
+    uint64_t GetSecondStart(const uint64_t seconds);
+    uint8_t GetWeekDay(const uint64_t seconds);
+    void Sync(void);
+    void Latch(const bool reset_countdown);
+    void ScheduleAlarm(void);
+    void ScheduleEdge(void);
+    static uint8_t BCD_to_DEC(const uint8_t b);
+    static uint8_t DEC_to_BCD(const uint8_t d);
+    static uint8_t DecodeHour(const uint8_t b);
+};
+
+#endif
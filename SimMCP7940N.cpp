@@ -0,0 +1,476 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        SimMCP7940N.cpp
+ * @summary     Simulated MCP7940N running from a virtual clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#include "SimMCP7940N.h"
+#include "nRTC.h"
+
+CSimMCP7940N::CSimMCP7940N(CVirtualClock &clock)
+    : CSimDevice(ADDRESS_I2C)
+    , m_clock(clock)
+    , m_startup{0}
+    , m_powered{true}
+    , m_interrupt{nullptr}
+{
+    Reset();
+}
+
+
+uint8_t CSimMCP7940N::Write(const uint8_t reg, const uint8_t data[], const uint8_t bytes)
+{
+    bool time = false;
+    bool seconds = false;
+    bool schedule = false;
+
+    if (!m_powered)
+    {
+        return 2; // NACK on address
+    }
+
+    Sync();
+
+    for (uint8_t i = 0; i < bytes; i++)
+    {
+        uint8_t address = (reg + i);
+        uint8_t b = m_register[address];
+        uint8_t d = data[i];
+
+        if (address == ADDRESS_WEEK_DAY)
+        {
+            // OSCRUN is read only, PWRFAIL can only be cleared
+            d = (d & ~(BITMASK_OSCRUN | BITMASK_PWRFAIL)) | (b & BITMASK_OSCRUN) | (b & d & BITMASK_PWRFAIL);
+
+            if ((b & BITMASK_PWRFAIL) && !(d & BITMASK_PWRFAIL))
+            {
+                // Clearing PWRFAIL clears both timestamps
+                for (uint8_t j = ADDRESS_POWER_DOWN; j <= ADDRESS_POWER_END; j++)
+                {
+                    m_register[j] = 0;
+                }
+            }
+        }
+        else if (address == ADDRESS_MONTH)
+        {
+            d = (d & ~(BITMASK_LPYR)) | (b & BITMASK_LPYR);
+        }
+        else if ((address == (ADDRESS_ALARM_0 + ALARM_WEEK_DAY)) || (address == (ADDRESS_ALARM_1 + ALARM_WEEK_DAY)))
+        {
+            d = (d & ~(BITMASK_ALARM_FLAG)) | (b & d & BITMASK_ALARM_FLAG);
+        }
+        else if ((address >= ADDRESS_POWER_DOWN) && (address <= ADDRESS_POWER_END))
+        {
+            continue;
+        }
+
+        m_register[address] = d;
+
+        time |= (address <= ADDRESS_TIME + 6);
+        seconds |= (address == ADDRESS_TIME);
+        schedule |= ((address >= ADDRESS_CONTROL) && (address <= ADDRESS_ALARM_END));
+    }
+
+    if (time)
+    {
+        Latch(seconds);
+        schedule = true;
+    }
+
+    if (schedule)
+    {
+        ScheduleAlarm(0);
+        ScheduleAlarm(1);
+    }
+
+    return 0;
+}
+
+
+uint8_t CSimMCP7940N::Read(const uint8_t reg, uint8_t data[], const uint8_t bytes)
+{
+    if (!m_powered)
+    {
+        return 2; // NACK on address
+    }
+
+    // Start-up completes after the configured number of OSCRUN polls
+    if (!m_running && (m_register[ADDRESS_TIME] & BITMASK_ST)
+        && (reg <= ADDRESS_WEEK_DAY) && (((uint16_t)reg + bytes) > ADDRESS_WEEK_DAY))
+    {
+        if (m_pending > 0)
+        {
+            m_pending--;
+        }
+        else
+        {
+            Start();
+        }
+    }
+
+    Sync();
+
+    for (uint8_t i = 0; i < bytes; i++)
+    {
+        data[i] = m_register[(uint8_t)(reg + i)];
+    }
+
+    return 0;
+}
+
+
+uint64_t CSimMCP7940N::GetNextEvent(void)
+{
+    return (m_next_alarm[0] < m_next_alarm[1]) ? m_next_alarm[0] : m_next_alarm[1];
+}
+
+
+void CSimMCP7940N::OnEvent(const uint64_t now)
+{
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        if (now >= m_next_alarm[i])
+        {
+            uint8_t &flags = m_register[(i ? ADDRESS_ALARM_1 : ADDRESS_ALARM_0) + ALARM_WEEK_DAY];
+            bool raised = !(flags & BITMASK_ALARM_FLAG);
+
+            flags |= BITMASK_ALARM_FLAG;
+
+            // MFP is not driven from the battery
+            if (raised && m_powered && m_interrupt)
+            {
+                m_interrupt(now);
+            }
+
+            ScheduleAlarm(i);
+        }
+    }
+}
+
+
+void CSimMCP7940N::OnJump(const uint64_t now)
+{
+    (void)now;
+
+    // Events in the skipped interval are dropped
+    ScheduleAlarm(0);
+    ScheduleAlarm(1);
+}
+
+
+void CSimMCP7940N::SetInterruptCallback(const callback_t callback)
+{
+    m_interrupt = callback;
+}
+
+
+void CSimMCP7940N::SetStartupPolls(const uint8_t polls)
+{
+    m_startup = polls;
+}
+
+
+void CSimMCP7940N::PowerDown(void)
+{
+    if (!m_powered)
+    {
+        return;
+    }
+
+    m_powered = false;
+
+    if (!(m_register[ADDRESS_WEEK_DAY] & BITMASK_VBATEN))
+    {
+        Reset(); // Nothing survives without battery backup
+        return;
+    }
+
+    // Timestamps are held until PWRFAIL is cleared
+    if (!(m_register[ADDRESS_WEEK_DAY] & BITMASK_PWRFAIL))
+    {
+        Stamp(ADDRESS_POWER_DOWN);
+    }
+}
+
+
+void CSimMCP7940N::PowerUp(void)
+{
+    if (m_powered)
+    {
+        return;
+    }
+
+    m_powered = true;
+
+    if ((m_register[ADDRESS_WEEK_DAY] & (BITMASK_VBATEN | BITMASK_PWRFAIL)) == BITMASK_VBATEN)
+    {
+        Stamp(ADDRESS_POWER_UP);
+        m_register[ADDRESS_WEEK_DAY] |= BITMASK_PWRFAIL;
+    }
+}
+
+
+uint32_t CSimMCP7940N::GetEpoch(void)
+{
+    return (uint32_t)(GetSeconds(m_clock.Now()) % CENTURY_SECONDS);
+}
+
+
+bool CSimMCP7940N::IsRunning(void)
+{
+    return m_running;
+}
+
+
+/// Protected Functions ---------------------------------------
+
+uint64_t CSimMCP7940N::GetSeconds(const uint64_t now)
+{
+    if (!m_running)
+    {
+        return m_base_epoch; // Stopped
+    }
+
+    return m_base_epoch + ((now > m_base_us) ? ((now - m_base_us) / 1000000) : 0);
+}
+
+
+uint64_t CSimMCP7940N::GetSecondStart(const uint64_t seconds)
+{
+    return m_base_us + ((seconds - m_base_epoch) * 1000000);
+}
+
+
+uint8_t CSimMCP7940N::GetWeekDay(const uint64_t seconds)
+{
+    // Week day register counts midnights independently of the date
+    uint32_t days = (uint32_t)((seconds / 86400) - (m_base_epoch / 86400));
+
+    return 1 + (((m_base_week_day - 1) + days) % 7);
+}
+
+
+void CSimMCP7940N::Reset(void)
+{
+    for (uint16_t i = 0; i < sizeof(m_register); i++)
+    {
+        m_register[i] = 0;
+    }
+
+    // Power-on state: oscillator stopped at 2000-01-01, week day 1
+    m_register[ADDRESS_WEEK_DAY] = 0x01;
+    m_register[ADDRESS_WEEK_DAY + 1] = 0x01;
+    m_register[ADDRESS_MONTH] = 0x01 | BITMASK_LPYR;
+
+    m_base_us = m_clock.Now();
+    m_base_epoch = 0;
+    m_base_week_day = 1;
+    m_running = false;
+    m_pending = 0;
+    m_next_alarm[0] = CVirtualClock::NO_EVENT;
+    m_next_alarm[1] = CVirtualClock::NO_EVENT;
+}
+
+
+void CSimMCP7940N::Sync(void)
+{
+    if (!m_running)
+    {
+        m_register[ADDRESS_WEEK_DAY] &= ~(BITMASK_OSCRUN);
+        return; // Registers hold their written values
+    }
+
+    uint64_t seconds = GetSeconds(m_clock.Now());
+    CRTC::Timestamp time((uint32_t)(seconds % CENTURY_SECONDS));
+
+    m_register[ADDRESS_TIME + 0] = DEC_to_BCD(time.Second()) | BITMASK_ST;
+    m_register[ADDRESS_TIME + 1] = DEC_to_BCD(time.Minute());
+    m_register[ADDRESS_TIME + 2] = DEC_to_BCD(time.Hour());
+    m_register[ADDRESS_TIME + 3] = (m_register[ADDRESS_WEEK_DAY] & (BITMASK_PWRFAIL | BITMASK_VBATEN))
+        | BITMASK_OSCRUN | GetWeekDay(seconds);
+    m_register[ADDRESS_TIME + 4] = DEC_to_BCD(time.Day());
+    m_register[ADDRESS_TIME + 5] = DEC_to_BCD(time.Month()) | ((time.Year() % 4) ? 0 : BITMASK_LPYR);
+    m_register[ADDRESS_TIME + 6] = DEC_to_BCD(time.Year());
+}
+
+
+void CSimMCP7940N::Latch(const bool reset_countdown)
+{
+    uint64_t now = m_clock.Now();
+    uint8_t year = BCD_to_DEC(m_register[ADDRESS_TIME + 6]);
+    uint8_t month = BCD_to_DEC(m_register[ADDRESS_TIME + 5] & 0x1F);
+    uint8_t day = BCD_to_DEC(m_register[ADDRESS_TIME + 4] & 0x3F);
+
+    // Writing seconds restarts the countdown chain, other fields keep phase
+    m_base_us = reset_countdown ? now : (now - ((now - m_base_us) % 1000000));
+    m_base_epoch = CRTC::Timestamp(year,
+        ((month < 1) || (month > 12)) ? 1 : month, (day < 1) ? 1 : day,
+        BCD_to_DEC(m_register[ADDRESS_TIME + 2] & 0x3F),
+        BCD_to_DEC(m_register[ADDRESS_TIME + 1] & 0x7F),
+        BCD_to_DEC(m_register[ADDRESS_TIME + 0] & 0x7F)).epoch;
+    m_base_week_day = (m_register[ADDRESS_WEEK_DAY] & 0x07);
+
+    if (m_base_week_day == 0)
+    {
+        m_base_week_day = 7;
+    }
+
+    m_register[ADDRESS_MONTH] = (m_register[ADDRESS_MONTH] & ~(BITMASK_LPYR)) | ((year % 4) ? 0 : BITMASK_LPYR);
+
+    if (!(m_register[ADDRESS_TIME] & BITMASK_ST))
+    {
+        // Clearing ST stops the counters on the write
+        m_running = false;
+        m_pending = 0;
+        m_register[ADDRESS_WEEK_DAY] &= ~(BITMASK_OSCRUN);
+    }
+    else if (!m_running)
+    {
+        m_pending = m_startup;
+
+        if (m_pending == 0)
+        {
+            Start();
+        }
+    }
+}
+
+
+void CSimMCP7940N::Start(void)
+{
+    m_running = true;
+    m_pending = 0;
+    m_base_us = m_clock.Now();
+    m_register[ADDRESS_WEEK_DAY] |= BITMASK_OSCRUN;
+
+    ScheduleAlarm(0);
+    ScheduleAlarm(1);
+}
+
+
+void CSimMCP7940N::Stamp(const uint8_t address)
+{
+    Sync();
+
+    // Minute, hour, date, and month with week day in the top bits
+    m_register[address + 0] = m_register[ADDRESS_TIME + 1];
+    m_register[address + 1] = m_register[ADDRESS_TIME + 2];
+    m_register[address + 2] = m_register[ADDRESS_TIME + 4];
+    m_register[address + 3] = (m_register[ADDRESS_TIME + 5] & 0x1F) | ((m_register[ADDRESS_WEEK_DAY] & 0x07) << 5);
+}
+
+
+void CSimMCP7940N::ScheduleAlarm(const uint8_t index)
+{
+    const uint8_t *alarm = &m_register[index ? ADDRESS_ALARM_1 : ADDRESS_ALARM_0];
+    uint8_t match = ((alarm[ALARM_WEEK_DAY] >> 4) & 0x07);
+    uint64_t next = GetSeconds(m_clock.Now()) + 1;
+    uint32_t second = BCD_to_DEC(alarm[0] & 0x7F);
+    uint32_t minute = BCD_to_DEC(alarm[1] & 0x7F);
+    uint32_t hour = BCD_to_DEC(alarm[2] & 0x3F);
+
+    m_next_alarm[index] = CVirtualClock::NO_EVENT;
+
+    if (!m_running || !(m_register[ADDRESS_CONTROL] & (BITMASK_ALARM_0_EN << index)))
+    {
+        return;
+    }
+
+    if (match == 0)
+    {
+        next += (second + 60 - (next % 60)) % 60;
+    }
+    else if (match == 1)
+    {
+        // Minute and hour matches fire at the start of the matching unit
+        uint32_t offset = (60 * minute);
+        next += (offset + 3600 - (next % 3600)) % 3600;
+    }
+    else if (match == 2)
+    {
+        uint32_t offset = (3600 * hour);
+        next += (offset + 86400 - (next % 86400)) % 86400;
+    }
+    else if ((match == 3) || (match == 4) || (match == 7))
+    {
+        uint32_t offset = (match == 7) ? ((3600 * hour) + (60 * minute) + second) : 0;
+        uint64_t day = (next / 86400);
+        bool found = false;
+
+        // All fields can take years to line up; give up after about four
+        for (uint16_t i = 0; (i < 1500) && !found; i++, day++)
+        {
+            uint64_t t = (86400 * day) + offset;
+            CRTC::Timestamp time((uint32_t)(t % CENTURY_SECONDS));
+            bool week_day = ((alarm[ALARM_WEEK_DAY] & 0x07) == GetWeekDay(t));
+            bool date = (BCD_to_DEC(alarm[4] & 0x3F) == time.Day());
+
+            if (t < next)
+            {
+                continue;
+            }
+
+            if (match == 3)
+            {
+                found = week_day;
+            }
+            else if (match == 4)
+            {
+                found = date;
+            }
+            else
+            {
+                found = week_day && date && (BCD_to_DEC(alarm[5] & 0x1F) == time.Month());
+            }
+
+            if (found)
+            {
+                next = t;
+            }
+        }
+
+        if (!found)
+        {
+            return;
+        }
+    }
+    else
+    {
+        return; // Reserved match modes
+    }
+
+    m_next_alarm[index] = GetSecondStart(next);
+}
+
+
+uint8_t CSimMCP7940N::BCD_to_DEC(const uint8_t b)
+{
+    return ((b >> 4) * 10) + (b & 0x0F);
+}
+
+
+uint8_t CSimMCP7940N::DEC_to_BCD(const uint8_t d)
+{
+    return ((d / 10) << 4) | (d % 10);
+}
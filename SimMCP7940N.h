@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        SimMCP7940N.h
+ * @summary     Simulated MCP7940N running from a virtual clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#ifndef _SIM_MCP7940N_H_
+#define _SIM_MCP7940N_H_
+
+#include "SimBus.h"
+#include "VirtualClock.h"
+
+// Register level MCP7940N model. Time is derived from the virtual clock as
+// in CSimDS323x. Supports ST/OSCRUN with a configurable start-up, both
+// alarms in every match mode on the MFP pin, battery backup with power-fail
+// timestamps, and the 64 byte SRAM. Only 24 hour mode is modelled.
+class CSimMCP7940N : public CSimDevice, public CVirtualClock::Listener
+{
+    public:
+    // Pin event at the given virtual time (us)
+    typedef void (*callback_t)(const uint64_t time);
+
+    protected:
+    enum address_t : uint8_t
+    {
+        ADDRESS_I2C         = 0x6F,
+        ADDRESS_TIME        = 0x00,
+        ADDRESS_WEEK_DAY    = 0x03,
+        ADDRESS_MONTH       = 0x05,
+        ADDRESS_CONTROL     = 0x07,
+        ADDRESS_ALARM_0     = 0x0A,
+        ADDRESS_ALARM_1     = 0x11,
+        ADDRESS_ALARM_END   = 0x16,
+        ADDRESS_POWER_DOWN  = 0x18,
+        ADDRESS_POWER_UP    = 0x1C,
+        ADDRESS_POWER_END   = 0x1F,
+    };
+
+    enum bitmask_t : uint8_t
+    {
+        BITMASK_ST          = 0x80,
+        BITMASK_OSCRUN      = 0x20,
+        BITMASK_PWRFAIL     = 0x10,
+        BITMASK_VBATEN      = 0x08,
+        BITMASK_LPYR        = 0x20,
+        BITMASK_ALARM_0_EN  = 0x10,
+        BITMASK_ALARM_FLAG  = 0x08,
+    };
+
+    enum config_t : uint32_t
+    {
+        CENTURY_SECONDS     = 36525UL * 86400UL,
+        ALARM_WEEK_DAY      = 3, // Offset of ALMxWKDAY within an alarm
+    };
+
+    CVirtualClock &m_clock;
+    uint8_t m_register[256];
+    uint64_t m_base_us;     // Start of second m_base_epoch
+    uint64_t m_base_epoch;  // Seconds since 2000 at m_base_us, not wrapped
+    uint8_t m_base_week_day;
+    bool m_running;         // OSCRUN
+    uint8_t m_startup;      // OSCRUN polls before the oscillator runs
+    uint8_t m_pending;      // Polls left in the current start-up
+    bool m_powered;
+    uint64_t m_next_alarm[2];
+    callback_t m_interrupt;
+
+    public:
+    CSimMCP7940N(CVirtualClock &clock);
+
+    uint8_t Write(const uint8_t reg, const uint8_t data[], const uint8_t bytes);
+    uint8_t Read(const uint8_t reg, uint8_t data[], const uint8_t bytes);
+
+    uint64_t GetNextEvent(void);
+    void OnEvent(const uint64_t now);
+    void OnJump(const uint64_t now);
+
+    // MFP asserted by either alarm
+    void SetInterruptCallback(const callback_t callback);
+
+    // Reads of OSCRUN that return clear after ST is set (default 0)
+    void SetStartupPolls(const uint8_t polls);
+
+    // Main supply loss; the device NACKs until PowerUp
+    void PowerDown(void);
+    void PowerUp(void);
+
+    // Device time as seconds since 2000-01-01 within the current century
+    uint32_t GetEpoch(void);
+    bool IsRunning(void);
+
+    protected:
+    uint64_t GetSeconds(const uint64_t now);
+    uint64_t GetSecondStart(const uint64_t seconds);
+    uint8_t GetWeekDay(const uint64_t seconds);
+    void Reset(void);
+    void Sync(void);
+    void Latch(const bool reset_countdown);
+    void Start(void);
+    void Stamp(const uint8_t address);
+    void ScheduleAlarm(const uint8_t index);
+    static uint8_t BCD_to_DEC(const uint8_t b);
+    static uint8_t DEC_to_BCD(const uint8_t d);
+};
+
+#endif
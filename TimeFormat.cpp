@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        TimeFormat.cpp
+ * @summary     ISO-8601, RFC 3339 and compact text for RTC values
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#include "TimeFormat.h"
+#include "RTCPlatform.h"
+
+// Two ASCII digits per value, read pairwise instead of dividing by 10
+static const char DIGIT_PAIRS[200] PROGMEM =
+{
+    '0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+    '1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+    '2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+    '3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+    '4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+    '5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+    '6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+    '7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+    '8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+    '9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9',
+};
+
+
+uint8_t CTimeFormat::FormatISO8601(const CRTC::RTC &rtc, char buffer[])
+{
+    WriteDateTime(rtc, buffer);
+    buffer[LENGTH_ISO8601] = '\0';
+    return LENGTH_ISO8601;
+}
+
+
+uint8_t CTimeFormat::FormatRFC3339(const CRTC::RTC &rtc, const int16_t offset_minutes, char buffer[])
+{
+    uint16_t offset = (offset_minutes < 0) ? -offset_minutes : offset_minutes;
+
+    WriteDateTime(rtc, buffer);
+
+    // Numeric offset always, keeping the width fixed
+    buffer[19] = (offset_minutes < 0) ? '-' : '+';
+    WritePair(&buffer[20], offset / 60);
+    buffer[22] = ':';
+    WritePair(&buffer[23], offset % 60);
+    buffer[LENGTH_RFC3339] = '\0';
+
+    return LENGTH_RFC3339;
+}
+
+
+uint8_t CTimeFormat::FormatCompact(const CRTC::RTC &rtc, char buffer[])
+{
+    WritePair(&buffer[0], rtc.year);
+    WritePair(&buffer[2], rtc.month);
+    WritePair(&buffer[4], rtc.day);
+    WritePair(&buffer[6], rtc.hour);
+    WritePair(&buffer[8], rtc.minute);
+    WritePair(&buffer[10], rtc.second);
+    buffer[LENGTH_COMPACT] = '\0';
+
+    return LENGTH_COMPACT;
+}
+
+
+CRTC::status_t CTimeFormat::ParseISO8601(const char text[], CRTC::RTC &rtc)
+{
+    CRTC::status_t status = ReadDateTime(text, rtc);
+
+    // Reject trailing characters, e.g. an offset meant for ParseRFC3339
+    if ((status == CRTC::STATUS_OK) && (text[LENGTH_ISO8601] != '\0'))
+    {
+        return CRTC::STATUS_INVALID;
+    }
+
+    return status;
+}
+
+
+CRTC::status_t CTimeFormat::ParseRFC3339(const char text[], CRTC::RTC &rtc, int16_t &offset_minutes)
+{
+    CRTC::RTC parsed;
+
+    if (ReadDateTime(text, parsed) != CRTC::STATUS_OK)
+    {
+        return CRTC::STATUS_INVALID;
+    }
+
+    const char *p = &text[LENGTH_ISO8601];
+
+    // Fractional seconds are below RTC resolution
+    if (*p == '.')
+    {
+        do
+        {
+            p++;
+        } while ((uint8_t)(*p - '0') < 10);
+    }
+
+    if ((*p == 'Z') || (*p == 'z'))
+    {
+        offset_minutes = 0;
+        p++;
+    }
+    else if ((*p == '+') || (*p == '-'))
+    {
+        uint8_t hour;
+        uint8_t minute;
+
+        if (!ReadPair(&p[1], hour) || (p[3] != ':') || !ReadPair(&p[4], minute) || (hour > 23) || (minute > 59))
+        {
+            return CRTC::STATUS_INVALID;
+        }
+
+        offset_minutes = (60 * hour) + minute;
+
+        if (*p == '-')
+        {
+            offset_minutes = -offset_minutes;
+        }
+
+        p += 6;
+    }
+    else
+    {
+        return CRTC::STATUS_INVALID;
+    }
+
+    if (*p != '\0')
+    {
+        return CRTC::STATUS_INVALID;
+    }
+
+    rtc = parsed;
+    return CRTC::STATUS_OK;
+}
+
+
+CRTC::status_t CTimeFormat::ParseCompact(const char text[], CRTC::RTC &rtc)
+{
+    CRTC::RTC parsed;
+    bool valid = ReadPair(&text[0], parsed.year)
+        && ReadPair(&text[2], parsed.month)
+        && ReadPair(&text[4], parsed.day)
+        && ReadPair(&text[6], parsed.hour)
+        && ReadPair(&text[8], parsed.minute)
+        && ReadPair(&text[10], parsed.second);
+
+    if (!valid || (text[LENGTH_COMPACT] != '\0') || (Validate(parsed) != CRTC::STATUS_OK))
+    {
+        return CRTC::STATUS_INVALID;
+    }
+
+    rtc = parsed;
+    return CRTC::STATUS_OK;
+}
+
+
+/// Protected Functions ---------------------------------------
+
+void CTimeFormat::WritePair(char buffer[], const uint8_t value)
+{
+    const char *pair = &DIGIT_PAIRS[2 * ((value < 100) ? value : 99)];
+
+    buffer[0] = pgm_read_byte(&pair[0]);
+    buffer[1] = pgm_read_byte(&pair[1]);
+}
+
+
+bool CTimeFormat::ReadPair(const char text[], uint8_t &value)
+{
+    uint8_t tens = (uint8_t)(text[0] - '0');
+
+    // Never look past a terminator in the first digit
+    if (tens > 9)
+    {
+        return false;
+    }
+
+    uint8_t ones = (uint8_t)(text[1] - '0');
+
+    value = (10 * tens) + ones;
+    return (ones < 10);
+}
+
+
+void CTimeFormat::WriteDateTime(const CRTC::RTC &rtc, char buffer[])
+{
+    buffer[0] = '2';
+    buffer[1] = '0';
+    WritePair(&buffer[2], rtc.year);
+    buffer[4] = '-';
+    WritePair(&buffer[5], rtc.month);
+    buffer[7] = '-';
+    WritePair(&buffer[8], rtc.day);
+    buffer[10] = 'T';
+    WritePair(&buffer[11], rtc.hour);
+    buffer[13] = ':';
+    WritePair(&buffer[14], rtc.minute);
+    buffer[16] = ':';
+    WritePair(&buffer[17], rtc.second);
+}
+
+
+CRTC::status_t CTimeFormat::ReadDateTime(const char text[], CRTC::RTC &rtc)
+{
+    CRTC::RTC parsed;
+
+    // Stop at the first separator mismatch so short input is never overrun
+    if ((text[0] != '2') || (text[1] != '0')
+        || !ReadPair(&text[2], parsed.year) || (text[4] != '-')
+        || !ReadPair(&text[5], parsed.month) || (text[7] != '-')
+        || !ReadPair(&text[8], parsed.day)
+        || ((text[10] != 'T') && (text[10] != 't') && (text[10] != ' '))
+        || !ReadPair(&text[11], parsed.hour) || (text[13] != ':')
+        || !ReadPair(&text[14], parsed.minute) || (text[16] != ':')
+        || !ReadPair(&text[17], parsed.second))
+    {
+        return CRTC::STATUS_INVALID;
+    }
+
+    if (Validate(parsed) != CRTC::STATUS_OK)
+    {
+        return CRTC::STATUS_INVALID;
+    }
+
+    rtc = parsed;
+    return CRTC::STATUS_OK;
+}
+
+
+CRTC::status_t CTimeFormat::Validate(CRTC::RTC &rtc)
+{
+    static const uint8_t t[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+    if ((rtc.month < 1) || (rtc.month > 12) || (rtc.day < 1)
+        || (rtc.day > (t[rtc.month - 1] + (((rtc.month == 2) && ((rtc.year % 4) == 0)) ? 1 : 0)))
+        || (rtc.hour > 23) || (rtc.minute > 59) || (rtc.second > 59))
+    {
+        return CRTC::STATUS_INVALID;
+    }
+
+    rtc.week_day = CRTC::Timestamp(rtc).WeekDay();
+    return CRTC::STATUS_OK;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        TimeFormat.h
+ * @summary     ISO-8601, RFC 3339 and compact text for RTC values
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#ifndef _TIME_FORMAT_H_
+#define _TIME_FORMAT_H_
+
+#include "nRTC.h"
+
+// Fixed width formatting into caller buffers without printf. Buffers need
+// one byte more than the length for the terminator. Years are 2000-2099.
+class CTimeFormat
+{
+    public:
+    enum length_t : uint8_t
+    {
+        LENGTH_ISO8601  = 19,   // 2026-10-19T06:30:00
+        LENGTH_RFC3339  = 25,   // 2026-10-19T06:30:00+02:00
+        LENGTH_COMPACT  = 12,   // 261019063000
+    };
+
+    // Return the number of characters written
+    static uint8_t FormatISO8601(const CRTC::RTC &rtc, char buffer[]);
+    static uint8_t FormatRFC3339(const CRTC::RTC &rtc, const int16_t offset_minutes, char buffer[]);
+    static uint8_t FormatCompact(const CRTC::RTC &rtc, char buffer[]);
+
+    // STATUS_INVALID on malformed text or an impossible date. RFC 3339
+    // accepts 'Z' or a numeric offset and ignores fractional seconds.
+    static CRTC::status_t ParseISO8601(const char text[], CRTC::RTC &rtc);
+    static CRTC::status_t ParseRFC3339(const char text[], CRTC::RTC &rtc, int16_t &offset_minutes);
+    static CRTC::status_t ParseCompact(const char text[], CRTC::RTC &rtc);
+
+    protected:
+    static void WritePair(char buffer[], const uint8_t value);
+    static bool ReadPair(const char text[], uint8_t &value);
+    static void WriteDateTime(const CRTC::RTC &rtc, char buffer[]);
+    static CRTC::status_t ReadDateTime(const char text[], CRTC::RTC &rtc);
+    static CRTC::status_t Validate(CRTC::RTC &rtc);
+};
+
+#endif
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        TimeZone.cpp
+ * @summary     Table driven time zone and daylight saving conversion
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#include "TimeZone.h"
+#include "RTCPlatform.h"
+
+#define TIMEZONE_DECADE(YEAR, d) \
+    YEAR(d), YEAR(d + 1), YEAR(d + 2), YEAR(d + 3), YEAR(d + 4), \
+    YEAR(d + 5), YEAR(d + 6), YEAR(d + 7), YEAR(d + 8), YEAR(d + 9)
+
+#define TIMEZONE_CENTURY(YEAR) \
+    TIMEZONE_DECADE(YEAR, 0), TIMEZONE_DECADE(YEAR, 10), TIMEZONE_DECADE(YEAR, 20), \
+    TIMEZONE_DECADE(YEAR, 30), TIMEZONE_DECADE(YEAR, 40), TIMEZONE_DECADE(YEAR, 50), \
+    TIMEZONE_DECADE(YEAR, 60), TIMEZONE_DECADE(YEAR, 70), TIMEZONE_DECADE(YEAR, 80), \
+    TIMEZONE_DECADE(YEAR, 90)
+
+// EU: last Sunday of March and October at 01:00 UTC
+#define CENTRAL_EUROPE_YEAR(y) \
+    CTimeZone::Transition(CTimeZone::At(y, 3, CTimeZone::WEEK_LAST, CTimeZone::SUNDAY, 120, 60), 120), \
+    CTimeZone::Transition(CTimeZone::At(y, 10, CTimeZone::WEEK_LAST, CTimeZone::SUNDAY, 180, 120), 60)
+
+// US: first Sunday of April to last Sunday of October until 2006, then
+// second Sunday of March to first Sunday of November, at 02:00 local
+#define US_EASTERN_YEAR(y) \
+    CTimeZone::Transition((y < 7) \
+        ? CTimeZone::At(y, 4, CTimeZone::WEEK_FIRST, CTimeZone::SUNDAY, 120, -300) \
+        : CTimeZone::At(y, 3, CTimeZone::WEEK_SECOND, CTimeZone::SUNDAY, 120, -300), -240), \
+    CTimeZone::Transition((y < 7) \
+        ? CTimeZone::At(y, 10, CTimeZone::WEEK_LAST, CTimeZone::SUNDAY, 120, -240) \
+        : CTimeZone::At(y, 11, CTimeZone::WEEK_FIRST, CTimeZone::SUNDAY, 120, -240), -300)
+
+static constexpr CTimeZone::Transition CENTRAL_EUROPE[] PROGMEM =
+{
+    TIMEZONE_CENTURY(CENTRAL_EUROPE_YEAR)
+};
+
+static constexpr CTimeZone::Transition US_EASTERN[] PROGMEM =
+{
+    TIMEZONE_CENTURY(US_EASTERN_YEAR)
+};
+
+const CTimeZone TIMEZONE_UTC(nullptr, 0, 0);
+const CTimeZone TIMEZONE_CENTRAL_EUROPE(CENTRAL_EUROPE, sizeof(CENTRAL_EUROPE) / sizeof(CENTRAL_EUROPE[0]), 60);
+const CTimeZone TIMEZONE_US_EASTERN(US_EASTERN, sizeof(US_EASTERN) / sizeof(US_EASTERN[0]), -300);
+
+
+// Moves epoch by seconds, saturating at the ends of 2000-2099
+static CRTC::Timestamp Shift(const uint32_t epoch, const int32_t seconds)
+{
+    static constexpr uint32_t LAST = CRTC::Timestamp(99, 12, 31, 23, 59, 59).epoch;
+
+    if ((seconds < 0) && (epoch < (uint32_t)(-seconds)))
+    {
+        return CRTC::Timestamp(0);
+    }
+
+    if ((seconds > 0) && ((epoch >= LAST) || ((LAST - epoch) < (uint32_t)seconds)))
+    {
+        return CRTC::Timestamp(LAST);
+    }
+
+    return CRTC::Timestamp(epoch + seconds);
+}
+
+
+int16_t CTimeZone::GetOffset(const CRTC::Timestamp utc) const
+{
+    uint16_t low = 0;
+    uint16_t high = m_count;
+
+    // Find the first transition later than utc
+    while (low < high)
+    {
+        uint16_t mid = (low + high) / 2;
+
+        if (pgm_read_dword(&m_table[mid].utc) <= utc.epoch)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return (low == 0) ? m_standard : (int16_t)pgm_read_word(&m_table[low - 1].offset);
+}
+
+
+bool CTimeZone::IsDST(const CRTC::Timestamp utc) const
+{
+    return (GetOffset(utc) != m_standard);
+}
+
+
+CRTC::Timestamp CTimeZone::ToLocal(const CRTC::Timestamp utc) const
+{
+    return Shift(utc.epoch, 60L * GetOffset(utc));
+}
+
+
+CRTC::Timestamp CTimeZone::ToUTC(const CRTC::Timestamp local) const
+{
+    // Transitions are months apart, so a day either side brackets at most one
+    int16_t before = GetOffset(Shift(local.epoch, -86400L));
+    int16_t after = GetOffset(Shift(local.epoch, 86400L));
+    CRTC::Timestamp earlier = Shift(local.epoch, -60L * before);
+    CRTC::Timestamp later = Shift(local.epoch, -60L * after);
+
+    // Repeated hour resolves to the first occurrence
+    if (GetOffset(earlier) == before)
+    {
+        return earlier;
+    }
+
+    if (GetOffset(later) == after)
+    {
+        return later;
+    }
+
+    // Skipped hour: move forward by the gap
+    return earlier;
+}
+
+
+CRTC::status_t CTimeZone::GetLocalRTC(CRTC &rtc, CRTC::RTC &local) const
+{
+    CRTC::Timestamp utc;
+    CRTC::status_t status = rtc.GetTimestamp(utc);
+
+    ToLocal(utc).ToRTC(local);
+    return status;
+}
+
+
+CRTC::status_t CTimeZone::SetLocalRTC(CRTC &rtc, const CRTC::RTC &local) const
+{
+    CRTC::RTC utc;
+
+    ToUTC(CRTC::Timestamp(local)).ToRTC(utc);
+    return rtc.SetRTC(utc);
+}
+
+
+CRTC::status_t CTimeZone::SetAlarmLocal(CRTC &rtc, const CRTC::RTC &local) const
+{
+    CRTC::Timestamp now;
+    CRTC::status_t status = rtc.GetTimestamp(now);
+
+    if (status != CRTC::STATUS_OK)
+    {
+        return status;
+    }
+
+    uint32_t today = ToLocal(now).epoch;
+    today -= (today % 86400);
+
+    uint32_t target = today + (3600UL * local.hour) + (60UL * local.minute) + local.second;
+    CRTC::Timestamp utc = ToUTC(CRTC::Timestamp(target));
+
+    if (utc.epoch <= now.epoch)
+    {
+        utc = ToUTC(CRTC::Timestamp(target + 86400));
+    }
+
+    CRTC::RTC alarm;
+
+    utc.ToRTC(alarm);
+    return rtc.SetAlarmRTC(alarm);
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        TimeZone.h
+ * @summary     Table driven time zone and daylight saving conversion
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#ifndef _TIME_ZONE_H_
+#define _TIME_ZONE_H_
+
+#include "nRTC.h"
+
+// Converts between the UTC kept by the RTC and local time using a sorted
+// table of transitions built at compile time (placed in PROGMEM on AVR).
+// Offsets are in minutes east of UTC.
+class CTimeZone
+{
+    public:
+    enum week_t : uint8_t
+    {
+        WEEK_FIRST = 1,
+        WEEK_SECOND,
+        WEEK_THIRD,
+        WEEK_FOURTH,
+        WEEK_LAST,
+    };
+
+    enum day_t : uint8_t
+    {
+        SUNDAY = 1, // Matches CRTC::Timestamp::WeekDay()
+        MONDAY,
+        TUESDAY,
+        WEDNESDAY,
+        THURSDAY,
+        FRIDAY,
+        SATURDAY,
+    };
+
+    // Offset in effect from utc until the next transition
+    struct Transition
+    {
+        constexpr Transition(const uint32_t utc_epoch, const int16_t offset_minutes)
+            : utc{utc_epoch}
+            , offset{offset_minutes}
+        {
+            // empty
+        }
+
+        uint32_t utc;
+        int16_t offset;
+    };
+
+    constexpr CTimeZone(const Transition table[], const uint16_t count, const int16_t standard)
+        : m_table{table}
+        , m_count{count}
+        , m_standard{standard}
+    {
+        // empty
+    }
+
+    int16_t GetOffset(const CRTC::Timestamp utc) const;
+    bool IsDST(const CRTC::Timestamp utc) const;
+    // Results saturate at 2000-01-01 and the end of 2099
+    CRTC::Timestamp ToLocal(const CRTC::Timestamp utc) const;
+    CRTC::Timestamp ToUTC(const CRTC::Timestamp local) const;
+
+    // The device runs in UTC; these convert on the way in and out
+    CRTC::status_t GetLocalRTC(CRTC &rtc, CRTC::RTC &local) const;
+    CRTC::status_t SetLocalRTC(CRTC &rtc, const CRTC::RTC &local) const;
+
+    // Arms the daily alarm for the next occurrence of local hour:minute:second.
+    // Re-arm after each trigger so the UTC match follows DST changes.
+    CRTC::status_t SetAlarmLocal(CRTC &rtc, const CRTC::RTC &local) const;
+
+    // UTC epoch of a rule such as "last Sunday of March, 02:00 local" given
+    // the offset in effect before the transition
+    static constexpr uint32_t At(const uint8_t y, const uint8_t m, const week_t week,
+                                 const day_t day, const int16_t local_minute, const int16_t offset)
+    {
+        return (86400UL * (CRTC::Timestamp::DaysFromCivil(y, m, 1) + DayOfMonth(y, m, week, day) - 1))
+            + (uint32_t)(60L * (local_minute - offset));
+    }
+
+    protected:
+    static constexpr uint8_t FirstDay(const uint8_t y, const uint8_t m, const day_t day)
+    {
+        return 1 + ((7 + day - CRTC::Timestamp(y, m, 1, 0, 0, 0).WeekDay()) % 7);
+    }
+
+    static constexpr uint8_t DaysInMonth(const uint8_t y, const uint8_t m)
+    {
+        return (m == 12) ? 31
+            : (CRTC::Timestamp::DaysFromCivil(y, m + 1, 1) - CRTC::Timestamp::DaysFromCivil(y, m, 1));
+    }
+
+    // WEEK_LAST falls back a week when a fifth occurrence does not exist
+    static constexpr uint8_t DayOfMonth(const uint8_t y, const uint8_t m, const week_t week, const day_t day)
+    {
+        return ((FirstDay(y, m, day) + (7 * (week - 1))) > DaysInMonth(y, m))
+            ? (FirstDay(y, m, day) + (7 * (week - 2)))
+            : (FirstDay(y, m, day) + (7 * (week - 1)));
+    }
+
+    const Transition *m_table;
+    uint16_t m_count;
+    int16_t m_standard;
+};
+
+// Prebuilt zones covering 2000-2099
+extern const CTimeZone TIMEZONE_UTC;
+extern const CTimeZone TIMEZONE_CENTRAL_EUROPE;
+extern const CTimeZone TIMEZONE_US_EASTERN;
+
+#endif
@@ -0,0 +1,408 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        TraceBus.cpp
+ * @summary     I2C transaction trace recording and deterministic replay
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#include "TraceBus.h"
+#include "RTCPlatform.h"
+
+static const uint8_t TRACE_MAGIC[] = {'n', 'R', 'T'};
+
+static uint32_t DefaultTick(void)
+{
+    return micros();
+}
+
+
+CTraceBus::CTraceBus(CRTCBus &bus, sink_t sink)
+    : CTraceBus(bus, sink, DefaultTick)
+{
+    // empty
+}
+
+
+CTraceBus::CTraceBus(CRTCBus &bus, sink_t sink, tick_t tick)
+    : m_bus(bus)
+    , m_sink{sink}
+    , m_tick{tick}
+    , m_last{0}
+    , m_count{0}
+    , m_recording{false}
+{
+    // empty
+}
+
+
+void CTraceBus::Start(void)
+{
+    uint8_t header[HEADER_SIZE] = {TRACE_MAGIC[0], TRACE_MAGIC[1], TRACE_MAGIC[2], FORMAT_VERSION};
+
+    m_sink(header, HEADER_SIZE);
+    m_last = m_tick();
+    m_recording = true;
+}
+
+
+void CTraceBus::Stop(void)
+{
+    m_recording = false;
+}
+
+
+CRTCBus::handle_t CTraceBus::RegisterDevice(const uint8_t address, const Speed speed)
+{
+    // Drivers register on every Initialize; reuse the handle for the address
+    for (uint8_t i = 0; i < m_count; i++)
+    {
+        if (m_address[i] == address)
+        {
+            return i;
+        }
+    }
+
+    if (m_count >= MAX_DEVICES)
+    {
+        return HANDLE_INVALID;
+    }
+
+    m_address[m_count] = address;
+    m_handle[m_count] = m_bus.RegisterDevice(address, speed);
+    return m_count++;
+}
+
+
+uint8_t CTraceBus::Write(const handle_t handle, const uint8_t reg, const uint8_t data[], const uint8_t bytes)
+{
+    if (handle >= m_count)
+    {
+        return 0xFF;
+    }
+
+    uint8_t result = m_bus.Write(m_handle[handle], reg, data, bytes);
+
+    Record(result ? FORMAT_ERROR : 0, handle, reg, data, bytes);
+    return result;
+}
+
+
+uint8_t CTraceBus::Read(const handle_t handle, const uint8_t reg, uint8_t data[], const uint8_t bytes)
+{
+    if (handle >= m_count)
+    {
+        return 0xFF;
+    }
+
+    uint8_t result = m_bus.Read(m_handle[handle], reg, data, bytes);
+
+    // Failed reads carry no payload
+    Record(result ? (FORMAT_READ | FORMAT_ERROR) : FORMAT_READ, handle, reg, result ? nullptr : data, bytes);
+    return result;
+}
+
+
+/// Protected Functions ---------------------------------------
+
+void CTraceBus::Record(const uint8_t flags, const handle_t handle, const uint8_t reg, const uint8_t data[], const uint8_t bytes)
+{
+    uint8_t record[RECORD_SIZE + 5];
+    uint8_t length = RECORD_SIZE;
+
+    if (!m_recording)
+    {
+        return;
+    }
+
+    uint32_t tick = m_tick();
+    uint32_t delta = (tick - m_last);
+
+    m_last = tick;
+
+    record[0] = flags;
+    record[1] = m_address[handle];
+    record[2] = reg;
+    record[3] = bytes;
+
+    // Little endian base 128
+    do
+    {
+        record[length] = (delta & 0x7F);
+        delta >>= 7;
+
+        if (delta)
+        {
+            record[length] |= 0x80;
+        }
+    } while (record[length++] & 0x80);
+
+    m_sink(record, length);
+
+    if (data != nullptr)
+    {
+        m_sink(data, bytes);
+    }
+}
+
+
+CReplayBus::CReplayBus(const uint8_t trace[], const uint32_t size)
+    : m_trace{trace}
+    , m_size{size}
+    , m_position{0}
+    , m_time{0}
+    , m_transfers{0}
+    , m_bus_time{0}
+    , m_divergences{0}
+    , m_count{0}
+    , m_strict{true}
+{
+    Rewind();
+}
+
+
+bool CReplayBus::IsValid(void)
+{
+    return (m_size >= CTraceBus::HEADER_SIZE)
+        && (m_trace[0] == TRACE_MAGIC[0])
+        && (m_trace[1] == TRACE_MAGIC[1])
+        && (m_trace[2] == TRACE_MAGIC[2])
+        && (m_trace[3] == CTraceBus::FORMAT_VERSION);
+}
+
+
+void CReplayBus::SetStrict(const bool strict)
+{
+    m_strict = strict;
+}
+
+
+void CReplayBus::Rewind(void)
+{
+    m_position = IsValid() ? (uint32_t)CTraceBus::HEADER_SIZE : m_size;
+    m_time = 0;
+    m_transfers = 0;
+    m_bus_time = 0;
+    m_divergences = 0;
+}
+
+
+CRTCBus::handle_t CReplayBus::RegisterDevice(const uint8_t address, const Speed speed)
+{
+    // Same handles as the recording bus handed out
+    for (uint8_t i = 0; i < m_count; i++)
+    {
+        if ((m_address[i] == address) && (m_speed[i] == speed))
+        {
+            return i;
+        }
+    }
+
+    if (m_count >= MAX_DEVICES)
+    {
+        return HANDLE_INVALID;
+    }
+
+    m_address[m_count] = address;
+    m_speed[m_count] = speed;
+    return m_count++;
+}
+
+
+uint8_t CReplayBus::Write(const handle_t handle, const uint8_t reg, const uint8_t data[], const uint8_t bytes)
+{
+    Record record;
+
+    if (handle >= m_count)
+    {
+        return 0xFF;
+    }
+
+    m_transfers++;
+    m_bus_time += GetTransferTime(false, bytes, m_speed[handle]);
+
+    if (!Next(false, handle, reg, bytes, record))
+    {
+        // Relaxed replay acknowledges writes the trace does not have
+        return m_strict ? 4 : 0;
+    }
+
+    for (uint8_t i = 0; i < bytes; i++)
+    {
+        if (record.payload[i] != data[i])
+        {
+            m_divergences++;
+            break;
+        }
+    }
+
+    return (record.flags & CTraceBus::FORMAT_ERROR) ? 4 : 0;
+}
+
+
+uint8_t CReplayBus::Read(const handle_t handle, const uint8_t reg, uint8_t data[], const uint8_t bytes)
+{
+    Record record;
+
+    if (handle >= m_count)
+    {
+        return 0xFF;
+    }
+
+    m_transfers++;
+    m_bus_time += GetTransferTime(true, bytes, m_speed[handle]);
+
+    if (!Next(true, handle, reg, bytes, record))
+    {
+        return 4;
+    }
+
+    if (record.flags & CTraceBus::FORMAT_ERROR)
+    {
+        return 4; // Recorded bus failure
+    }
+
+    for (uint8_t i = 0; i < bytes; i++)
+    {
+        data[i] = record.payload[i];
+    }
+
+    return 0;
+}
+
+
+uint32_t CReplayBus::GetTransfers(void)
+{
+    return m_transfers;
+}
+
+
+uint32_t CReplayBus::GetBusTime(void)
+{
+    return m_bus_time;
+}
+
+
+uint32_t CReplayBus::GetDivergences(void)
+{
+    return m_divergences;
+}
+
+
+uint32_t CReplayBus::GetTraceTime(void)
+{
+    return m_time;
+}
+
+
+bool CReplayBus::IsFinished(void)
+{
+    return (m_position >= m_size);
+}
+
+
+/// Protected Functions ---------------------------------------
+
+bool CReplayBus::Parse(uint32_t &position, Record &record)
+{
+    uint32_t index = position;
+
+    if ((index + CTraceBus::RECORD_SIZE) > m_size)
+    {
+        return false;
+    }
+
+    record.flags = m_trace[index++];
+    record.address = m_trace[index++];
+    record.reg = m_trace[index++];
+    record.length = m_trace[index++];
+    record.delta = 0;
+
+    for (uint8_t shift = 0; ; shift += 7)
+    {
+        if ((index >= m_size) || (shift > 28))
+        {
+            return false;
+        }
+
+        uint8_t b = m_trace[index++];
+        record.delta |= ((uint32_t)(b & 0x7F) << shift);
+
+        if (!(b & 0x80))
+        {
+            break;
+        }
+    }
+
+    record.payload = &m_trace[index];
+
+    // Failed reads have no payload
+    if ((record.flags & (CTraceBus::FORMAT_READ | CTraceBus::FORMAT_ERROR))
+        != (CTraceBus::FORMAT_READ | CTraceBus::FORMAT_ERROR))
+    {
+        index += record.length;
+    }
+
+    if (index > m_size)
+    {
+        return false;
+    }
+
+    position = index;
+    return true;
+}
+
+
+bool CReplayBus::Next(const bool read, const handle_t handle, const uint8_t reg, const uint8_t bytes, Record &record)
+{
+    uint32_t position = m_position;
+    uint32_t time = m_time;
+
+    while (Parse(position, record))
+    {
+        time += record.delta;
+
+        if ((!!(record.flags & CTraceBus::FORMAT_READ) == read)
+            && (record.address == m_address[handle])
+            && (record.reg == reg)
+            && (record.length == bytes))
+        {
+            m_position = position;
+            m_time = time;
+            return true;
+        }
+
+        // Strict replay only looks at the record under the cursor; relaxed
+        // replay skips ahead for reads but never for writes
+        if (m_strict || !read)
+        {
+            break;
+        }
+    }
+
+    if (m_strict || read)
+    {
+        m_divergences++;
+    }
+
+    return false;
+}
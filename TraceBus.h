@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        TraceBus.h
+ * @summary     I2C transaction trace recording and deterministic replay
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#ifndef _TRACE_BUS_H_
+#define _TRACE_BUS_H_
+
+#include "RTCBus.h"
+
+// Trace format: 4 byte header "nRT" + version, then one record per
+// transfer: [flags][device address][register][length][varint delta us]
+// followed by the payload (written data, or data read on success).
+// Flags bit 0 marks a read, bit 1 a failed transfer.
+class CTraceBus : public CRTCBus
+{
+    public:
+    // Receives trace bytes as they are produced
+    typedef void (*sink_t)(const uint8_t data[], const uint8_t bytes);
+
+    // Microsecond tick source, e.g. micros()
+    typedef uint32_t (*tick_t)(void);
+
+    enum format_t : uint8_t
+    {
+        FORMAT_VERSION  = 1,
+        FORMAT_READ     = 0x01,
+        FORMAT_ERROR    = 0x02,
+        HEADER_SIZE     = 4,
+        RECORD_SIZE     = 4,    // Fixed part before the varint delta
+    };
+
+    protected:
+    enum config_t : uint8_t
+    {
+        MAX_DEVICES = 4,
+    };
+
+    CRTCBus &m_bus;
+    sink_t m_sink;
+    tick_t m_tick;
+    uint32_t m_last;
+    uint8_t m_address[MAX_DEVICES];
+    handle_t m_handle[MAX_DEVICES];
+    uint8_t m_count;
+    bool m_recording;
+
+    public:
+    // Record transfers passing through to the given bus
+    CTraceBus(CRTCBus &bus, sink_t sink);
+    CTraceBus(CRTCBus &bus, sink_t sink, tick_t tick);
+
+    // Emit the header and start recording
+    void Start(void);
+    void Stop(void);
+
+    handle_t RegisterDevice(const uint8_t address, const Speed speed);
+    uint8_t Write(const handle_t handle, const uint8_t reg, const uint8_t data[], const uint8_t bytes);
+    uint8_t Read(const handle_t handle, const uint8_t reg, uint8_t data[], const uint8_t bytes);
+
+    protected:
+    void Record(const uint8_t flags, const handle_t handle, const uint8_t reg, const uint8_t data[], const uint8_t bytes);
+};
+
+
+// Serves reads from a recorded trace. Strict replay requires the exact
+// recorded sequence; relaxed replay acknowledges every write and answers
+// each read from the next matching recorded read, so a changed driver can
+// be compared against real traffic.
+class CReplayBus : public CRTCBus
+{
+    protected:
+    enum config_t : uint8_t
+    {
+        MAX_DEVICES = 4,
+    };
+
+    struct Record
+    {
+        uint8_t flags;
+        uint8_t address;
+        uint8_t reg;
+        uint8_t length;
+        uint32_t delta;
+        const uint8_t *payload;
+    };
+
+    const uint8_t *m_trace;
+    uint32_t m_size;
+    uint32_t m_position;
+    uint32_t m_time;        // Recorded time (us) of the last served record
+    uint32_t m_transfers;
+    uint32_t m_bus_time;
+    uint32_t m_divergences;
+    uint8_t m_address[MAX_DEVICES];
+    Speed m_speed[MAX_DEVICES];
+    uint8_t m_count;
+    bool m_strict;
+
+    public:
+    CReplayBus(const uint8_t trace[], const uint32_t size);
+
+    // False when the header is missing or has another version
+    bool IsValid(void);
+
+    void SetStrict(const bool strict);
+    void Rewind(void);
+
+    handle_t RegisterDevice(const uint8_t address, const Speed speed);
+    uint8_t Write(const handle_t handle, const uint8_t reg, const uint8_t data[], const uint8_t bytes);
+    uint8_t Read(const handle_t handle, const uint8_t reg, uint8_t data[], const uint8_t bytes);
+
+    uint32_t GetTransfers(void);
+    uint32_t GetBusTime(void);      // Wire time (us) of the replayed transfers
+    uint32_t GetDivergences(void);  // Transfers that did not match the trace
+    uint32_t GetTraceTime(void);    // Recorded time (us) at the replay cursor
+    bool IsFinished(void);
+
+    protected:
+    bool Parse(uint32_t &position, Record &record);
+    bool Next(const bool read, const handle_t handle, const uint8_t reg, const uint8_t bytes, Record &record);
+};
+
+#endif
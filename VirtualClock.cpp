@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        VirtualClock.cpp
+ * @summary     Controllable virtual time base for simulated devices
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#include "VirtualClock.h"
+#include "RTCPlatform.h"
+
+void CVirtualClock::Listener::OnJump(const uint64_t now)
+{
+    (void)now;
+}
+
+
+CVirtualClock::CVirtualClock(void)
+    : m_count{0}
+    , m_now{0}
+    , m_rate{1}
+    , m_events{0}
+{
+    // empty
+}
+
+
+bool CVirtualClock::Attach(Listener &listener)
+{
+    if (m_count >= MAX_LISTENERS)
+    {
+        return false;
+    }
+
+    m_listener[m_count++] = &listener;
+    return true;
+}
+
+
+uint64_t CVirtualClock::Now(void)
+{
+    return m_now;
+}
+
+
+uint32_t CVirtualClock::GetMillis(void)
+{
+    return (uint32_t)(m_now / 1000);
+}
+
+
+void CVirtualClock::Step(const uint64_t us)
+{
+    StepTo(m_now + us);
+}
+
+
+void CVirtualClock::StepTo(const uint64_t time)
+{
+    for (;;)
+    {
+        Listener *next = nullptr;
+        uint64_t earliest = time;
+
+        // Earliest due event; ties go to the first attached listener
+        for (uint8_t i = 0; i < m_count; i++)
+        {
+            uint64_t event = m_listener[i]->GetNextEvent();
+
+            if ((event <= earliest) && ((next == nullptr) || (event < earliest)))
+            {
+                earliest = event;
+                next = m_listener[i];
+            }
+        }
+
+        if (next == nullptr)
+        {
+            break;
+        }
+
+        if (earliest > m_now)
+        {
+            m_now = earliest;
+        }
+
+        next->OnEvent(m_now);
+        m_events++;
+    }
+
+    if (time > m_now)
+    {
+        m_now = time;
+    }
+}
+
+
+void CVirtualClock::Jump(const uint64_t time)
+{
+    m_now = time;
+
+    for (uint8_t i = 0; i < m_count; i++)
+    {
+        m_listener[i]->OnJump(m_now);
+    }
+}
+
+
+void CVirtualClock::SetRate(const uint32_t factor)
+{
+    m_rate = factor;
+}
+
+
+void CVirtualClock::Run(const uint32_t duration_ms)
+{
+    uint32_t start = millis();
+    uint64_t origin = m_now;
+    uint32_t elapsed;
+
+    do
+    {
+        elapsed = (millis() - start);
+        StepTo(origin + ((uint64_t)elapsed * 1000 * m_rate));
+        delay(1);
+    } while (elapsed < duration_ms);
+}
+
+
+uint32_t CVirtualClock::GetEvents(void)
+{
+    return m_events;
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        VirtualClock.h
+ * @summary     Controllable virtual time base for simulated devices
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+#ifndef _VIRTUAL_CLOCK_H_
+#define _VIRTUAL_CLOCK_H_
+
+#include <inttypes.h>
+
+// Microsecond time base shared by simulated devices. Advancing the clock
+// delivers every listener event due in the interval in time order, so
+// alarms and square wave edges fire exactly when the device would raise
+// them however far the clock moves in one call.
+class CVirtualClock
+{
+    public:
+    class Listener
+    {
+        public:
+        // Absolute time (us) of the next event, NO_EVENT when none
+        virtual uint64_t GetNextEvent(void) = 0;
+        virtual void OnEvent(const uint64_t now) = 0;
+
+        // Time moved without delivering events
+        virtual void OnJump(const uint64_t now);
+    };
+
+    static const uint64_t NO_EVENT = 0xFFFFFFFFFFFFFFFFULL;
+
+    protected:
+    enum config_t : uint8_t
+    {
+        MAX_LISTENERS = 4,
+    };
+
+    Listener *m_listener[MAX_LISTENERS];
+    uint8_t m_count;
+    uint64_t m_now;
+    uint32_t m_rate;
+    uint32_t m_events;
+
+    public:
+    CVirtualClock(void);
+
+    bool Attach(Listener &listener);
+
+    uint64_t Now(void);
+    uint32_t GetMillis(void);
+
+    // Advance, firing events in order
+    void Step(const uint64_t us);
+    void StepTo(const uint64_t time);
+
+    // Move to an absolute time without firing the events in between
+    void Jump(const uint64_t time);
+
+    // Follow wall time at the given multiple for the given duration
+    void SetRate(const uint32_t factor);
+    void Run(const uint32_t duration_ms);
+
+    uint32_t GetEvents(void);
+};
+
+#endif
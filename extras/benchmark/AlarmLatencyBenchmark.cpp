@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        AlarmLatencyBenchmark.cpp
+ * @summary     Alarm match to handler latency by delivery strategy on the simulated DS3231
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+// Build on the host from the library root with
+//   g++ -std=gnu++11 -O2 -I. DS323x.cpp nRTC.cpp RTCBus.cpp SimBus.cpp
+//   SimDS323x.cpp VirtualClock.cpp extras/benchmark/AlarmLatencyBenchmark.cpp
+// Usage: alarm_latency_benchmark [alarms per strategy] [seed]
+//
+// Every transfer advances the virtual clock by its wire time at 400 kHz,
+// so the numbers include the bus cost of detecting and acknowledging.
+// Each alarm is armed two seconds ahead from a random point in the
+// second, and the polling phase is random too. Latencies are measured
+// from the chip's alarm match:
+//   detect  the handler knows the alarm fired (and is running)
+//   ack     AlarmReset has cleared the flag, ready for the next alarm
+
+#include "DS323x.h"
+#include "SimDS323x.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static CVirtualClock g_clock;
+static CSimDS323x *g_chip = nullptr;
+static uint64_t g_match = 0;        // Alarm match time
+static uint64_t g_edge = 0;         // Last SQW edge
+static uint32_t g_alarm_epoch = 0;  // Seconds of day the alarm matches
+
+
+// Transfers take their wire time on the virtual clock
+class CWireBus : public CSimBus
+{
+    public:
+    uint8_t Write(const handle_t handle, const uint8_t reg, const uint8_t data[], const uint8_t bytes)
+    {
+        g_clock.Step(GetTransferTime(false, bytes, GetSpeed(handle)));
+        return CSimBus::Write(handle, reg, data, bytes);
+    }
+
+    uint8_t Read(const handle_t handle, const uint8_t reg, uint8_t data[], const uint8_t bytes)
+    {
+        g_clock.Step(GetTransferTime(true, bytes, GetSpeed(handle)));
+        return CSimBus::Read(handle, reg, data, bytes);
+    }
+};
+
+
+enum class Strategy : uint8_t
+{
+    POLL,   // IsAlarmTriggered every period
+    PIN,    // INT falling edge wakes the handler
+    TICK,   // SQW edges count seconds locally; one read confirms
+};
+
+
+struct Result
+{
+    std::vector<uint32_t> detect;
+    std::vector<uint32_t> ack;
+    uint64_t transfers;
+    uint32_t missed;
+};
+
+
+static void OnInterrupt(const uint64_t time)
+{
+    g_match = time;
+}
+
+
+static void OnSquareWave(const uint64_t time)
+{
+    g_edge = time;
+
+    // Alarm and edge are the same event; the flag is already set
+    if ((g_chip->GetEpoch() % 86400) == g_alarm_epoch)
+    {
+        g_match = time;
+    }
+}
+
+
+static uint32_t Random(void)
+{
+    static uint32_t state = 0x2545F491;
+
+    // xorshift32
+    state ^= (state << 13);
+    state ^= (state >> 17);
+    state ^= (state << 5);
+    return state;
+}
+
+
+static uint32_t Percentile(std::vector<uint32_t> &samples, const uint8_t percent)
+{
+    if (samples.empty())
+    {
+        return 0;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    // Nearest rank
+    size_t rank = ((samples.size() * percent) + 99) / 100;
+
+    return samples[(rank > 0) ? (rank - 1) : 0];
+}
+
+
+static void PrintHistogram(const std::vector<uint32_t> &samples)
+{
+    uint32_t bucket[32] = {0};
+    uint32_t peak = 0;
+    uint8_t first = 31;
+    uint8_t last = 0;
+
+    // Power of two buckets in microseconds
+    for (uint32_t sample : samples)
+    {
+        uint8_t index = 0;
+
+        while ((index < 31) && ((1UL << (index + 1)) <= sample))
+        {
+            index++;
+        }
+
+        bucket[index]++;
+        peak = std::max(peak, bucket[index]);
+        first = std::min(first, index);
+        last = std::max(last, index);
+    }
+
+    for (uint8_t i = first; (peak > 0) && (i <= last); i++)
+    {
+        printf("    < %9lu us %6u |%.*s\n", (1UL << (i + 1)), bucket[i],
+            (int)((bucket[i] * 40 + peak - 1) / peak), "########################################");
+    }
+}
+
+
+static Result Run(CDS3231 &rtc, CWireBus &bus, const Strategy strategy, const uint32_t period_us, const uint32_t alarms)
+{
+    Result result;
+
+    result.transfers = 0;
+    result.missed = 0;
+
+    // INTCN routes the alarm to the pin; without it the pin is the 1 Hz SQW
+    rtc.SetSquareWave(strategy == Strategy::TICK, 0);
+
+    for (uint32_t n = 0; n < alarms; n++)
+    {
+        CRTC::RTC now;
+
+        g_clock.Step(Random() % 1000000);
+        rtc.GetRTC(now);
+
+        uint32_t second_of_day = (now.hour * 3600UL) + (now.minute * 60UL) + now.second;
+        uint32_t local = second_of_day;
+        CRTC::RTC alarm;
+
+        g_alarm_epoch = (second_of_day + 2) % 86400;
+        alarm.hour = (g_alarm_epoch / 3600);
+        alarm.minute = ((g_alarm_epoch / 60) % 60);
+        alarm.second = (g_alarm_epoch % 60);
+
+        rtc.SetAlarmRTC(alarm);
+        g_match = 0;
+
+        uint64_t edge = g_edge;
+        uint64_t timeout = g_clock.Now() + 5000000;
+        uint64_t next = g_clock.Now() + (Random() % period_us);
+        uint64_t detect = 0;
+        uint32_t transfers = bus.GetTransfers();
+
+        while (detect == 0)
+        {
+            if (g_clock.Now() > timeout)
+            {
+                result.missed++;
+                break;
+            }
+
+            switch (strategy)
+            {
+                case Strategy::POLL:
+                    g_clock.StepTo(next);
+                    next += period_us;
+
+                    if (rtc.IsAlarmTriggered())
+                    {
+                        detect = g_clock.Now();
+                    }
+                    break;
+
+                case Strategy::PIN:
+                    // Sleep until the next chip event
+                    g_clock.StepTo(g_chip->GetNextEvent());
+
+                    if (g_match)
+                    {
+                        detect = g_clock.Now();
+                    }
+                    break;
+
+                case Strategy::TICK:
+                    g_clock.StepTo(g_chip->GetNextEvent());
+
+                    if (g_edge != edge)
+                    {
+                        edge = g_edge;
+                        local = (local + 1) % 86400;
+
+                        // Bus is only touched on the predicted second
+                        if ((local == g_alarm_epoch) && rtc.IsAlarmTriggered())
+                        {
+                            detect = g_clock.Now();
+                        }
+                    }
+                    break;
+            }
+        }
+
+        if (detect == 0)
+        {
+            continue;
+        }
+
+        rtc.AlarmReset();
+
+        result.detect.push_back((uint32_t)(detect - g_match));
+        result.ack.push_back((uint32_t)(g_clock.Now() - g_match));
+        result.transfers += (bus.GetTransfers() - transfers);
+    }
+
+    return result;
+}
+
+
+int main(int argc, char *argv[])
+{
+    uint32_t alarms = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 500;
+
+    if (argc > 2)
+    {
+        for (uint32_t i = strtoul(argv[2], nullptr, 10); i > 0; i--)
+        {
+            Random();
+        }
+    }
+
+    CWireBus bus;
+    CSimDS323x chip(g_clock);
+    CDS3231 rtc;
+
+    g_chip = &chip;
+    bus.Attach(chip);
+    g_clock.Attach(chip);
+    chip.SetInterruptCallback(OnInterrupt);
+    chip.SetSquareWaveCallback(OnSquareWave);
+
+    rtc.SetBus(bus);
+    rtc.Initialize();
+
+    struct
+    {
+        const char *name;
+        Strategy strategy;
+        uint32_t period_us;
+    } cases[] =
+    {
+        {"poll 1 ms",       Strategy::POLL, 1000},
+        {"poll 10 ms",      Strategy::POLL, 10000},
+        {"poll 100 ms",     Strategy::POLL, 100000},
+        {"poll 1000 ms",    Strategy::POLL, 1000000},
+        {"INT pin",         Strategy::PIN,  1000000},
+        {"cached tick",     Strategy::TICK, 1000000},
+    };
+
+    std::vector<Result> results;
+
+    printf("%u alarms per strategy, latency from alarm match (us)\n\n", alarms);
+    printf("strategy        detect p50     p99     max     ack p50     p99     max  transfers/alarm\n");
+
+    for (const auto &c : cases)
+    {
+        Result result = Run(rtc, bus, c.strategy, c.period_us, alarms);
+        uint32_t count = result.ack.size();
+
+        printf("%-14s %11u %7u %7u %11u %7u %7u %16.1f",
+            c.name,
+            Percentile(result.detect, 50), Percentile(result.detect, 99), Percentile(result.detect, 100),
+            Percentile(result.ack, 50), Percentile(result.ack, 99), Percentile(result.ack, 100),
+            count ? (double)result.transfers / count : 0.0);
+
+        if (result.missed)
+        {
+            printf("  (%u missed)", result.missed);
+        }
+
+        printf("\n");
+        results.push_back(result);
+    }
+
+    printf("\nmatch to ack histograms\n");
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        printf("  %s\n", cases[i].name);
+        PrintHistogram(results[i].ack);
+    }
+
+    return 0;
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        CalendarBatchBenchmark.cpp
+ * @summary     Host records per second for CCalendarBatch kernels
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+// Build on the host from the library root with
+//   g++ -std=gnu++11 -O2 -pthread -I. CalendarBatch.cpp nRTC.cpp RTCBus.cpp
+//   extras/benchmark/CalendarBatchBenchmark.cpp
+// Usage: calendar_batch_benchmark [records] [threads]
+
+#include "CalendarBatch.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static uint8_t ToBCD(const uint8_t value)
+{
+    return ((value / 10) << 4) | (value % 10);
+}
+
+
+template <typename F>
+static void Measure(const char *name, const size_t records, F function)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    function();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%-28s %8.1f Mrecords/s\n", name, (records / seconds) / 1e6);
+}
+
+
+int main(int argc, char *argv[])
+{
+    size_t records = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 16000000;
+    unsigned threads = (argc > 2) ? atoi(argv[2]) : 0;
+    std::vector<uint8_t> images(records * CCalendarBatch::IMAGE_SIZE);
+    std::vector<uint32_t> epochs(records);
+    std::vector<CRTC::RTC> calendar(records);
+    std::vector<uint8_t> bytes(records);
+    std::vector<uint16_t> days(records);
+    uint32_t seed = 1;
+
+    for (size_t i = 0; i < records; i++)
+    {
+        CRTC::RTC rtc;
+        uint8_t *image = &images[i * CCalendarBatch::IMAGE_SIZE];
+
+        seed = (seed * 1103515245) + 12345;
+        CRTC::Timestamp(seed % 3155760000UL).ToRTC(rtc);
+        image[0] = ToBCD(rtc.second);
+        image[1] = ToBCD(rtc.minute);
+        image[2] = ToBCD(rtc.hour);
+        image[3] = rtc.week_day;
+        image[4] = ToBCD(rtc.day);
+        image[5] = ToBCD(rtc.month);
+        image[6] = ToBCD(rtc.year);
+    }
+
+    // Per-record decode as a driver would do it, for reference
+    Measure("per-record decode", records, [&]()
+    {
+        for (size_t i = 0; i < records; i++)
+        {
+            const uint8_t *image = &images[i * CCalendarBatch::IMAGE_SIZE];
+            auto dec = [](const uint8_t b) { return (uint8_t)(((b >> 4) * 10) + (b & 0x0F)); };
+
+            epochs[i] = CRTC::Timestamp(dec(image[6]), dec(image[5] & 0x1F), dec(image[4]),
+                                        dec(image[2]), dec(image[1]), dec(image[0] & 0x7F)).epoch;
+        }
+    });
+
+    Measure("DecodeRegisters 1 thread", records, [&]()
+    {
+        CCalendarBatch::DecodeRegisters(images.data(), epochs.data(), records, 1);
+    });
+
+    Measure("DecodeRegisters", records, [&]()
+    {
+        CCalendarBatch::DecodeRegisters(images.data(), epochs.data(), records, threads);
+    });
+
+    Measure("ToCalendar", records, [&]()
+    {
+        CCalendarBatch::ToCalendar(epochs.data(), calendar.data(), records, threads);
+    });
+
+    Measure("WeekDays", records, [&]()
+    {
+        CCalendarBatch::WeekDays(epochs.data(), bytes.data(), records, threads);
+    });
+
+    Measure("DaysOfYear", records, [&]()
+    {
+        CCalendarBatch::DaysOfYear(epochs.data(), days.data(), records, threads);
+    });
+
+    Measure("ISOWeeks", records, [&]()
+    {
+        CCalendarBatch::ISOWeeks(epochs.data(), bytes.data(), records, threads);
+    });
+
+    return 0;
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        ClockServiceBenchmark.cpp
+ * @summary     Host reader scaling benchmark for CClockService
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+// Build on the host from the library root with
+//   g++ -std=gnu++11 -O2 -pthread -I. ClockService.cpp nRTC.cpp RTCBus.cpp
+//   extras/benchmark/ClockServiceBenchmark.cpp
+// Usage: clock_service_benchmark [max readers] [ms per step]
+
+#include "ClockService.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// Device that is never touched; snapshots are published directly
+class CIdleRTC : public CRTC
+{
+    public:
+    status_t GetRTC(RTC &rtc) { UNUSED(rtc); return STATUS_ERROR; }
+    status_t SetRTC(const RTC &rtc) { UNUSED(rtc); return STATUS_ERROR; }
+    status_t SetAlarmRTC(const RTC &rtc) { UNUSED(rtc); return STATUS_ERROR; }
+    status_t GetAlarmRTC(RTC &rtc) { UNUSED(rtc); return STATUS_ERROR; }
+    status_t SetAlarmState(const State state) { UNUSED(state); return STATUS_ERROR; }
+    State GetAlarmState(void) { return State::DISABLE; }
+    bool IsAlarmTriggered(void) { return false; }
+    status_t AlarmReset(void) { return STATUS_ERROR; }
+
+    protected:
+    uint8_t GetI2CAddress(void) { return 0; }
+};
+
+
+int main(int argc, char *argv[])
+{
+    unsigned max_threads = (argc > 1) ? atoi(argv[1]) : std::thread::hardware_concurrency();
+    unsigned duration_ms = (argc > 2) ? atoi(argv[2]) : 1000;
+    CIdleRTC rtc;
+    CClockService service(rtc);
+
+    printf("readers  reads/s/thread  reads/s total  publishes/s  torn\n");
+
+    for (unsigned readers = 1; readers <= max_threads; readers++)
+    {
+        std::atomic<bool> running{true};
+        std::atomic<uint64_t> reads{0};
+        std::atomic<uint64_t> torn{0};
+        uint64_t publishes = 0;
+        std::vector<std::thread> threads;
+
+        for (unsigned i = 0; i < readers; i++)
+        {
+            threads.emplace_back([&]()
+            {
+                uint64_t count = 0;
+                uint64_t errors = 0;
+                CClockService::Snapshot snapshot;
+
+                while (running.load(std::memory_order_relaxed))
+                {
+                    service.Read(snapshot);
+
+                    // Writer keeps tick = epoch * 1000, any mix is a torn read
+                    if (snapshot.tick != (snapshot.time.epoch * 1000))
+                    {
+                        errors++;
+                    }
+
+                    count++;
+                }
+
+                reads += count;
+                torn += errors;
+            });
+        }
+
+        // Publish as fast as possible to maximise contention
+        auto start = std::chrono::steady_clock::now();
+        auto end = start + std::chrono::milliseconds(duration_ms);
+
+        while (std::chrono::steady_clock::now() < end)
+        {
+            CClockService::Snapshot snapshot;
+
+            snapshot.time = CRTC::Timestamp((uint32_t)publishes);
+            snapshot.tick = (uint32_t)(publishes * 1000);
+            snapshot.status = CRTC::STATUS_OK;
+            service.Publish(snapshot);
+            publishes++;
+        }
+
+        running = false;
+
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+        double seconds = duration_ms / 1000.0;
+
+        printf("%7u  %14.0f  %13.0f  %11.0f  %4llu\n", readers,
+            reads / seconds / readers, reads / seconds, publishes / seconds,
+            (unsigned long long)torn.load());
+    }
+
+    return 0;
+}
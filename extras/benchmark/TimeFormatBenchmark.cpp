@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        TimeFormatBenchmark.cpp
+ * @summary     Host throughput of CTimeFormat against snprintf and strftime
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+// Build on the host from the library root with
+//   g++ -std=gnu++11 -O2 -I. TimeFormat.cpp nRTC.cpp RTCBus.cpp
+//   extras/benchmark/TimeFormatBenchmark.cpp
+// Usage: time_format_benchmark [iterations]
+
+#include "TimeFormat.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+static volatile uint32_t g_sink; // Keeps results observable to the optimizer
+
+template <typename F>
+static void Measure(const char *name, const uint32_t iterations, F function)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        g_sink = g_sink + function(i);
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+
+    printf("%-24s %8.1f ns/op\n", name, ns);
+}
+
+
+int main(int argc, char *argv[])
+{
+    uint32_t iterations = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 5000000;
+    static const uint32_t VALUES = 1024;
+    CRTC::RTC values[VALUES];
+    char text[VALUES][CTimeFormat::LENGTH_RFC3339 + 1];
+    char buffer[64];
+    const uint32_t span = CRTC::Timestamp(99, 12, 31, 23, 59, 59).epoch + 1;
+    uint32_t failures = 0;
+
+    // Spread of valid times so branch prediction sees realistic input
+    for (uint32_t i = 0; i < VALUES; i++)
+    {
+        int16_t offset = (int16_t)((i % 49) - 24) * 30;
+
+        CRTC::Timestamp((uint32_t)(((uint64_t)i * 7919UL * 3607UL) % span)).ToRTC(values[i]);
+        CTimeFormat::FormatRFC3339(values[i], offset, text[i]);
+
+        // Every input must survive a format and parse round trip
+        CRTC::RTC rtc;
+        int16_t parsed;
+
+        if ((CTimeFormat::ParseRFC3339(text[i], rtc, parsed) != CRTC::STATUS_OK)
+            || (rtc.year != values[i].year) || (rtc.month != values[i].month)
+            || (rtc.day != values[i].day) || (rtc.hour != values[i].hour)
+            || (rtc.minute != values[i].minute) || (rtc.second != values[i].second)
+            || (parsed != offset))
+        {
+            printf("FAIL: round trip of %s\n", text[i]);
+            failures++;
+        }
+    }
+
+    if (failures)
+    {
+        printf("FAILED (%u failures)\n", (unsigned)failures);
+        return 1;
+    }
+
+    Measure("CTimeFormat ISO 8601", iterations, [&](uint32_t i)
+    {
+        return CTimeFormat::FormatISO8601(values[i % VALUES], buffer) + buffer[18];
+    });
+
+    Measure("CTimeFormat RFC 3339", iterations, [&](uint32_t i)
+    {
+        return CTimeFormat::FormatRFC3339(values[i % VALUES], 120, buffer) + buffer[24];
+    });
+
+    Measure("CTimeFormat compact", iterations, [&](uint32_t i)
+    {
+        return CTimeFormat::FormatCompact(values[i % VALUES], buffer) + buffer[11];
+    });
+
+    Measure("snprintf ISO 8601", iterations, [&](uint32_t i)
+    {
+        const CRTC::RTC &rtc = values[i % VALUES];
+        return snprintf(buffer, sizeof(buffer), "20%02u-%02u-%02uT%02u:%02u:%02u",
+            rtc.year, rtc.month, rtc.day, rtc.hour, rtc.minute, rtc.second) + buffer[18];
+    });
+
+    Measure("strftime ISO 8601", iterations, [&](uint32_t i)
+    {
+        const CRTC::RTC &rtc = values[i % VALUES];
+        struct tm tm = {};
+
+        tm.tm_year = 100 + rtc.year;
+        tm.tm_mon = rtc.month - 1;
+        tm.tm_mday = rtc.day;
+        tm.tm_hour = rtc.hour;
+        tm.tm_min = rtc.minute;
+        tm.tm_sec = rtc.second;
+        return (int)strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", &tm) + buffer[18];
+    });
+
+    Measure("CTimeFormat parse", iterations, [&](uint32_t i)
+    {
+        CRTC::RTC rtc;
+        int16_t offset;
+
+        return CTimeFormat::ParseRFC3339(text[i % VALUES], rtc, offset) + rtc.second;
+    });
+
+    Measure("sscanf parse", iterations, [&](uint32_t i)
+    {
+        unsigned y, mo, d, h, mi, s, oh, om;
+        char sign;
+
+        return sscanf(text[i % VALUES], "%4u-%2u-%2uT%2u:%2u:%2u%c%2u:%2u",
+            &y, &mo, &d, &h, &mi, &s, &sign, &oh, &om) + (int)s;
+    });
+
+    return 0;
+}
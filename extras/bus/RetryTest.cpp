@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        RetryTest.cpp
+ * @summary     Bus retry, backoff, timeout and status reporting against failing transfers
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+// Build on the host from the library root with
+//   g++ -std=gnu++11 -O2 -I. DS323x.cpp nRTC.cpp RTCBus.cpp SimBus.cpp
+//   SimDS323x.cpp VirtualClock.cpp extras/bus/RetryTest.cpp
+// Backoff and timeout use the real millis()/delay(); runs in well under a second.
+
+#include "DS323x.h"
+#include "RTCPlatform.h"
+#include "SimDS323x.h"
+#include <cstdio>
+
+static CVirtualClock g_clock;
+static uint32_t g_failures = 0;
+static uint32_t g_recoveries = 0;
+
+
+static void Check(const bool condition, const char *message)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", message);
+        g_failures++;
+    }
+}
+
+
+static void OnRecovery(void)
+{
+    g_recoveries++;
+}
+
+
+// Fails the next given number of transfers in a row
+class CFailingBus : public CSimBus
+{
+    public:
+    uint32_t m_failing;
+    uint32_t m_attempts;
+
+    CFailingBus(void)
+        : m_failing{0}
+        , m_attempts{0}
+    {
+        // empty
+    }
+
+    uint8_t Write(const handle_t handle, const uint8_t reg, const uint8_t data[], const uint8_t bytes)
+    {
+        m_attempts++;
+        return Failing() ? 4 : CSimBus::Write(handle, reg, data, bytes);
+    }
+
+    uint8_t Read(const handle_t handle, const uint8_t reg, uint8_t data[], const uint8_t bytes)
+    {
+        m_attempts++;
+        return Failing() ? 4 : CSimBus::Read(handle, reg, data, bytes);
+    }
+
+    void Fail(const uint32_t transfers)
+    {
+        m_failing = transfers;
+        m_attempts = 0;
+    }
+
+    protected:
+    bool Failing(void)
+    {
+        if (m_failing == 0)
+        {
+            return false;
+        }
+
+        m_failing--;
+        return true;
+    }
+};
+
+
+int main(void)
+{
+    CFailingBus bus;
+    CSimDS323x chip(g_clock);
+    CDS3231 rtc;
+    CRTC::RTC time;
+
+    bus.Attach(chip);
+    g_clock.Attach(chip);
+    rtc.SetBus(bus);
+    rtc.Initialize();
+    rtc.SetBusRecovery(OnRecovery);
+    Check(rtc.GetRTC(time) == CRTC::STATUS_OK, "clean read");
+
+    // One injected failure is absorbed by a retry
+    g_recoveries = 0;
+    bus.InjectFailure(0);
+    Check(rtc.GetRTC(time) == CRTC::STATUS_OK, "retry after a single failure");
+    Check(g_recoveries == 1, "recovery hook called once");
+    printf("single failure: OK after retry, %u recovery\n", g_recoveries);
+
+    // Persistent failure: default 2 retries, then stale cached time
+    g_recoveries = 0;
+    bus.Fail(10);
+    uint32_t start = micros();
+    CRTC::status_t status = rtc.GetRTC(time);
+    uint32_t elapsed = (micros() - start);
+
+    Check(status == CRTC::STATUS_STALE, "stale time after retries");
+    Check(rtc.GetStatus() == CRTC::STATUS_BUS_ERROR, "bus error after retries");
+    Check(bus.m_attempts == 3, "three attempts");
+    Check(g_recoveries == 2, "recovery before each retry");
+    Check(elapsed >= 300, "100 + 200 us backoff");
+    printf("persistent failure: %u attempts, %u us, status %u\n", bus.m_attempts, elapsed, rtc.GetStatus());
+
+    // Status-returning getters report the failure and keep the output
+    CRTC::State state = CRTC::State::ENABLE;
+    bool triggered = true;
+    float temperature = -99.0f;
+    int8_t offset = 42;
+
+    bus.Fail(100);
+    Check(rtc.GetAlarmState(state) == CRTC::STATUS_BUS_ERROR, "alarm state reports failure");
+    Check(rtc.IsAlarmTriggered(triggered) == CRTC::STATUS_BUS_ERROR, "alarm flag reports failure");
+    Check(rtc.GetTemperature(temperature) == CRTC::STATUS_BUS_ERROR, "temperature reports failure");
+    Check(rtc.GetAgingOffset(offset) == CRTC::STATUS_BUS_ERROR, "aging offset reports failure");
+    Check((state == CRTC::State::ENABLE) && triggered && (temperature == -99.0f) && (offset == 42),
+        "outputs unchanged on failure");
+
+    // Through the base class too
+    CRTC &base = rtc;
+    Check(base.IsAlarmTriggered(triggered) == CRTC::STATUS_BUS_ERROR, "virtual overload reports failure");
+
+    bus.Fail(0);
+    Check((rtc.IsAlarmTriggered(triggered) == CRTC::STATUS_OK) && !triggered, "flag read after recovery");
+
+    // Re-initializing reuses the bus handle instead of filling the table
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        rtc.Initialize();
+    }
+
+    Check(rtc.GetRTC(time) == CRTC::STATUS_OK, "read after repeated Initialize");
+
+    // Long backoff is clamped to the time budget
+    rtc.SetRetry(255, 20000, 30);
+    bus.Fail(1000);
+    start = millis();
+    status = rtc.GetRTC(time);
+    elapsed = (millis() - start);
+
+    Check(rtc.GetStatus() == CRTC::STATUS_TIMEOUT, "timeout status");
+    Check((elapsed >= 30) && (elapsed < 40), "budget kept across a 20 ms backoff");
+    Check(bus.m_attempts == 2, "no attempt after the budget ran out");
+    printf("timeout: %u attempts, %u ms of a 30 ms budget, status %u\n", bus.m_attempts, elapsed, rtc.GetStatus());
+
+    printf("%s (%u failures)\n", g_failures ? "FAILED" : "PASSED", g_failures);
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        DriftCalibrationTest.cpp
+ * @summary     Drift estimate from a recorded DS3231 session, replayed from its trace
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+// Build on the host from the library root with
+//   g++ -std=gnu++11 -O2 -I. DS323x.cpp nRTC.cpp RTCBus.cpp SimBus.cpp
+//   SimDS323x.cpp TraceBus.cpp VirtualClock.cpp DriftCalibration.cpp
+//   extras/calibration/DriftCalibrationTest.cpp
+
+#include "DriftCalibration.h"
+#include "SimDS323x.h"
+#include "TraceBus.h"
+#include <cstdio>
+
+static const uint32_t SAMPLES = 16;
+static const uint32_t DRIFT_PPM = 5;        // RTC fast against the reference
+static const uint64_t POLL_US = 1000;       // Virtual time per reference read
+static const uint32_t LOG_SIZE = 40000;
+
+static CVirtualClock g_clock;
+static uint8_t g_trace[1UL << 20];
+static uint32_t g_size = 0;
+static uint64_t g_log[LOG_SIZE];            // Reference readings, in call order
+static uint32_t g_logged = 0;
+static uint32_t g_replayed = 0;
+static bool g_replay = false;
+static uint32_t g_failures = 0;
+
+
+static void Check(const bool condition, const char *message)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", message);
+        g_failures++;
+    }
+}
+
+
+// DS3231 model with a settable temperature register
+class CThermalDS323x : public CSimDS323x
+{
+    public:
+    CThermalDS323x(CVirtualClock &clock)
+        : CSimDS323x(clock)
+    {
+        // empty
+    }
+
+    void SetTemperature(const float celsius)
+    {
+        int16_t quarters = (int16_t)(celsius * 4);
+
+        m_register[ADDRESS_TEMPERATURE] = (uint8_t)(quarters >> 2);
+        m_register[ADDRESS_TEMPERATURE + 1] = (uint8_t)((quarters & 0x03) << 6);
+    }
+
+    uint8_t GetAgingRegister(void)
+    {
+        return m_register[0x10];
+    }
+};
+
+
+static void Sink(const uint8_t data[], const uint8_t bytes)
+{
+    for (uint8_t i = 0; (i < bytes) && (g_size < sizeof(g_trace)); i++)
+    {
+        g_trace[g_size++] = data[i];
+    }
+}
+
+
+static uint32_t Tick(void)
+{
+    return (uint32_t)g_clock.Now();
+}
+
+
+// Live: a slow reference against the virtual time. Replay: the log.
+static uint64_t Reference(void)
+{
+    if (g_replay)
+    {
+        return (g_replayed < g_logged) ? g_log[g_replayed++] : UINT64_MAX;
+    }
+
+    g_clock.Step(POLL_US);
+
+    uint64_t now = g_clock.Now();
+    uint64_t reference = (now / 1000) - ((now * DRIFT_PPM) / 1000000000ULL);
+
+    if (g_logged < LOG_SIZE)
+    {
+        g_log[g_logged++] = reference;
+    }
+
+    return reference;
+}
+
+
+static bool Session(CDriftCalibration &calibration, const bool live, float &ppm)
+{
+    for (uint32_t i = 0; i < SAMPLES; i++)
+    {
+        if (calibration.AddSample() != CRTC::STATUS_OK)
+        {
+            return false;
+        }
+
+        if (live)
+        {
+            g_clock.Step(3600000000ULL);
+        }
+    }
+
+    return (calibration.GetDrift(ppm) == CRTC::STATUS_OK);
+}
+
+
+int main(void)
+{
+    CSimBus bus;
+    CThermalDS323x chip(g_clock);
+    CTraceBus trace(bus, Sink, Tick);
+    CDS3231 rtc;
+    float recorded = 0;
+    float replayed = 0;
+    uint8_t aging;
+
+    bus.Attach(chip);
+    g_clock.Attach(chip);
+    chip.SetTemperature(-5.25f);
+    rtc.SetBus(trace);
+    trace.Start();
+    rtc.Initialize();
+    rtc.SetAgingOffset(0);
+
+    // Record a cold, isothermal session and correct the aging offset
+    {
+        CDriftCalibration calibration(rtc, Reference);
+
+        Check(Session(calibration, true, recorded), "recorded estimate");
+        Check(calibration.Calibrate() == CRTC::STATUS_OK, "recorded calibration");
+        trace.Stop();
+
+        aging = chip.GetAgingRegister();
+        Check((recorded > 4.9f) && (recorded < 5.1f), "5 ppm fast");
+        Check(aging == 50, "aging offset trimmed by 50 LSB");
+        printf("recorded: %.3f ppm at -5.25 C, aging %d, %u trace bytes, %u reference reads\n",
+            recorded, (int8_t)aging, g_size, g_logged);
+    }
+
+    // Replay the trace and reference log; the estimate must be identical
+    {
+        CReplayBus replay(g_trace, g_size);
+        CDS3231 player;
+        CDriftCalibration calibration(player, Reference);
+
+        g_replay = true;
+        player.SetBus(replay);
+        player.Initialize();
+        player.SetAgingOffset(0);
+
+        Check(Session(calibration, false, replayed), "replayed estimate");
+        Check(replayed == recorded, "replay reproduces the estimate");
+        Check(calibration.Calibrate() == CRTC::STATUS_OK, "replayed calibration");
+        Check(replay.GetDivergences() == 0, "replay writes the same aging offset");
+        Check(replay.IsFinished(), "replay consumed the trace");
+        printf("replayed: %.3f ppm, %u transfers, %u divergences\n",
+            replayed, replay.GetTransfers(), replay.GetDivergences());
+        g_replay = false;
+    }
+
+    // -3.75 C rounds to -4, so swinging to +0.25 C is a 4 C spread
+    {
+        CDriftCalibration calibration(rtc, Reference);
+        float ppm = 0;
+
+        rtc.SetBus(bus);
+
+        for (uint32_t i = 0; i < SAMPLES; i++)
+        {
+            chip.SetTemperature((i & 1) ? 0.25f : -3.75f);
+            Check(calibration.AddSample() == CRTC::STATUS_OK, "sample");
+            g_clock.Step(3600000000ULL);
+        }
+
+        Check(calibration.GetDrift(ppm) != CRTC::STATUS_OK, "window across 4 C rejected");
+        printf("spread: -3.75 C and +0.25 C window %s\n",
+            (calibration.GetDrift(ppm) == CRTC::STATUS_OK) ? "accepted" : "rejected");
+    }
+
+    // Hourly steps repeat the same rollover phase, so every window holds the
+    // same offsets and a year on must give the first day's estimate
+    {
+        CDriftCalibration calibration(rtc, Reference);
+        float first = 0;
+        float last = 0;
+        bool sampled = true;
+
+        chip.SetTemperature(20.0f);
+
+        for (uint32_t i = 0; i < (365 * 24); i++)
+        {
+            sampled &= (calibration.AddSample() == CRTC::STATUS_OK);
+            g_clock.Step(3600000000ULL);
+
+            if (i == (SAMPLES - 1))
+            {
+                calibration.GetDrift(first);
+            }
+        }
+
+        Check(sampled, "year of samples");
+        Check(calibration.GetDrift(last) == CRTC::STATUS_OK, "estimate after a year");
+        Check((last - first < 1.0e-5f) && (first - last < 1.0e-5f), "estimate keeps its resolution");
+        printf("long run: %.6f ppm after a day, %.6f ppm after a year\n", first, last);
+    }
+
+    printf("%s (%u failures)\n", g_failures ? "FAILED" : "PASSED", g_failures);
+    return g_failures ? 1 : 0;
+}
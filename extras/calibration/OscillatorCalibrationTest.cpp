@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        OscillatorCalibrationTest.cpp
+ * @summary     Oscillator calibration against a simulated skewed RC oscillator
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+// Build on the host from the library root with
+//   g++ -std=gnu++11 -O2 -I. DS323x.cpp nRTC.cpp RTCBus.cpp SimBus.cpp
+//   SimDS323x.cpp VirtualClock.cpp OscillatorCalibration.cpp
+//   extras/calibration/OscillatorCalibrationTest.cpp
+// Usage: oscillator_calibration_test [trials] [seed]
+
+#include "DS323x.h"
+#include "OscillatorCalibration.h"
+#include "SimDS323x.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+static const uint32_t NOMINAL = 8000000;   // Hz
+static const uint32_t REFERENCE = 32768;   // Hz
+
+static CVirtualClock g_clock;
+static CSimDS323x *g_chip = nullptr;
+static uint32_t g_state = 1;
+static double g_skew = 0;   // Process variation of this part
+static uint8_t g_trim = 0;
+static uint32_t g_gates = 0;
+
+
+static uint32_t Random(const uint32_t range)
+{
+    // xorshift32
+    g_state ^= (g_state << 13);
+    g_state ^= (g_state >> 17);
+    g_state ^= (g_state << 5);
+    return (g_state % range);
+}
+
+
+static double Frequency(const uint8_t trim)
+{
+    // Monotonic but uneven steps of roughly 0.4%, like the ATmega328P OSCCAL
+    double x = (trim / 127.0);
+    return NOMINAL * (1 + g_skew) * (0.75 + (0.4 * x) + (0.1 * x * x));
+}
+
+
+static void Trim(const uint8_t trim)
+{
+    g_trim = trim;
+}
+
+
+static uint32_t Capture(const uint32_t periods)
+{
+    uint8_t status;
+
+    // The reference pin only toggles while the 32kHz output is enabled
+    g_chip->Read(0x0F, &status, 1);
+
+    if (!(status & 0x08))
+    {
+        return 0;
+    }
+
+    g_gates++;
+    g_clock.Step(((uint64_t)periods * 1000000) / REFERENCE);
+
+    // One tick of capture jitter
+    return (uint32_t)((Frequency(g_trim) * periods) / REFERENCE) + Random(2);
+}
+
+
+int main(int argc, char *argv[])
+{
+    uint32_t trials = (argc > 1) ? strtoul(argv[1], nullptr, 0) : 1000;
+    uint32_t failures = 0;
+    int32_t worst = 0;
+
+    g_state = (argc > 2) ? strtoul(argv[2], nullptr, 0) : 1;
+
+    CSimDS323x chip(g_clock);
+    CSimBus bus;
+    CDS3231 rtc;
+
+    g_chip = &chip;
+    bus.Attach(chip);
+    g_clock.Attach(chip);
+    rtc.SetBus(bus);
+    rtc.Initialize(); // Turns the 32kHz output off
+
+    COscillatorCalibration calibration(rtc, Capture, Trim, NOMINAL);
+
+    for (uint32_t i = 0; i < trials; i++)
+    {
+        uint8_t trim = 64;
+        uint8_t status;
+
+        g_skew = ((int32_t)Random(2001) - 1000) / 10000.0; // +-10%
+        g_gates = 0;
+
+        CRTC::status_t result = calibration.Calibrate(trim);
+        chip.Read(0x0F, &status, 1);
+
+        // Best trim by exhaustive search
+        uint8_t best = 0;
+
+        for (uint8_t t = 1; t <= 127; t++)
+        {
+            if (fabs(Frequency(t) - NOMINAL) < fabs(Frequency(best) - NOMINAL))
+            {
+                best = t;
+            }
+        }
+
+        // Jitter may pick a neighbour when the two are nearly equidistant
+        bool reachable = (Frequency(0) <= NOMINAL) && (Frequency(127) >= NOMINAL);
+        bool correct = !reachable || (abs((int)trim - (int)best) <= 1);
+
+        if ((result != CRTC::STATUS_OK) || (status & 0x08) || (g_trim != trim) || !correct)
+        {
+            printf("FAIL skew %+.2f%% status %d trim %u best %u output %d\n",
+                g_skew * 100, result, trim, best, !!(status & 0x08));
+            failures++;
+        }
+
+        if (reachable && (abs(calibration.GetError()) > abs(worst)))
+        {
+            worst = calibration.GetError();
+        }
+    }
+
+    printf("%u trials, %u failures, %u gates per calibration, worst %+d ppm\n",
+        trials, failures, g_gates, worst);
+
+    return (failures > 0) ? 1 : 0;
+}
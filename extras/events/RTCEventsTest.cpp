@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        RTCEventsTest.cpp
+ * @summary     End to end test of RTC event descriptors against the simulated DS3231
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+// Build on the host (Linux) from the library root with
+//   g++ -std=gnu++11 -O2 -I. DS323x.cpp nRTC.cpp RTCBus.cpp SimBus.cpp
+//   SimDS323x.cpp VirtualClock.cpp RTCEvents.cpp extras/events/RTCEventsTest.cpp
+// Runs in about two seconds; the last part follows wall time.
+
+#include "DS323x.h"
+#include "RTCEvents.h"
+#include "SimDS323x.h"
+#include <chrono>
+#include <cstdio>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+static const uint64_t SECOND = 1000000;
+
+static CVirtualClock g_clock;
+static CRTCEvents *g_events = nullptr;
+static uint32_t g_failures = 0;
+
+
+static void OnInterrupt(const uint64_t time)
+{
+    (void)time;
+    g_events->OnAlarmEdge();
+}
+
+
+static void OnSquareWave(const uint64_t time)
+{
+    (void)time;
+    g_events->OnTickEdge();
+}
+
+
+static void Check(const bool condition, const char *message)
+{
+    printf("%s %s\n", condition ? "ok  " : "FAIL", message);
+    g_failures += condition ? 0 : 1;
+}
+
+
+static int Watch(CRTCEvents &events)
+{
+    int loop = epoll_create1(EPOLL_CLOEXEC);
+    const CRTCEvents::Event list[] = {CRTCEvents::Event::ALARM, CRTCEvents::Event::TICK, CRTCEvents::Event::TIMESTAMP};
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        struct epoll_event event = {};
+
+        event.events = EPOLLIN;
+        event.data.u32 = i;
+        epoll_ctl(loop, EPOLL_CTL_ADD, events.GetDescriptor(list[i]), &event);
+    }
+
+    return loop;
+}
+
+
+static uint64_t GetWallMicros(void)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+int main(void)
+{
+    CSimDS323x chip(g_clock);
+    CSimBus bus;
+    CDS3231 rtc;
+    CRTC::RTC now;
+    struct epoll_event ready[4];
+
+    bus.Attach(chip);
+    g_clock.Attach(chip);
+    chip.SetInterruptCallback(OnInterrupt);
+    chip.SetSquareWaveCallback(OnSquareWave);
+    rtc.SetBus(bus);
+    rtc.Initialize();
+
+    // Daily alarm on the INT line over three simulated days
+    {
+        CRTCEvents events(rtc);
+        uint32_t alarms = 0;
+        bool on_time = true;
+
+        g_events = &events;
+        Check(events.Open(CRTCEvents::Source::PIN), "open pin source");
+
+        CRTC::Timestamp(26, 10, 19, 6, 59, 0).ToRTC(now);
+        rtc.SetRTC(now);
+        rtc.SetAlarmTime(7, 0, 0);
+
+        int loop = Watch(events);
+        uint32_t transfers = bus.GetTransfers();
+
+        for (uint32_t minute = 0; minute < (3 * 24 * 60); minute++)
+        {
+            g_clock.Step(60 * SECOND);
+
+            for (int n = epoll_wait(loop, ready, 4, 0), i = 0; i < n; i++)
+            {
+                if (events.Acknowledge(CRTCEvents::Event::ALARM) > 0)
+                {
+                    uint32_t epoch = chip.GetEpoch() % 86400;
+
+                    on_time &= ((epoch >= (7 * 3600)) && (epoch < ((7 * 3600) + 60)));
+                    alarms++;
+                }
+            }
+        }
+
+        Check(alarms == 3, "one alarm per day");
+        Check(on_time, "alarm delivered in the minute it fired");
+        Check((bus.GetTransfers() - transfers) == (2 * alarms), "bus used only to clear the flag");
+        close(loop);
+    }
+
+    // 1 Hz SQW ticks carrying the epoch, no bus traffic per tick
+    {
+        CRTCEvents events(rtc);
+        uint32_t epoch = 0;
+        uint32_t records = 0;
+        bool sequential = true;
+
+        g_events = &events;
+        events.Open(CRTCEvents::Source::PIN);
+        rtc.SetSquareWave(true, 0);
+        events.Synchronize();
+
+        uint32_t start = chip.GetEpoch();
+        uint32_t transfers = bus.GetTransfers();
+
+        g_clock.Step(100 * SECOND);
+
+        for (uint32_t value; events.ReadTimestamp(value); records++)
+        {
+            sequential &= (value == (start + records + 1));
+            epoch = value;
+        }
+
+        Check(events.Acknowledge(CRTCEvents::Event::TICK) == 100, "100 ticks counted");
+        Check((records == 100) && sequential, "100 sequential timestamps");
+        Check(epoch == chip.GetEpoch(), "last timestamp matches the chip");
+        Check(bus.GetTransfers() == transfers, "no bus traffic while ticking");
+        rtc.SetSquareWave(false, 0);
+    }
+
+    // Predicted alarm on a timerfd, virtual clock following wall time
+    {
+        CRTCEvents events(rtc);
+        uint64_t origin = g_clock.Now();
+        uint64_t wall = GetWallMicros();
+        uint64_t fired = 0;
+        uint32_t polls = 0;
+
+        g_events = &events;
+        events.Open(CRTCEvents::Source::TIMER);
+
+        CRTC::Timestamp(26, 10, 19, 7, 59, 59).ToRTC(now);
+        rtc.SetRTC(now);
+        rtc.SetAlarmTime(8, 0, 1);
+        Check(events.ArmAlarm() == CRTC::STATUS_OK, "arm timer");
+
+        int loop = Watch(events);
+        uint32_t transfers = bus.GetTransfers();
+
+        while ((fired == 0) && ((GetWallMicros() - wall) < (4 * SECOND)))
+        {
+            int n = epoll_wait(loop, ready, 4, 5);
+
+            g_clock.StepTo(origin + (GetWallMicros() - wall));
+            polls++;
+
+            if ((n > 0) && (events.Acknowledge(CRTCEvents::Event::ALARM) > 0))
+            {
+                fired = (g_clock.Now() - origin);
+            }
+        }
+
+        // Alarm second began 2 s in; without tick edges the timer may be a second late
+        Check((fired >= (2 * SECOND)) && (fired < ((3 * SECOND) + (SECOND / 10))), "timer alarm within a second");
+        Check((bus.GetTransfers() - transfers) <= 16, "bus used only to confirm and re-arm");
+        printf("     fired after %.3f s, %u transfers over %u loop passes\n",
+            fired / 1e6, bus.GetTransfers() - transfers, polls);
+        close(loop);
+    }
+
+    return (g_failures > 0) ? 1 : 0;
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        LinuxI2CBusTest.cpp
+ * @summary     Linux I2C_RDWR message packing routed into the DS3232 model
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+// Build on Linux from the library root with
+//   g++ -std=gnu++11 -O2 -I. DS323x.cpp nRTC.cpp RTCBus.cpp SimBus.cpp
+//   SimDS323x.cpp VirtualClock.cpp extras/linux/LinuxI2CBusTest.cpp
+// No adapter is opened; Transfer() hands the messages to the model.
+
+#include "DS323x.h"
+#include "SimDS323x.h"
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include <cstdio>
+#include <cstring>
+
+static uint32_t g_failures = 0;
+
+
+static void Check(const bool condition, const char *message)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", message);
+        g_failures++;
+    }
+}
+
+
+// Unpacks I2C_RDWR messages the way the adapter would put them on the wire
+class CRoutedI2CBus : public CLinuxI2CBus
+{
+    public:
+    CSimDevice &m_device;
+    uint32_t m_writes;      // Single message register writes
+    uint32_t m_reads;       // Pointer write, repeated start, read
+    uint32_t m_malformed;
+
+    CRoutedI2CBus(CSimDevice &device)
+        : m_device(device)
+        , m_writes{0}
+        , m_reads{0}
+        , m_malformed{0}
+    {
+        // empty
+    }
+
+    protected:
+    int Transfer(i2c_rdwr_ioctl_data &transfer)
+    {
+        i2c_msg *message = transfer.msgs;
+
+        if (message[0].addr != m_device.GetAddress())
+        {
+            return -1; // Address NACK
+        }
+
+        if ((transfer.nmsgs == 1) && (message[0].flags == 0) && (message[0].len >= 1))
+        {
+            m_writes++;
+            return m_device.Write(message[0].buf[0], &message[0].buf[1], (message[0].len - 1)) ? -1 : 1;
+        }
+
+        if ((transfer.nmsgs == 2) && (message[0].flags == 0) && (message[0].len == 1)
+            && (message[1].addr == message[0].addr) && (message[1].flags == I2C_M_RD))
+        {
+            m_reads++;
+            return m_device.Read(message[0].buf[0], message[1].buf, message[1].len) ? -1 : 2;
+        }
+
+        m_malformed++;
+        return -1;
+    }
+};
+
+
+int main(void)
+{
+    CVirtualClock clock;
+    CSimDS323x chip(clock);
+    CRoutedI2CBus bus(chip);
+    CDS3232 rtc;
+    CRTC::RTC time;
+    CRTC::RTC read;
+    uint8_t sram[200];
+    uint8_t echo[sizeof(sram)];
+
+    clock.Attach(chip);
+    rtc.SetBus(bus);
+
+    // Re-initializing must reuse the handle, not exhaust the table
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        rtc.Initialize();
+    }
+
+    Check(bus.RegisterDevice(DS323xMap::I2C, CRTCBus::Speed::FAST) == 0, "one handle per device");
+    Check(bus.RegisterDevice(0x57, CRTCBus::Speed::FAST) == 1, "second device gets a new handle");
+
+    time.year = 26;
+    time.month = 10;
+    time.day = 19;
+    time.hour = 23;
+    time.minute = 59;
+    time.second = 58;
+
+    Check(rtc.SetRTC(time) == CRTC::STATUS_OK, "set time");
+    clock.Step(3000000ULL);
+    Check(rtc.GetRTC(read) == CRTC::STATUS_OK, "get time");
+    Check((read.year == 26) && (read.month == 10) && (read.day == 20)
+        && (read.hour == 0) && (read.minute == 0) && (read.second == 1), "time round trip across midnight");
+    printf("time: 2026-10-19 23:59:58 + 3 s -> 20%02u-%02u-%02u %02u:%02u:%02u\n",
+        read.year, read.month, read.day, read.hour, read.minute, read.second);
+
+    for (uint16_t i = 0; i < sizeof(sram); i++)
+    {
+        sram[i] = (uint8_t)((i * 37) + 11);
+    }
+
+    memset(echo, 0, sizeof(echo));
+    Check(rtc.SetSRAM(0, sram, sizeof(sram)) == CRTC::STATUS_OK, "write SRAM");
+    Check(rtc.GetSRAM(0, echo, sizeof(echo)) == CRTC::STATUS_OK, "read SRAM");
+    Check(memcmp(sram, echo, sizeof(sram)) == 0, "SRAM round trip");
+
+    Check(bus.m_malformed == 0, "every transfer packed as a write or a combined read");
+    printf("transfers: %u writes, %u combined reads, %u malformed\n", bus.m_writes, bus.m_reads, bus.m_malformed);
+
+    printf("%s (%u failures)\n", g_failures ? "FAILED" : "PASSED", g_failures);
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        ColdStartTest.cpp
+ * @summary     PCF2129 cold start defaults from compile time literals
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+// Build on the host from the library root with
+//   g++ -std=gnu++11 -O2 -I. PCF2129.cpp nRTC.cpp RTCBus.cpp SimBus.cpp
+//   extras/literal/ColdStartTest.cpp
+// Each reset waits out the oscillator start-up delays (about 2 s).
+
+#include "PCF2129.h"
+#include "SimBus.h"
+#include <cstdio>
+#include <cstring>
+
+static uint32_t g_failures = 0;
+
+static constexpr TimeImage<PCF2129Map> DEFAULT_TIME = "2000-01-01T00:00:00"_rtc;
+
+static void Check(const bool condition, const char *message)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", message);
+        g_failures++;
+    }
+}
+
+
+static void Run(const char *name, const uint8_t power_on[], const bool reset)
+{
+    uint8_t registers[0x20];
+    CSimRegisterDevice device(PCF2129Map::I2C, registers, sizeof(registers));
+    CSimBus bus;
+    CPCF2129 rtc;
+
+    memcpy(registers, power_on, sizeof(registers));
+    bus.Attach(device);
+    rtc.SetBus(bus);
+    rtc.Initialize();
+
+    bool written = (memcmp(&registers[PCF2129Map::TIME], DEFAULT_TIME.data, sizeof(DEFAULT_TIME.data)) == 0);
+    bool alarm = (registers[0x0A] == 0x00) && (registers[0x0B] == 0x00) && (registers[0x0C] == 0x00);
+    bool refreshed = (registers[0x0F] == 0x27);
+    CRTC::RTC time;
+
+    printf("%-22s default time %s, alarm %s, OTP refresh %s\n", name,
+        written ? "yes" : "no", alarm ? "yes" : "no", refreshed ? "yes" : "no");
+
+    Check(written == reset, name);
+    Check(alarm == reset, name);
+    Check(refreshed == reset, name);
+    Check(rtc.GetRTC(time) == CRTC::STATUS_OK, "time valid after Initialize");
+}
+
+
+int main(void)
+{
+    uint8_t registers[0x20];
+
+    // Oscillator stop flag set, fields in range
+    memset(registers, 0, sizeof(registers));
+    registers[0x03] = 0x80;
+    registers[0x04] = 0x12;
+    registers[0x06] = 0x05;
+    registers[0x07] = 0x02;
+    registers[0x08] = 0x03;
+    registers[0x09] = 0x26;
+    registers[0x0A] = 0x45;
+    Run("OSF set", registers, true);
+
+    // Undefined power-on contents with the flag clear
+    memset(registers, 0x5A, sizeof(registers));
+    registers[0x03] = 0x3F;
+    registers[0x08] = 0x1F;
+    Run("garbage registers", registers, true);
+
+    // Running chip keeps its time and alarm
+    memset(registers, 0, sizeof(registers));
+    registers[0x03] = 0x30;
+    registers[0x04] = 0x15;
+    registers[0x05] = 0x09;
+    registers[0x06] = 0x17;
+    registers[0x07] = 0x06;
+    registers[0x08] = 0x10;
+    registers[0x09] = 0x26;
+    registers[0x0A] = 0x45;
+    Run("running", registers, false);
+
+    printf("%s (%u failures)\n", g_failures ? "FAILED" : "PASSED", g_failures);
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        RegisterMapTest.cpp
+ * @summary     Encode, decode and time image round trips for every register map
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+// Build on the host from the library root with
+//   g++ -std=gnu++11 -O2 -I. DS1307.cpp DS323x.cpp MCP7940N.cpp PCF2129.cpp
+//   PCF85263.cpp nRTC.cpp RTCBus.cpp SimBus.cpp extras/map/RegisterMapTest.cpp
+
+#include "DS1307.h"
+#include "DS323x.h"
+#include "MCP7940N.h"
+#include "PCF2129.h"
+#include "PCF85263.h"
+#include "SimBus.h"
+#include <cstdio>
+#include <cstring>
+
+static uint32_t g_failures = 0;
+
+// Compile-time images follow the map's field order and flag bits
+static constexpr TimeImage<DS323xMap> DS323X_IMAGE = "2026-10-19T06:30:45"_rtc;
+static constexpr TimeImage<PCF2129Map> PCF2129_IMAGE = "2026-10-19T06:30:45"_rtc;
+static constexpr TimeImage<MCP7940NMap> MCP7940N_IMAGE = "2026-10-19T06:30:45"_rtc;
+
+static_assert((DS323X_IMAGE.data[0] == 0x45) && (DS323X_IMAGE.data[3] == 0x02) && (DS323X_IMAGE.data[4] == 0x19),
+    "DS323x image: seconds first, Monday = 2, then day");
+static_assert((PCF2129_IMAGE.data[3] == 0x19) && (PCF2129_IMAGE.data[4] == 0x01),
+    "PCF2129 image: day before week day, Monday = 1");
+static_assert((MCP7940N_IMAGE.data[0] == (0x45 | 0x80)) && (MCP7940N_IMAGE.data[3] == (0x02 | 0x08)),
+    "MCP7940N image: ST and VBATEN set");
+
+
+static void Check(const bool condition, const char *message)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", message);
+        g_failures++;
+    }
+}
+
+
+// Exposes the generated encode and decode of a driver's map
+template <typename Driver, typename Map>
+class CProbe : public Driver
+{
+    public:
+    using CMappedRTC<Map>::Encode;
+    using CMappedRTC<Map>::Decode;
+};
+
+
+template <typename Driver, typename Map>
+static void RoundTrip(const char *name)
+{
+    CProbe<Driver, Map> probe;
+    uint32_t checked = 0;
+    uint32_t errors = g_failures;
+
+    // Every 97 minutes and 13 seconds across the century, plus the last second
+    for (uint32_t epoch = 0; ; epoch += 5833UL)
+    {
+        if (epoch >= 3155759999UL)
+        {
+            epoch = 3155759999UL; // 2099-12-31T23:59:59
+        }
+
+        CRTC::Timestamp time(epoch);
+        TimeImage<Map> image(time);
+        CRTC::RTC rtc;
+        CRTC::RTC decoded;
+        uint8_t data[CMappedRTC<Map>::TIME_BYTES];
+
+        time.ToRTC(rtc);
+        probe.Encode(rtc, data);
+        Check(memcmp(data, image.data, sizeof(data)) == 0, "Encode matches TimeImage");
+
+        // A running oscillator reports its run bit
+        data[Map::WEEK_DAY] |= Map::RUN_MASK;
+        Check(probe.Decode(data, decoded, false) == CRTC::STATUS_OK, "Decode status");
+        Check(CRTC::Timestamp(decoded).epoch == epoch, "Decode returns the encoded time");
+        Check(decoded.week_day == time.WeekDay(), "Decode week day");
+
+        // A stopped oscillator is reported whatever the time
+        Check(probe.Decode(data, decoded, true) == CRTC::STATUS_HALTED, "Decode halted");
+
+        if ((Map::HALT_MASK != 0) || (Map::RUN_MASK != 0))
+        {
+            data[Map::SECOND] |= Map::HALT_MASK;
+            data[Map::WEEK_DAY] &= ~Map::RUN_MASK;
+            Check(probe.Decode(data, decoded, false) == CRTC::STATUS_HALTED, "Decode map halt bit");
+        }
+
+        checked++;
+
+        if (epoch == 3155759999UL)
+        {
+            break;
+        }
+
+        if ((g_failures - errors) > 8)
+        {
+            break; // One broken map need not flood the output
+        }
+    }
+
+    printf("%-10s %u times round trip\n", name, checked);
+}
+
+
+// Time and SRAM in one burst where the map allows, two reads beyond it
+static void Snapshot(void)
+{
+    uint8_t registers[0x40];
+    CSimRegisterDevice device(DS1307Map::I2C, registers, sizeof(registers));
+    CSimBus bus;
+    CDS1307 rtc;
+    CRTC::RTC time;
+    uint8_t data[40];
+    uint32_t transfers;
+
+    memset(registers, 0, sizeof(registers));
+    memcpy(registers, TimeImage<DS1307Map>("2026-10-19T06:30:45"_rtc).data, 7);
+
+    for (uint8_t i = 0; i < DS1307Map::SRAM_SIZE; i++)
+    {
+        registers[DS1307Map::SRAM + i] = (i ^ 0x5A);
+    }
+
+    bus.Attach(device);
+    rtc.SetBus(bus);
+    rtc.Initialize();
+
+    transfers = bus.GetTransfers();
+    Check(rtc.GetRTCAndSRAM(time, 4, data, 16) == CRTC::STATUS_OK, "short snapshot");
+    Check(bus.GetTransfers() == (transfers + 1), "short snapshot in one burst");
+    Check((time.hour == 6) && (time.minute == 30) && (time.second == 45), "short snapshot time");
+    Check((data[0] == (4 ^ 0x5A)) && (data[15] == (19 ^ 0x5A)), "short snapshot SRAM");
+
+    transfers = bus.GetTransfers();
+    Check(rtc.GetRTCAndSRAM(time, 10, data, 40) == CRTC::STATUS_OK, "long snapshot");
+    Check(bus.GetTransfers() == (transfers + 2), "long snapshot in two reads");
+    Check((time.hour == 6) && (data[0] == (10 ^ 0x5A)) && (data[39] == (49 ^ 0x5A)), "long snapshot contents");
+    printf("snapshot: one burst within the window, two reads beyond\n");
+}
+
+
+int main(void)
+{
+    RoundTrip<CDS3231, DS323xMap>("DS323x");
+    RoundTrip<CDS1307, DS1307Map>("DS1307");
+    RoundTrip<CPCF2129, PCF2129Map>("PCF2129");
+    RoundTrip<CPCF85263, PCF85263Map>("PCF85263");
+    RoundTrip<CMCP7940N, MCP7940NMap>("MCP7940N");
+    Snapshot();
+
+    printf("%s (%u failures)\n", g_failures ? "FAILED" : "PASSED", g_failures);
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        MCP7940NTest.cpp
+ * @summary     MCP7940N driver against the register level model
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+// Build on the host from the library root with
+//   g++ -std=gnu++11 -O2 -I. MCP7940N.cpp nRTC.cpp RTCBus.cpp SimBus.cpp
+//   SimMCP7940N.cpp VirtualClock.cpp extras/mcp7940n/MCP7940NTest.cpp
+
+#include "MCP7940N.h"
+#include "SimMCP7940N.h"
+#include <cstdio>
+#include <cstring>
+
+static CVirtualClock g_clock;
+static uint32_t g_failures = 0;
+static uint32_t g_interrupts = 0;
+
+
+static void Check(const bool condition, const char *message)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", message);
+        g_failures++;
+    }
+}
+
+
+static void OnInterrupt(const uint64_t time)
+{
+    (void)time;
+    g_interrupts++;
+}
+
+
+static void TestOscillator(CSimBus &bus, CSimMCP7940N &chip, CMCP7940N &rtc)
+{
+    CRTC::RTC time;
+    CRTC::RTC read;
+    uint32_t transfers;
+
+    // A fresh chip reports OSCRUN only after a few polls
+    chip.SetStartupPolls(3);
+    transfers = bus.GetTransfers();
+    rtc.Initialize();
+    Check(chip.IsRunning(), "oscillator running after Initialize");
+    Check((bus.GetTransfers() - transfers) >= 6, "OSCRUN polled through the start-up");
+    Check((rtc.GetStatus() == CRTC::STATUS_OK), "Initialize status");
+
+    time.year = 26;
+    time.month = 10;
+    time.day = 19;
+    time.hour = 6;
+    time.minute = 29;
+    time.second = 50;
+
+    transfers = bus.GetTransfers();
+    Check(rtc.SetRTC(time) == CRTC::STATUS_OK, "set time across the stop and restart");
+    Check(chip.IsRunning(), "oscillator restarted after SetRTC");
+    Check(rtc.GetRTC(read) == CRTC::STATUS_OK, "get time");
+    Check((read.day == 19) && (read.hour == 6) && (read.minute == 29) && (read.second == 50), "time round trip");
+    printf("oscillator: start-up polled, SetRTC took %u transfers\n", bus.GetTransfers() - transfers);
+}
+
+
+static void TestAlarms(CMCP7940N &rtc)
+{
+    CRTC::RTC alarm;
+    CRTC::RTC minute;
+    bool triggered = true;
+
+    // Alarm 0 as the daily CRTC alarm at 06:30:00
+    alarm.hour = 6;
+    alarm.minute = 30;
+    Check(rtc.SetAlarmRTC(alarm) == CRTC::STATUS_OK, "set daily alarm");
+    Check(rtc.GetAlarmState() == CRTC::State::ENABLE, "daily alarm enabled");
+
+    // Alarm 1 on minute 31 of any hour
+    minute.minute = 31;
+    Check(rtc.SetAlarm(CMCP7940N::Alarm::ALARM_1, minute, CMCP7940N::Match::MINUTE) == CRTC::STATUS_OK, "set alarm 1");
+    Check(rtc.SetAlarmState(CMCP7940N::Alarm::ALARM_1, CRTC::State::ENABLE) == CRTC::STATUS_OK, "enable alarm 1");
+
+    Check((rtc.IsAlarmTriggered(CMCP7940N::Alarm::ALARM_0, triggered) == CRTC::STATUS_OK) && !triggered, "alarm 0 idle");
+
+    g_clock.Step(11000000ULL); // 06:30:01
+    Check((rtc.IsAlarmTriggered(CMCP7940N::Alarm::ALARM_0, triggered) == CRTC::STATUS_OK) && triggered, "alarm 0 fired");
+    Check((rtc.IsAlarmTriggered(CMCP7940N::Alarm::ALARM_1, triggered) == CRTC::STATUS_OK) && !triggered, "alarm 1 not yet");
+    Check(g_interrupts == 1, "MFP asserted by alarm 0");
+    Check(rtc.AlarmReset() == CRTC::STATUS_OK, "acknowledge alarm 0");
+    Check(!rtc.IsAlarmTriggered(), "alarm 0 cleared");
+
+    g_clock.Step(60000000ULL); // 06:31:01
+    Check(rtc.IsAlarmTriggered(CMCP7940N::Alarm::ALARM_1), "alarm 1 fired");
+    Check(!rtc.IsAlarmTriggered(CMCP7940N::Alarm::ALARM_0), "alarm 0 still clear");
+    Check(g_interrupts == 2, "MFP asserted by alarm 1");
+    Check(rtc.AlarmReset(CMCP7940N::Alarm::ALARM_1) == CRTC::STATUS_OK, "acknowledge alarm 1");
+    Check(!rtc.IsAlarmTriggered(CMCP7940N::Alarm::ALARM_1), "alarm 1 cleared");
+    printf("alarms: %u interrupts, daily alarm then minute match\n", g_interrupts);
+}
+
+
+static void TestSRAM(CMCP7940N &rtc)
+{
+    uint8_t data[MCP7940NMap::SRAM_SIZE];
+    uint8_t echo[MCP7940NMap::SRAM_SIZE];
+
+    for (uint8_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = (uint8_t)(0xA5 ^ (i * 13));
+    }
+
+    memset(echo, 0, sizeof(echo));
+    Check(rtc.GetSRAMSize() == MCP7940NMap::SRAM_SIZE, "SRAM size");
+    Check(rtc.SetSRAM(0, data, sizeof(data)) == CRTC::STATUS_OK, "write SRAM");
+    Check(rtc.GetSRAM(0, echo, sizeof(echo)) == CRTC::STATUS_OK, "read SRAM");
+    Check(memcmp(data, echo, sizeof(data)) == 0, "SRAM round trip");
+    printf("SRAM: %u bytes round trip\n", (unsigned)sizeof(data));
+}
+
+
+static void TestPowerFail(CSimMCP7940N &chip, CMCP7940N &rtc)
+{
+    CRTC::RTC time;
+    CRTC::RTC down;
+    CRTC::RTC up;
+    bool failed = true;
+
+    Check((rtc.IsPowerFail(failed) == CRTC::STATUS_OK) && !failed, "no power failure yet");
+
+    g_clock.Step(59000000ULL);      // 06:32:00
+    chip.PowerDown();
+    Check(rtc.GetRTC(time) != CRTC::STATUS_OK, "device silent without main supply");
+    g_clock.Step(7200000000ULL);    // 08:32:00 on battery
+    chip.PowerUp();
+
+    Check((rtc.IsPowerFail(failed) == CRTC::STATUS_OK) && failed, "power failure flagged");
+    Check(rtc.GetPowerFail(down, up) == CRTC::STATUS_OK, "read timestamps");
+    Check((down.hour == 6) && (down.minute == 32) && (down.day == 19) && (down.month == 10), "power-down stamp");
+    Check((up.hour == 8) && (up.minute == 32) && (up.day == 19) && (up.month == 10), "power-up stamp");
+    Check((rtc.GetRTC(time) == CRTC::STATUS_OK) && (time.hour == 8) && (time.minute == 32), "time kept on battery");
+
+    Check(rtc.PowerFailReset() == CRTC::STATUS_OK, "clear power failure");
+    Check(!rtc.IsPowerFail(), "power failure cleared");
+    printf("power fail: down %02u:%02u, up %02u:%02u\n", down.hour, down.minute, up.hour, up.minute);
+}
+
+
+int main(void)
+{
+    CSimBus bus;
+    CSimMCP7940N chip(g_clock);
+    CMCP7940N rtc;
+
+    bus.Attach(chip);
+    g_clock.Attach(chip);
+    chip.SetInterruptCallback(OnInterrupt);
+    rtc.SetBus(bus);
+
+    TestOscillator(bus, chip, rtc);
+    TestAlarms(rtc);
+    TestSRAM(rtc);
+    TestPowerFail(chip, rtc);
+
+    printf("%s (%u failures)\n", g_failures ? "FAILED" : "PASSED", g_failures);
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        MonotonicClockTest.cpp
+ * @summary     Monotonic clock latching, calibration and slew against the DS323x model
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+// Build on the host from the library root with
+//   g++ -std=gnu++11 -O2 -I. DS323x.cpp nRTC.cpp RTCBus.cpp SimBus.cpp
+//   SimDS323x.cpp VirtualClock.cpp MonotonicClock.cpp
+//   extras/monotonic/MonotonicClockTest.cpp
+// The MCU tick runs 500 ppm slow against the virtual time and every tick
+// read advances it by 5 ms, so polling loops make progress.
+
+#include "DS323x.h"
+#include "MonotonicClock.h"
+#include "SimDS323x.h"
+#include <cstdio>
+
+static const uint64_t MCU_PPM = 500;        // MCU crystal slow against the RTC
+static const uint64_t POLL_US = 5000;       // Virtual time per tick read
+
+static CVirtualClock g_clock;
+static uint64_t g_set_us = 0;               // Virtual time of the last SetRTC
+static uint32_t g_set_epoch = 0;
+static uint64_t g_previous = 0;             // Last Now() seen by Run
+static uint32_t g_backwards = 0;
+static uint32_t g_failures = 0;
+
+
+static void Check(const bool condition, const char *message)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", message);
+        g_failures++;
+    }
+}
+
+
+static uint32_t Tick(void)
+{
+    g_clock.Step(POLL_US);
+
+    uint64_t now = g_clock.Now();
+    return (uint32_t)((now - ((now * MCU_PPM) / 1000000ULL)) / 1000);
+}
+
+
+// Writing the seconds restarts the chip's countdown, so its time is exact
+static void SetTime(CDS3231 &rtc, const uint32_t epoch)
+{
+    CRTC::RTC time;
+
+    rtc.FromEpoch(epoch, time);
+    rtc.SetRTC(time);
+    g_set_us = g_clock.Now();
+    g_set_epoch = epoch;
+}
+
+
+static int64_t Error(CMonotonicClock &clock)
+{
+    uint64_t now = clock.Now();
+    uint64_t rtc = (1000ULL * g_set_epoch) + ((g_clock.Now() - g_set_us) / 1000);
+
+    return (int64_t)(now - rtc);
+}
+
+
+// Polls Update for the given virtual seconds and checks Now never decreases
+static void Run(CMonotonicClock &clock, const uint32_t seconds)
+{
+    uint64_t end = g_clock.Now() + (1000000ULL * seconds);
+
+    while (g_clock.Now() < end)
+    {
+        clock.Update();
+
+        uint64_t now = clock.Now();
+
+        g_backwards += (now < g_previous);
+        g_previous = now;
+    }
+}
+
+
+int main(void)
+{
+    CSimBus bus;
+    CSimDS323x chip(g_clock);
+    CDS3231 rtc;
+    CMonotonicClock clock(rtc, Tick);
+
+    bus.Attach(chip);
+    g_clock.Attach(chip);
+    rtc.SetBus(bus);
+    rtc.Initialize();
+    g_clock.Step(1234567);
+    SetTime(rtc, CRTC::Timestamp(26, 10, 19, 6, 0, 0).epoch);
+
+    // The rollover is latched to within a poll
+    Check(clock.Synchronize() == CRTC::STATUS_OK, "synchronize");
+    Check(clock.IsSynchronized(), "synchronized");
+    Check((Error(clock) >= -10) && (Error(clock) <= 10), "synchronized to the rollover");
+    printf("synchronize: %+d ms\n", (int)Error(clock));
+
+    // Uncalibrated, the slow MCU tick falls behind until the next latch
+    int64_t worst = 0;
+
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        Run(clock, 1);
+        worst = (Error(clock) < worst) ? Error(clock) : worst;
+    }
+
+    Check((worst > -20) && (worst <= 10), "tracks the RTC between latches");
+
+    // Rate updates every 256 s converge on the MCU error
+    Run(clock, 20 * 256);
+
+    int32_t drift = clock.GetDrift();
+
+    Check((drift > 450) && (drift < 550), "MCU drift measured");
+    Check((Error(clock) >= -10) && (Error(clock) <= 10), "calibrated clock on the RTC");
+    printf("calibrate: %d ppm after %u s, error %+d ms\n", drift, 20 * 256, (int)Error(clock));
+
+    // RTC stepped back a second: Now holds, then slews at 1 ms per 16 ms
+    uint64_t before = clock.Now();
+
+    SetTime(rtc, g_set_epoch + ((uint32_t)((g_clock.Now() - g_set_us) / 1000000)) - 1);
+    Run(clock, 2);
+    Check(clock.Now() >= before, "backward step never decreases Now");
+    Check(Error(clock) > 800, "backward correction slewed, not jumped");
+    Run(clock, 20);
+    Check((Error(clock) >= -10) && (Error(clock) <= 10), "backward step slewed in");
+    printf("step back 1 s: error %+d ms after 22 s\n", (int)Error(clock));
+
+    // RTC stepped forward two seconds: slewed in over about 32 s
+    uint64_t start = clock.Now();
+    uint64_t wall = g_clock.Now();
+
+    SetTime(rtc, g_set_epoch + ((uint32_t)((g_clock.Now() - g_set_us) / 1000000)) + 2);
+    Run(clock, 4);
+
+    uint64_t advanced = clock.Now() - start;
+    uint64_t elapsed = (g_clock.Now() - wall) / 1000;
+
+    Check(advanced <= (elapsed + (elapsed / 16) + 1100), "forward correction limited by the slew rate");
+    Check(Error(clock) < -1500, "forward correction still outstanding");
+    Run(clock, 40);
+    Check((Error(clock) >= -10) && (Error(clock) <= 10), "forward step slewed in");
+    printf("step forward 2 s: error %+d ms after 44 s\n", (int)Error(clock));
+
+    Check(g_backwards == 0, "Now never decreases");
+
+    printf("%s (%u failures)\n", g_failures ? "FAILED" : "PASSED", g_failures);
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        PCF2129Test.cpp
+ * @summary     PCF2129 flag handling against a register model
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+// Build on the host from the library root with
+//   g++ -std=gnu++11 -O2 -I. PCF2129.cpp nRTC.cpp RTCBus.cpp SimBus.cpp
+//   extras/pcf2129/PCF2129Test.cpp
+
+#include "PCF2129.h"
+#include "SimBus.h"
+#include <cstdio>
+#include <cstring>
+
+static const uint8_t CONTROL_1 = 0x00;
+static const uint8_t CONTROL_2 = 0x01;
+static const uint8_t WATCHDOG_CTRL = 0x10;
+static const uint8_t WATCHDOG_VALUE = 0x11;
+
+static const uint8_t SI = 0x01;             // Control_1
+static const uint8_t MSF = 0x80;            // Control_2
+static const uint8_t WDTF = 0x40;
+static const uint8_t AF = 0x10;
+static const uint8_t AIE = 0x02;
+static const uint8_t WD_CD = 0x80;          // Watchdg_tim_ctl
+
+static uint32_t g_failures = 0;
+
+
+static void Check(const bool condition, const char *message)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", message);
+        g_failures++;
+    }
+}
+
+
+// PCF2129 register file with the Control_2 flag semantics: MSF, TSF2 and
+// AF clear on writing 0 and ignore a 1, WDTF is read-only and clears when
+// the countdown value is reloaded
+class CSimPCF2129 : public CSimRegisterDevice
+{
+    public:
+    CSimPCF2129(uint8_t registers[], const uint16_t size)
+        : CSimRegisterDevice(PCF2129Map::I2C, registers, size)
+    {
+        // empty
+    }
+
+    uint8_t Write(const uint8_t reg, const uint8_t data[], const uint8_t bytes)
+    {
+        static const uint8_t CLEAR_ONLY = 0xB0;
+        uint8_t flags = m_register[CONTROL_2];
+        uint8_t result = CSimRegisterDevice::Write(reg, data, bytes);
+
+        if ((reg <= CONTROL_2) && ((reg + bytes) > CONTROL_2))
+        {
+            uint8_t written = m_register[CONTROL_2];
+
+            m_register[CONTROL_2] = (written & ~(CLEAR_ONLY | WDTF))
+                | (flags & written & CLEAR_ONLY) | (flags & WDTF);
+        }
+
+        if ((reg <= WATCHDOG_VALUE) && ((reg + bytes) > WATCHDOG_VALUE))
+        {
+            m_register[CONTROL_2] &= ~WDTF;
+        }
+
+        return result;
+    }
+};
+
+
+int main(void)
+{
+    uint8_t registers[0x20];
+    CSimPCF2129 chip(registers, sizeof(registers));
+    CSimBus bus;
+    CPCF2129 rtc;
+    bool triggered = false;
+
+    memset(registers, 0, sizeof(registers));
+    registers[0x04] = 0x01; // Valid time: 00:00:00 01-01-2000
+    registers[0x06] = 0x01;
+    registers[0x08] = 0x01;
+    bus.Attach(chip);
+    rtc.SetBus(bus);
+    rtc.Initialize();
+
+    // Countdown and second interrupt armed, alarm interrupt enabled
+    Check(rtc.SetCountdown(CPCF2129::TimerClock::F1HZ, 10, false) == CRTC::STATUS_OK, "arm countdown");
+    Check(rtc.SetPeriodicInterrupt(CPCF2129::Periodic::SECOND, false) == CRTC::STATUS_OK, "arm second interrupt");
+    registers[CONTROL_2] |= AIE;
+
+    // The alarm, the countdown and the second tick all fire together
+    registers[CONTROL_2] |= (AF | WDTF | MSF);
+    Check(rtc.AlarmReset() == CRTC::STATUS_OK, "acknowledge alarm");
+
+    Check(!(registers[CONTROL_2] & AF), "AF cleared");
+    Check((rtc.IsAlarmTriggered(triggered) == CRTC::STATUS_OK) && !triggered, "alarm reads as handled");
+    Check(registers[CONTROL_2] & AIE, "alarm interrupt still enabled");
+    Check(registers[WATCHDOG_CTRL] & WD_CD, "countdown still enabled");
+    Check(registers[WATCHDOG_VALUE] == 10, "countdown value kept");
+    Check(registers[CONTROL_1] & SI, "second interrupt still enabled");
+    Check((rtc.IsCountdownTriggered(triggered) == CRTC::STATUS_OK) && triggered, "countdown expiry still pending");
+    Check((rtc.IsPeriodicTriggered(triggered) == CRTC::STATUS_OK) && triggered, "second tick still pending");
+
+    // Each source is acknowledged by its own call
+    Check(rtc.PeriodicReset() == CRTC::STATUS_OK, "acknowledge second tick");
+    Check((rtc.IsPeriodicTriggered(triggered) == CRTC::STATUS_OK) && !triggered, "MSF cleared");
+    Check((rtc.IsCountdownTriggered(triggered) == CRTC::STATUS_OK) && triggered, "WDTF kept by PeriodicReset");
+    Check(rtc.ReloadCountdown(10) == CRTC::STATUS_OK, "reload countdown");
+    Check((rtc.IsCountdownTriggered(triggered) == CRTC::STATUS_OK) && !triggered, "WDTF cleared by reload");
+    Check(registers[CONTROL_2] == AIE, "only the enable left in Control_2");
+
+    printf("AlarmReset: Control_2 %02X, countdown %s, second interrupt %s\n", registers[CONTROL_2],
+        (registers[WATCHDOG_CTRL] & WD_CD) ? "enabled" : "disabled",
+        (registers[CONTROL_1] & SI) ? "enabled" : "disabled");
+
+    printf("%s (%u failures)\n", g_failures ? "FAILED" : "PASSED", g_failures);
+    return g_failures ? 1 : 0;
+}
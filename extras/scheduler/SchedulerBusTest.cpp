@@ -0,0 +1,403 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        SchedulerBusTest.cpp
+ * @summary     Shared bus scheduling of the RTC and co-resident devices on the simulated bus
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+// Build on the host from the library root with
+//   g++ -std=gnu++11 -O2 -I. DS323x.cpp nRTC.cpp RTCBus.cpp SimBus.cpp
+//   SimDS323x.cpp VirtualClock.cpp SchedulerBus.cpp extras/scheduler/SchedulerBusTest.cpp
+// Wire time is simulated: every transfer advances the virtual clock by its
+// duration at 400 kHz, and a sensor "data ready" interrupt queues a read
+// every 700 us while the RTC writes its SRAM.
+
+#include "DS323x.h"
+#include "SchedulerBus.h"
+#include "SimDS323x.h"
+#include <cstdio>
+
+static const uint8_t ADDRESS_SENSOR = 0x40;
+static const uint8_t ADDRESS_EEPROM = 0x50;
+static const uint8_t ADDRESS_DISPLAY = 0x3C;
+
+static CVirtualClock g_clock;
+static uint32_t g_failures = 0;
+
+
+static uint32_t Tick(void)
+{
+    return (uint32_t)g_clock.Now();
+}
+
+
+static void Check(const bool condition, const char *message)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", message);
+        g_failures++;
+    }
+}
+
+
+// Transfers take their wire time on the virtual clock
+class CWireBus : public CSimBus
+{
+    public:
+    uint8_t Write(const handle_t handle, const uint8_t reg, const uint8_t data[], const uint8_t bytes)
+    {
+        g_clock.Step(GetTransferTime(false, bytes, GetSpeed(handle)));
+        return CSimBus::Write(handle, reg, data, bytes);
+    }
+
+    uint8_t Read(const handle_t handle, const uint8_t reg, uint8_t data[], const uint8_t bytes)
+    {
+        g_clock.Step(GetTransferTime(true, bytes, GetSpeed(handle)));
+        return CSimBus::Read(handle, reg, data, bytes);
+    }
+};
+
+
+// Periodic data ready interrupt queueing a high priority sensor read
+class CSensorInterrupt : public CVirtualClock::Listener
+{
+    public:
+    CSchedulerBus &m_scheduler;
+    CSchedulerBus::Request m_request;
+    uint8_t m_data[6];
+    uint64_t m_next;
+    uint64_t m_arrival;
+    uint32_t m_period;
+    uint32_t m_count;
+    uint32_t m_overruns;
+    uint32_t m_max_latency;
+    bool m_enabled;
+
+    CSensorInterrupt(CSchedulerBus &scheduler, const CRTCBus::handle_t handle, const uint32_t period)
+        : m_scheduler(scheduler)
+        , m_next{0}
+        , m_arrival{0}
+        , m_period{period}
+        , m_count{0}
+        , m_overruns{0}
+        , m_max_latency{0}
+        , m_enabled{false}
+    {
+        m_request.handle = handle;
+        m_request.reg = 0;
+        m_request.read = true;
+        m_request.data = m_data;
+        m_request.bytes = sizeof(m_data);
+        m_request.priority = CSchedulerBus::Priority::HIGH;
+        m_request.deadline = 1000;
+        m_request.complete = Complete;
+        m_request.context = this;
+    }
+
+    void Start(void)
+    {
+        m_next = g_clock.Now() + m_period;
+        m_count = 0;
+        m_overruns = 0;
+        m_max_latency = 0;
+        m_enabled = true;
+    }
+
+    void Stop(void)
+    {
+        m_enabled = false;
+    }
+
+    uint64_t GetNextEvent(void)
+    {
+        return m_enabled ? m_next : CVirtualClock::NO_EVENT;
+    }
+
+    void OnEvent(const uint64_t now)
+    {
+        m_next += m_period;
+
+        if (m_scheduler.Submit(m_request))
+        {
+            m_arrival = now;
+        }
+        else
+        {
+            m_overruns++; // Previous sample not read yet
+        }
+    }
+
+    static void Complete(CSchedulerBus::Request &request)
+    {
+        CSensorInterrupt &sensor = *(CSensorInterrupt*)request.context;
+        uint32_t latency = (uint32_t)(g_clock.Now() - sensor.m_arrival);
+
+        sensor.m_count++;
+
+        if (latency > sensor.m_max_latency)
+        {
+            sensor.m_max_latency = latency;
+        }
+    }
+};
+
+
+static void Idle(CSchedulerBus &scheduler, const uint32_t us)
+{
+    for (uint32_t i = 0; i < us; i += 10)
+    {
+        g_clock.Step(10);
+        scheduler.Flush();
+    }
+}
+
+
+static uint32_t g_order[3];
+static uint8_t g_completed = 0;
+
+static void Record(CSchedulerBus::Request &request)
+{
+    g_order[g_completed++] = request.handle;
+}
+
+
+int main(void)
+{
+    uint8_t sensor_registers[16];
+    uint8_t eeprom_registers[64] = {0};
+    uint8_t display_registers[16] = {0};
+
+    for (uint8_t i = 0; i < sizeof(sensor_registers); i++)
+    {
+        sensor_registers[i] = (0xA0 + i);
+    }
+
+    CWireBus bus;
+    CSimDS323x chip(g_clock);
+    CSimRegisterDevice sensor(ADDRESS_SENSOR, sensor_registers, sizeof(sensor_registers));
+    CSimRegisterDevice eeprom(ADDRESS_EEPROM, eeprom_registers, sizeof(eeprom_registers));
+    CSimRegisterDevice display(ADDRESS_DISPLAY, display_registers, sizeof(display_registers));
+
+    bus.Attach(chip);
+    bus.Attach(sensor);
+    bus.Attach(eeprom);
+    bus.Attach(display);
+    g_clock.Attach(chip);
+
+    CSchedulerBus scheduler(bus, Tick);
+    CRTCBus::handle_t sensor_handle = scheduler.RegisterDevice(ADDRESS_SENSOR, CRTCBus::Speed::FAST);
+    CRTCBus::handle_t eeprom_handle = scheduler.RegisterDevice(ADDRESS_EEPROM, CRTCBus::Speed::FAST);
+    CRTCBus::handle_t display_handle = scheduler.RegisterDevice(ADDRESS_DISPLAY, CRTCBus::Speed::FAST);
+
+    CDS3232 rtc;
+    rtc.SetBus(scheduler);
+    rtc.Initialize();
+    Check(scheduler.SetPriority(DS323xMap::I2C, CSchedulerBus::Priority::LOW, 0), "RTC registered");
+
+    CSensorInterrupt interrupt(scheduler, sensor_handle, 700);
+    g_clock.Attach(interrupt);
+
+    // Sensor latency while the RTC rewrites its SRAM, by chunk size
+    printf("chunk  sensor max (us)  queue max (us)  misses  overruns  rtc transfers\n");
+
+    const uint8_t chunks[] = {255, 32, 16, 8};
+    uint32_t unchunked = 0;
+    uint32_t chunked = 0;
+
+    for (uint8_t c = 0; c < sizeof(chunks); c++)
+    {
+        uint8_t image[235];
+        uint8_t check[235];
+
+        scheduler.SetChunkSize(chunks[c]);
+        scheduler.ResetStats();
+        interrupt.Start();
+
+        for (uint8_t round = 0; round < 20; round++)
+        {
+            for (uint8_t i = 0; i < sizeof(image); i++)
+            {
+                image[i] = (uint8_t)(round * 7 + i);
+            }
+
+            Check(rtc.SetSRAM(0, image, sizeof(image)) == CRTC::STATUS_OK, "SRAM write");
+            Check(rtc.GetSRAM(0, check, sizeof(check)) == CRTC::STATUS_OK, "SRAM read");
+
+            for (uint8_t i = 0; i < sizeof(image); i++)
+            {
+                if (check[i] != image[i])
+                {
+                    Check(false, "SRAM content");
+                    break;
+                }
+            }
+
+            Idle(scheduler, 200);
+        }
+
+        interrupt.Stop();
+        scheduler.Flush();
+
+        CSchedulerBus::Stats high;
+        CSchedulerBus::Stats low;
+
+        scheduler.GetStats(CSchedulerBus::Priority::HIGH, high);
+        scheduler.GetStats(CSchedulerBus::Priority::LOW, low);
+
+        printf("%5u  %15u  %14u  %6u  %8u  %13u\n", chunks[c], interrupt.m_max_latency,
+            high.max_delay, high.misses, interrupt.m_overruns, low.transfers);
+
+        Check(interrupt.m_count == high.requests, "every sample read");
+
+        if (chunks[c] == 255)
+        {
+            unchunked = interrupt.m_max_latency;
+        }
+        else if (chunks[c] == 16)
+        {
+            chunked = interrupt.m_max_latency;
+            Check(high.misses == 0, "no deadline misses with 16 byte chunks");
+        }
+    }
+
+    Check(chunked * 4 < unchunked, "chunking bounds sensor latency");
+
+    // Adjacent register reads and writes merge into one burst
+    {
+        CSchedulerBus::Request read[3];
+        uint8_t data[3][2];
+        uint32_t transfers = bus.GetTransfers();
+
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            read[i].handle = sensor_handle;
+            read[i].reg = (uint8_t)(4 - (2 * i)); // 4, 2, 0: prepends
+            read[i].data = data[i];
+            read[i].bytes = 2;
+            scheduler.Submit(read[i]);
+        }
+
+        scheduler.Flush();
+        Check((bus.GetTransfers() - transfers) == 1, "reads merged");
+        Check((data[0][0] == 0xA4) && (data[1][1] == 0xA3) && (data[2][0] == 0xA0), "merged read data");
+
+        CSchedulerBus::Request write[3];
+        uint8_t values[3] = {0x11, 0x22, 0x33};
+
+        transfers = bus.GetTransfers();
+
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            write[i].handle = eeprom_handle;
+            write[i].reg = (uint8_t)(8 + i);
+            write[i].read = false;
+            write[i].data = &values[i];
+            write[i].bytes = 1;
+            scheduler.Submit(write[i]);
+        }
+
+        scheduler.Flush();
+        Check((bus.GetTransfers() - transfers) == 1, "writes merged");
+        Check((eeprom_registers[8] == 0x11) && (eeprom_registers[10] == 0x33), "merged write data");
+
+        CSchedulerBus::Stats normal;
+        scheduler.GetStats(CSchedulerBus::Priority::NORMAL, normal);
+        printf("merge: 6 requests in %u transfers, %u merged\n", normal.transfers, normal.merged);
+    }
+
+    // Class first, then earliest deadline; one device stays in order
+    {
+        CSchedulerBus::Request low;
+        CSchedulerBus::Request later;
+        CSchedulerBus::Request sooner;
+        uint8_t byte[3];
+
+        low.handle = eeprom_handle;
+        low.data = &byte[0];
+        low.bytes = 1;
+        low.priority = CSchedulerBus::Priority::LOW;
+        low.complete = Record;
+
+        later = low;
+        later.handle = display_handle;
+        later.data = &byte[1];
+        later.priority = CSchedulerBus::Priority::NORMAL;
+        later.deadline = 5000;
+
+        sooner = later;
+        sooner.handle = sensor_handle;
+        sooner.data = &byte[2];
+        sooner.deadline = 1000;
+
+        scheduler.Submit(low);
+        scheduler.Submit(later);
+        scheduler.Submit(sooner);
+        scheduler.Flush();
+
+        Check((g_completed == 3) && (g_order[0] == sensor_handle)
+            && (g_order[1] == display_handle) && (g_order[2] == eeprom_handle), "priority then deadline order");
+
+        CSchedulerBus::Request write;
+        CSchedulerBus::Request read;
+        uint8_t value = 0xAB;
+        uint8_t result = 0;
+
+        write.handle = eeprom_handle;
+        write.reg = 0x20;
+        write.read = false;
+        write.data = &value;
+        write.bytes = 1;
+        write.priority = CSchedulerBus::Priority::LOW;
+
+        read.handle = eeprom_handle;
+        read.reg = 0x20;
+        read.data = &result;
+        read.bytes = 1;
+        read.priority = CSchedulerBus::Priority::HIGH;
+
+        scheduler.Submit(write);
+        scheduler.Submit(read);
+        scheduler.Flush();
+        Check(result == 0xAB, "device order kept across classes");
+    }
+
+    // Re-initializing the RTC keeps its entry, priority and deadline
+    {
+        CRTC::RTC time;
+        CSchedulerBus::Stats low;
+
+        for (uint8_t i = 0; i < 8; i++)
+        {
+            rtc.Initialize();
+        }
+
+        scheduler.ResetStats();
+        Check(rtc.GetRTC(time) == CRTC::STATUS_OK, "read after repeated Initialize");
+        scheduler.GetStats(CSchedulerBus::Priority::LOW, low);
+        Check(low.requests == 1, "RTC keeps its LOW class");
+    }
+
+    printf("%s (%u failures)\n", g_failures ? "FAILED" : "PASSED", g_failures);
+    return g_failures ? 1 : 0;
+}
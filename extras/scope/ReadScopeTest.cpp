@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        ReadScopeTest.cpp
+ * @summary     Read scope caching against flag and control register writes
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+// Build on the host from the library root with
+//   g++ -std=gnu++11 -O2 -I. DS323x.cpp PCF2129.cpp nRTC.cpp RTCBus.cpp
+//   SimBus.cpp SimDS323x.cpp VirtualClock.cpp extras/scope/ReadScopeTest.cpp
+
+#include "DS323x.h"
+#include "PCF2129.h"
+#include "SimDS323x.h"
+#include <cstdio>
+#include <cstring>
+
+static uint32_t g_failures = 0;
+
+
+static void Check(const bool condition, const char *message)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", message);
+        g_failures++;
+    }
+}
+
+
+// PCF2129 register file where reloading the countdown clears WDTF
+class CSimPCF2129 : public CSimRegisterDevice
+{
+    public:
+    CSimPCF2129(uint8_t registers[], const uint16_t size)
+        : CSimRegisterDevice(PCF2129Map::I2C, registers, size)
+    {
+        // empty
+    }
+
+    uint8_t Write(const uint8_t reg, const uint8_t data[], const uint8_t bytes)
+    {
+        uint8_t result = CSimRegisterDevice::Write(reg, data, bytes);
+
+        if ((reg <= 0x11) && ((reg + bytes) > 0x11))
+        {
+            m_register[0x01] &= ~0x40;
+        }
+
+        return result;
+    }
+};
+
+
+static void TestDS3231(void)
+{
+    CVirtualClock clock;
+    CSimDS323x chip(clock);
+    CSimBus bus;
+    CDS3231 rtc;
+    CRTC::RTC time;
+    CRTC::RTC read;
+    bool triggered = true;
+    int8_t offset = 0;
+    uint8_t saved = 0;
+
+    bus.Attach(chip);
+    clock.Attach(chip);
+    rtc.SetBus(bus);
+    rtc.Initialize();
+    rtc.SetAgingOffset(-5);
+    time.year = 26;
+    time.month = 10;
+    time.day = 19;
+    time.hour = 12;
+    time.minute = 34;
+
+    {
+        CRTC::ReadScope scope(rtc);
+        uint32_t transfers = bus.GetTransfers();
+
+        Check(scope.IsValid(), "DS3231 burst");
+
+        // Plain registers: the write is kept and served from the window
+        Check(rtc.SetRTC(time) == CRTC::STATUS_OK, "set time");
+        transfers = bus.GetTransfers();
+        Check((rtc.GetRTC(read) == CRTC::STATUS_OK) && (read.hour == 12) && (read.minute == 34), "time from window");
+        Check(bus.GetTransfers() == transfers, "time served without the bus");
+
+        // StartReference writes 1s to the clear-only flags; they stay clear
+        Check(rtc.StartReference(saved) == CRTC::STATUS_OK, "start reference");
+        transfers = bus.GetTransfers();
+        Check((rtc.IsAlarmTriggered(triggered) == CRTC::STATUS_OK) && !triggered, "flags not taken from the write");
+        Check(bus.GetTransfers() == (transfers + 1), "status read from the bus after the write");
+
+        Check((rtc.GetAgingOffset(offset) == CRTC::STATUS_OK) && (offset == -5), "aging offset from the bus");
+        rtc.StopReference(saved);
+    }
+
+    printf("DS3231: time cached, flags re-read after StartReference\n");
+}
+
+
+static void TestPCF2129(void)
+{
+    uint8_t registers[0x20];
+    CSimPCF2129 chip(registers, sizeof(registers));
+    CSimBus bus;
+    CPCF2129 rtc;
+    bool triggered = false;
+
+    memset(registers, 0, sizeof(registers));
+    registers[0x04] = 0x01; // Valid time: 00:00:00 01-01-2000
+    registers[0x06] = 0x01;
+    registers[0x08] = 0x01;
+    bus.Attach(chip);
+    rtc.SetBus(bus);
+    rtc.Initialize();
+
+    registers[0x01] = 0x40; // Countdown expired
+
+    {
+        CRTC::ReadScope scope(rtc);
+
+        Check(scope.IsValid(), "PCF2129 burst");
+        Check((rtc.IsCountdownTriggered(triggered) == CRTC::STATUS_OK) && triggered, "WDTF seen in window");
+
+        Check(rtc.ReloadCountdown(10) == CRTC::STATUS_OK, "reload countdown");
+        Check((registers[0x01] & 0x40) == 0, "chip cleared WDTF");
+        Check((rtc.IsCountdownTriggered(triggered) == CRTC::STATUS_OK) && !triggered, "WDTF cleared after reload");
+    }
+
+    printf("PCF2129: WDTF %s after ReloadCountdown inside a scope\n", triggered ? "set" : "clear");
+}
+
+
+int main(void)
+{
+    TestDS3231();
+    TestPCF2129();
+
+    printf("%s (%u failures)\n", g_failures ? "FAILED" : "PASSED", g_failures);
+    return g_failures ? 1 : 0;
+}
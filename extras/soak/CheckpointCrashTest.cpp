@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        CheckpointCrashTest.cpp
+ * @summary     Power loss at every transfer and byte of checkpoint saves
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+// Build on the host from the library root with
+//   g++ -std=gnu++11 -O2 -I. DS323x.cpp nRTC.cpp RTCBus.cpp SimBus.cpp
+//   Checkpoint.cpp nCRC.cpp extras/soak/CheckpointCrashTest.cpp
+
+#include "Checkpoint.h"
+#include "DS323x.h"
+#include "SimBus.h"
+#include <cstdio>
+#include <cstring>
+
+static const uint8_t VERSION = 3;
+static const uint8_t MAX_IMAGE = 48;
+static const uint8_t SRAM = 0x14;           // DS3232 SRAM in the register file
+
+static uint32_t g_failures = 0;
+
+
+static void Check(const bool condition, const char *message)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", message);
+        g_failures++;
+    }
+}
+
+
+// Power loss at the transfer chosen with InjectFailure: a write lands only
+// its first m_tear bytes, and the bus stays down until Reboot
+class CTornBus : public CSimBus
+{
+    public:
+    uint8_t m_tear;
+    bool m_down;
+
+    CTornBus(void)
+        : m_tear{0}
+        , m_down{false}
+    {
+        // empty
+    }
+
+    uint8_t Write(const handle_t handle, const uint8_t reg, const uint8_t data[], const uint8_t bytes)
+    {
+        if (m_down)
+        {
+            return 4;
+        }
+
+        if (m_fail == 0)
+        {
+            CSimDevice *device = Find(handle);
+
+            if (device != nullptr)
+            {
+                device->Write(reg, data, (m_tear < bytes) ? m_tear : bytes);
+            }
+
+            m_down = true;
+        }
+
+        return CSimBus::Write(handle, reg, data, bytes);
+    }
+
+    uint8_t Read(const handle_t handle, const uint8_t reg, uint8_t data[], const uint8_t bytes)
+    {
+        if (m_down)
+        {
+            return 4;
+        }
+
+        m_down = (m_fail == 0);
+        return CSimBus::Read(handle, reg, data, bytes);
+    }
+
+    void Reboot(void)
+    {
+        m_down = false;
+        m_fail = 0xFFFFFFFF;
+    }
+};
+
+
+// Image generation g: every byte differs between generations, chunk 0
+// only changes from the second generation on
+static void Fill(uint8_t image[], const uint8_t bytes, const uint8_t generation)
+{
+    for (uint8_t i = 0; i < bytes; i++)
+    {
+        image[i] = ((i < CCheckpoint::CHUNK_SIZE) && (generation > 1)) ? 0x11 : (uint8_t)((generation << 5) + i);
+    }
+}
+
+
+static bool Is(const uint8_t image[], const uint8_t bytes, const uint8_t generation)
+{
+    uint8_t expected[MAX_IMAGE];
+
+    Fill(expected, bytes, generation);
+    return (memcmp(image, expected, bytes) == 0);
+}
+
+
+static void Sweep(const char *name, CTornBus &bus, CDS3232 &rtc, uint8_t registers[], const uint8_t bytes)
+{
+    uint8_t baseline[256];
+    uint8_t image[MAX_IMAGE];
+    uint32_t crashes = 0;
+    uint32_t kept = 0;
+    uint32_t applied = 0;
+    bool complete = false;
+
+    // Generations 1 and 2 saved, so both slots hold valid images
+    {
+        CCheckpoint checkpoint(rtc, 0, image, bytes, VERSION);
+
+        Fill(image, bytes, 1);
+        checkpoint.Save();
+        Fill(image, bytes, 2);
+        checkpoint.Mark(0, bytes);
+        checkpoint.Save();
+        memcpy(baseline, registers, 256);
+    }
+
+    for (uint32_t transfer = 0; !complete; transfer++)
+    {
+        for (uint8_t tear = 0; tear <= bytes; tear++)
+        {
+            CRTC::RTC time;
+
+            memcpy(registers, baseline, 256);
+            bus.Reboot();
+
+            CCheckpoint checkpoint(rtc, 0, image, bytes, VERSION);
+            Check(checkpoint.Restore(time) == CRTC::STATUS_OK, "restore baseline");
+
+            // Generation 3 leaves chunk 0 alone, so only later chunks are sent
+            Fill(image, bytes, 3);
+            checkpoint.Mark(CCheckpoint::CHUNK_SIZE, bytes - CCheckpoint::CHUNK_SIZE);
+            bus.m_tear = tear;
+            bus.InjectFailure(transfer);
+
+            CRTC::status_t status = checkpoint.Save();
+            bool crashed = bus.m_down;
+
+            bus.Reboot();
+
+            if (!crashed)
+            {
+                complete = true; // Save needs fewer transfers
+                break;
+            }
+
+            crashes++;
+
+            // After reset: generation 2 or 3 in full, never a mix
+            CCheckpoint recovered(rtc, 0, image, bytes, VERSION);
+
+            memset(image, 0xEE, sizeof(image));
+            Check(recovered.Restore(time) == CRTC::STATUS_OK, "restore after power loss");
+            Check(Is(image, bytes, 2) || Is(image, bytes, 3), "image old or new after power loss");
+            Check((status != CRTC::STATUS_OK) || Is(image, bytes, 3), "completed save persisted");
+            kept += Is(image, bytes, 2);
+            applied += Is(image, bytes, 3);
+
+            // Saving keeps working after recovery
+            Fill(image, bytes, 4);
+            recovered.Mark(0, bytes);
+            Check(recovered.Save() == CRTC::STATUS_OK, "save after recovery");
+            memset(image, 0xEE, sizeof(image));
+            Check((recovered.Restore(time) == CRTC::STATUS_OK) && Is(image, bytes, 4), "restore after recovery");
+        }
+    }
+
+    printf("%-9s %4u power losses: %u kept the old image, %u the new\n", name, crashes, kept, applied);
+}
+
+
+// Both slots rejected: the caller's image must be left alone. With matching
+// versions both slots get as far as the CRC check; an image larger than
+// the restore buffer is only promised that when no slot carries the version.
+static void Cold(CDS3232 &rtc, uint8_t registers[], const uint8_t bytes, const bool matching)
+{
+    uint8_t image[MAX_IMAGE];
+    CRTC::RTC time;
+
+    for (uint16_t i = SRAM; i < 256; i++)
+    {
+        registers[i] = (uint8_t)((i * 151) + 7);
+    }
+
+    registers[SRAM] = matching ? VERSION : (VERSION + 1);
+    registers[SRAM + CCheckpoint::HEADER_SIZE] = matching ? VERSION : (VERSION + 1);
+
+    CCheckpoint checkpoint(rtc, 0, image, bytes, VERSION);
+
+    memset(image, 0x5A, sizeof(image));
+    Check(checkpoint.Restore(time) == CRTC::STATUS_ERROR, "garbage rejected");
+
+    bool untouched = true;
+
+    for (uint8_t i = 0; i < bytes; i++)
+    {
+        untouched &= (image[i] == 0x5A);
+    }
+
+    Check(untouched, "rejected slots leave the image alone");
+    printf("cold %2u   %s versions rejected, image %s\n", bytes, matching ? "matching" : "foreign",
+        untouched ? "untouched" : "overwritten");
+}
+
+
+// Counts SRAM transfers of a warm Restore
+static uint32_t CountRestore(CTornBus &bus, CDS3232 &rtc, const uint8_t bytes)
+{
+    uint8_t image[MAX_IMAGE];
+    CRTC::RTC time;
+    CCheckpoint checkpoint(rtc, 0, image, bytes, VERSION);
+
+    Fill(image, bytes, 1);
+    checkpoint.Mark(0, bytes);
+    checkpoint.Save();
+    memset(image, 0xEE, sizeof(image));
+
+    uint32_t transfers = bus.GetTransfers();
+
+    Check((checkpoint.Restore(time) == CRTC::STATUS_OK) && Is(image, bytes, 1), "warm restore");
+    return (bus.GetTransfers() - transfers);
+}
+
+
+int main(void)
+{
+    uint8_t registers[256];
+    CSimRegisterDevice device(DS323xMap::I2C, registers, sizeof(registers));
+    CTornBus bus;
+    CDS3232 rtc;
+
+    memset(registers, 0, sizeof(registers));
+    registers[3] = 0x07; // Saturday 2000-01-01
+    registers[4] = 0x01;
+    registers[5] = 0x01;
+    bus.Attach(device);
+    rtc.SetBus(bus);
+    rtc.Initialize();
+
+    Sweep("burst", bus, rtc, registers, 12);    // Region within RESTORE_SIZE
+    Sweep("chunked", bus, rtc, registers, 32);  // Slots read separately
+    Sweep("large", bus, rtc, registers, 48);    // Slots read into the image
+    Cold(rtc, registers, 12, true);
+    Cold(rtc, registers, 32, true);
+    Cold(rtc, registers, 48, false);
+
+    // Time and headers in one burst, then each slot tried is read once
+    uint32_t burst = CountRestore(bus, rtc, 12);
+    uint32_t chunked = CountRestore(bus, rtc, 32);
+
+    Check(burst == 1, "burst restore in one transfer");
+    Check(chunked == 2, "newest slot read once");
+    printf("restore   %u transfer(s) at 12 bytes, %u at 32\n", burst, chunked);
+
+    printf("%s (%u failures)\n", g_failures ? "FAILED" : "PASSED", g_failures);
+    return g_failures ? 1 : 0;
+}
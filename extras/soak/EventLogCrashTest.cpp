@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        EventLogCrashTest.cpp
+ * @summary     Power loss at every transfer and byte of event log appends
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+// Build on the host from the library root with
+//   g++ -std=gnu++11 -O2 -I. DS323x.cpp nRTC.cpp RTCBus.cpp SimBus.cpp
+//   EventLog.cpp nCRC.cpp extras/soak/EventLogCrashTest.cpp
+
+#include "DS323x.h"
+#include "EventLog.h"
+#include "SimBus.h"
+#include <cstdio>
+#include <cstring>
+
+static const uint32_t ORIGIN = 846633600UL; // 2026-10-30T00:00:00
+static const uint8_t LOG_BYTES = 48;        // 32 byte ring
+
+static uint32_t g_failures = 0;
+
+
+static void Check(const bool condition, const char *message)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", message);
+        g_failures++;
+    }
+}
+
+
+// Power loss at the transfer chosen with InjectFailure: a write lands only
+// its first m_tear bytes, and the bus stays down until Reboot
+class CTornBus : public CSimBus
+{
+    public:
+    uint8_t m_tear;
+    bool m_down;
+
+    CTornBus(void)
+        : m_tear{0}
+        , m_down{false}
+    {
+        // empty
+    }
+
+    uint8_t Write(const handle_t handle, const uint8_t reg, const uint8_t data[], const uint8_t bytes)
+    {
+        if (m_down)
+        {
+            return 4;
+        }
+
+        if (m_fail == 0)
+        {
+            CSimDevice *device = Find(handle);
+
+            if (device != nullptr)
+            {
+                device->Write(reg, data, (m_tear < bytes) ? m_tear : bytes);
+            }
+
+            m_down = true;
+        }
+
+        return CSimBus::Write(handle, reg, data, bytes);
+    }
+
+    uint8_t Read(const handle_t handle, const uint8_t reg, uint8_t data[], const uint8_t bytes)
+    {
+        if (m_down)
+        {
+            return 4;
+        }
+
+        m_down = (m_fail == 0);
+        return CSimBus::Read(handle, reg, data, bytes);
+    }
+
+    void Reboot(void)
+    {
+        m_down = false;
+        m_fail = 0xFFFFFFFF;
+    }
+};
+
+
+// Event i of the history: one minute apart, type from the index
+static uint8_t Type(const uint32_t index)
+{
+    return (uint8_t)((index % 200) + 1);
+}
+
+
+static uint32_t Epoch(const uint32_t index)
+{
+    return ORIGIN + (60 * (index + 1));
+}
+
+
+// History indices [first, last] held by the log, false when not a run
+static bool Walk(CEventLog &log, int32_t &first, int32_t &last)
+{
+    uint8_t buffer[LOG_BYTES];
+    CEventLog::Cursor cursor;
+    CEventLog::Event event;
+
+    first = -1;
+    last = -1;
+
+    if (log.Load(buffer) != CRTC::STATUS_OK)
+    {
+        return false;
+    }
+
+    log.Begin(cursor);
+
+    while (log.Next(buffer, cursor, event))
+    {
+        int32_t index = (int32_t)((event.epoch - ORIGIN) / 60) - 1;
+
+        if ((event.epoch != Epoch(index)) || (event.type != Type(index)) || ((first >= 0) && (index != (last + 1))))
+        {
+            return false;
+        }
+
+        first = (first < 0) ? index : first;
+        last = index;
+    }
+
+    return true;
+}
+
+
+static void Sweep(const char *name, CTornBus &bus, CDS3232 &rtc, uint8_t registers[], const uint32_t events)
+{
+    uint8_t baseline[256];
+    uint8_t buffer[LOG_BYTES];
+    int32_t old_first;
+    int32_t old_last;
+    int32_t new_first;
+    int32_t new_last;
+    uint32_t crashes = 0;
+    uint32_t kept = 0;
+    uint32_t applied = 0;
+    bool complete = false;
+
+    // Log holding the given number of events, then the clean append
+    {
+        CEventLog log(rtc, 0, LOG_BYTES);
+
+        log.Format(ORIGIN);
+
+        for (uint32_t i = 0; i < events; i++)
+        {
+            log.Append(Type(i), Epoch(i));
+        }
+
+        Walk(log, old_first, old_last);
+        memcpy(baseline, registers, sizeof(baseline));
+        log.Append(Type(events), Epoch(events));
+        Walk(log, new_first, new_last);
+    }
+
+    for (uint32_t transfer = 0; !complete; transfer++)
+    {
+        for (uint8_t tear = 0; tear <= CEventLog::HEADER_SIZE; tear++)
+        {
+            memcpy(registers, baseline, sizeof(baseline));
+            bus.Reboot();
+
+            CEventLog log(rtc, 0, LOG_BYTES);
+            Check(log.Recover(buffer) == CRTC::STATUS_OK, "recover baseline");
+
+            bus.m_tear = tear;
+            bus.InjectFailure(transfer);
+
+            CRTC::status_t status = log.Append(Type(events), Epoch(events));
+            bool crashed = bus.m_down;
+
+            bus.Reboot();
+
+            if (!crashed)
+            {
+                complete = true; // Append needs fewer transfers
+                break;
+            }
+
+            crashes++;
+
+            // After reset: the old or new run of events, nothing torn
+            CEventLog recovered(rtc, 0, LOG_BYTES);
+            int32_t first;
+            int32_t last;
+
+            Check(recovered.Recover(buffer) == CRTC::STATUS_OK, "recover after power loss");
+            Check(Walk(recovered, first, last), "events form one run of the history");
+            Check((last == old_last) || (last == new_last), "ends at the old or new newest event");
+            Check((first >= old_first) && (first <= new_first), "only evicted events are missing");
+            Check((status != CRTC::STATUS_OK) || (last == new_last), "completed append persisted");
+            kept += (last == old_last);
+            applied += (last == new_last);
+
+            // The log keeps working after recovery; a lost event is logged again
+            int32_t next = (last + 1);
+
+            Check(recovered.Append(Type(next), Epoch(next)) == CRTC::STATUS_OK, "append after recovery");
+            Check(Walk(recovered, first, last) && (last == next), "appended event is newest");
+        }
+    }
+
+    printf("%-9s %4u power losses: %u kept the old log, %u the new\n", name, crashes, kept, applied);
+}
+
+
+int main(void)
+{
+    uint8_t registers[256];
+    CSimRegisterDevice device(DS323xMap::I2C, registers, sizeof(registers));
+    CTornBus bus;
+    CDS3232 rtc;
+
+    memset(registers, 0, sizeof(registers));
+    bus.Attach(device);
+    rtc.SetBus(bus);
+    rtc.Initialize();
+
+    Sweep("append", bus, rtc, registers, 3);    // Room left
+    Sweep("evicting", bus, rtc, registers, 40); // Full and wrapped
+
+    printf("%s (%u failures)\n", g_failures ? "FAILED" : "PASSED", g_failures);
+    return g_failures ? 1 : 0;
+}
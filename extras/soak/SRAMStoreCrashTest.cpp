@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        SRAMStoreCrashTest.cpp
+ * @summary     Power loss at every transfer and byte of SRAM store updates
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+// Build on the host from the library root with
+//   g++ -std=gnu++11 -O2 -I. DS323x.cpp nRTC.cpp RTCBus.cpp SimBus.cpp
+//   SRAMStore.cpp nCRC.cpp extras/soak/SRAMStoreCrashTest.cpp
+
+#include "DS323x.h"
+#include "SRAMStore.h"
+#include "SimBus.h"
+#include <cstdio>
+#include <cstring>
+
+static const uint8_t VALUE_SIZE = 4;
+static const uint8_t RECORD_SIZE = VALUE_SIZE + CSRAMStore::RECORD_OVERHEAD;
+
+static uint32_t g_failures = 0;
+
+
+static void Check(const bool condition, const char *message)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", message);
+        g_failures++;
+    }
+}
+
+
+// Power loss at the transfer chosen with InjectFailure: a write lands only
+// its first m_tear bytes, and the bus stays down until Reboot
+class CTornBus : public CSimBus
+{
+    public:
+    uint8_t m_tear;
+    bool m_down;
+
+    CTornBus(void)
+        : m_tear{0}
+        , m_down{false}
+    {
+        // empty
+    }
+
+    uint8_t Write(const handle_t handle, const uint8_t reg, const uint8_t data[], const uint8_t bytes)
+    {
+        if (m_down)
+        {
+            return 4;
+        }
+
+        if (m_fail == 0)
+        {
+            CSimDevice *device = Find(handle);
+
+            if (device != nullptr)
+            {
+                device->Write(reg, data, (m_tear < bytes) ? m_tear : bytes);
+            }
+
+            m_down = true;
+        }
+
+        return CSimBus::Write(handle, reg, data, bytes);
+    }
+
+    uint8_t Read(const handle_t handle, const uint8_t reg, uint8_t data[], const uint8_t bytes)
+    {
+        if (m_down)
+        {
+            return 4;
+        }
+
+        m_down = (m_fail == 0);
+        return CSimBus::Read(handle, reg, data, bytes);
+    }
+
+    void Reboot(void)
+    {
+        m_down = false;
+        m_fail = 0xFFFFFFFF;
+    }
+};
+
+
+enum class Operation : uint8_t
+{
+    UPDATE,     // Overwrite an existing key
+    INSERT,     // Add a key
+    REMOVE,
+};
+
+
+static CRTC::status_t Run(CSRAMStore &store, const Operation operation)
+{
+    static const uint8_t UPDATE[VALUE_SIZE] = {0xB0, 0xB1, 0xB2, 0xB3};
+    static const uint8_t INSERT[VALUE_SIZE] = {0xC0, 0xC1, 0xC2, 0xC3};
+
+    switch (operation)
+    {
+        case Operation::UPDATE: return store.Set(2, UPDATE);
+        case Operation::INSERT: return store.Set(9, INSERT);
+        default: return store.Remove(3);
+    }
+}
+
+
+int main(void)
+{
+    static const char *NAME[] = {"update", "insert", "remove"};
+    uint8_t registers[256];
+    uint8_t baseline[256];
+    CSimRegisterDevice device(DS323xMap::I2C, registers, sizeof(registers));
+    CTornBus bus;
+    CDS3232 rtc;
+
+    memset(registers, 0, sizeof(registers));
+    bus.Attach(device);
+    rtc.SetBus(bus);
+    rtc.Initialize();
+
+    // Keys 1-4 hold their number in every byte; key 2 then updated once so
+    // its bucket holds two live records
+    {
+        CSRAMStore store(rtc, 0, 128, VALUE_SIZE);
+        uint8_t value[VALUE_SIZE];
+
+        store.Format();
+
+        for (uint8_t key = 1; key <= 4; key++)
+        {
+            memset(value, key, sizeof(value));
+            store.Set(key, value);
+        }
+
+        memset(value, 0x22, sizeof(value));
+        store.Set(2, value);
+    }
+
+    memcpy(baseline, registers, sizeof(registers));
+
+    for (uint8_t op = 0; op < 3; op++)
+    {
+        Operation operation = (Operation)op;
+        uint8_t key = (operation == Operation::UPDATE) ? 2 : (operation == Operation::INSERT) ? 9 : 3;
+        uint8_t before = (operation == Operation::UPDATE) ? 0x22 : (operation == Operation::INSERT) ? 0 : 0x03;
+        uint8_t after = (operation == Operation::UPDATE) ? 0xB0 : (operation == Operation::INSERT) ? 0xC0 : 0;
+        uint32_t crashes = 0;
+        uint32_t kept = 0;
+        uint32_t applied = 0;
+        bool complete = false;
+
+        for (uint32_t transfer = 0; !complete; transfer++)
+        {
+            for (uint8_t tear = 0; tear <= RECORD_SIZE; tear++)
+            {
+                memcpy(registers, baseline, sizeof(registers));
+                bus.Reboot();
+                bus.m_tear = tear;
+                bus.InjectFailure(transfer);
+
+                CSRAMStore store(rtc, 0, 128, VALUE_SIZE);
+                CRTC::status_t status = Run(store, operation);
+                bool crashed = bus.m_down;
+
+                bus.Reboot();
+
+                if (!crashed)
+                {
+                    complete = true; // Operation needs fewer transfers
+                    break;
+                }
+
+                crashes++;
+
+                // After reset: the key reads as before or after, never torn
+                CSRAMStore recovered(rtc, 0, 128, VALUE_SIZE);
+                uint8_t value[VALUE_SIZE];
+                CRTC::status_t found = recovered.Get(key, value);
+                uint8_t seen = (found == CRTC::STATUS_OK) ? value[0] : 0;
+
+                Check((found == CRTC::STATUS_OK) || (found == CRTC::STATUS_ERROR), "lookup after power loss");
+                Check((seen == before) || (seen == after), "value old or new after power loss");
+                Check((status != CRTC::STATUS_OK) || (seen == after), "completed operation persisted");
+                kept += (seen == before);
+                applied += (seen == after) && (before != after);
+
+                for (uint8_t other = 1; other <= 4; other++)
+                {
+                    if (other != key)
+                    {
+                        Check((recovered.Get(other, value) == CRTC::STATUS_OK)
+                            && (value[0] == ((other == 2) ? 0x22 : other)), "other keys intact");
+                    }
+                }
+
+                // The store keeps working after recovery
+                uint8_t fresh[VALUE_SIZE] = {0xD0, 0xD1, 0xD2, 0xD3};
+                Check((recovered.Set(key, fresh) == CRTC::STATUS_OK)
+                    && (recovered.Get(key, value) == CRTC::STATUS_OK) && (value[0] == 0xD0), "update after recovery");
+            }
+        }
+
+        printf("%-7s %4u power losses: %u kept the old value, %u the new\n", NAME[op], crashes, kept, applied);
+    }
+
+    // Reserved keys are rejected before touching SRAM, with a tombstone and
+    // an empty bucket in the table
+    {
+        memcpy(registers, baseline, sizeof(registers));
+
+        CSRAMStore store(rtc, 0, 128, VALUE_SIZE);
+        const uint8_t reserved[] = {CSRAMStore::KEY_EMPTY, CSRAMStore::KEY_REMOVED};
+        uint8_t value[VALUE_SIZE] = {0x5A, 0x5A, 0x5A, 0x5A};
+
+        Check(store.Remove(4) == CRTC::STATUS_OK, "tombstone for key 4");
+        memcpy(baseline, registers, sizeof(registers));
+
+        for (uint8_t i = 0; i < sizeof(reserved); i++)
+        {
+            Check(store.Get(reserved[i], value) == CRTC::STATUS_INVALID, "Get of a reserved key");
+            Check(store.Set(reserved[i], value) == CRTC::STATUS_INVALID, "Set of a reserved key");
+            Check(store.Remove(reserved[i]) == CRTC::STATUS_INVALID, "Remove of a reserved key");
+        }
+
+        Check(value[0] == 0x5A, "value untouched by reserved keys");
+        Check(memcmp(registers, baseline, sizeof(registers)) == 0, "SRAM untouched by reserved keys");
+        Check(store.Get(4, value) == CRTC::STATUS_ERROR, "removed key stays absent");
+    }
+
+    printf("%s (%u failures)\n", g_failures ? "FAILED" : "PASSED", g_failures);
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        SoakTest.cpp
+ * @summary     Long horizon soak test of the DS3231 driver on a virtual clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+// Build on the host from the library root with
+//   g++ -std=gnu++11 -O2 -I. DS323x.cpp nRTC.cpp RTCBus.cpp SimBus.cpp
+//   SimDS323x.cpp VirtualClock.cpp extras/soak/SoakTest.cpp
+// Usage: soak_test [years] [seed]
+
+#include "DS323x.h"
+#include "SimDS323x.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+static const uint32_t CENTURY = 36525UL * 86400UL;
+static const uint64_t SECOND = 1000000;
+
+static CVirtualClock g_clock;
+static uint32_t g_interrupts = 0;
+static uint32_t g_state = 1;
+
+static void OnInterrupt(const uint64_t time)
+{
+    (void)time;
+    g_interrupts++;
+}
+
+
+static uint32_t Random(const uint32_t range)
+{
+    // xorshift32
+    g_state ^= (g_state << 13);
+    g_state ^= (g_state >> 17);
+    g_state ^= (g_state << 5);
+    return (g_state % range);
+}
+
+
+static uint8_t DaysInMonth(const uint8_t year, const uint8_t month)
+{
+    static const uint8_t days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return days[month - 1] + (((month == 2) && ((year % 4) == 0)) ? 1 : 0);
+}
+
+
+static bool Matches(const CRTC::RTC &rtc, const uint32_t epoch)
+{
+    CRTC::Timestamp time(epoch);
+
+    return (rtc.second == time.Second()) && (rtc.minute == time.Minute())
+        && (rtc.hour == time.Hour()) && (rtc.day == time.Day())
+        && (rtc.month == time.Month()) && (rtc.year == time.Year());
+}
+
+
+int main(int argc, char *argv[])
+{
+    uint32_t years = (argc > 1) ? atoi(argv[1]) : 5;
+    g_state = (argc > 2) ? atoi(argv[2]) : 1;
+
+    CSimDS323x model(g_clock);
+    CSimBus bus;
+    CDS3231 rtc;
+    CRTC::RTC read;
+    uint32_t rollover_errors = 0;
+
+    bus.Attach(model);
+    g_clock.Attach(model);
+    model.SetInterruptCallback(OnInterrupt);
+    rtc.SetBus(bus);
+    rtc.Initialize();
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Every month and year transition from 2000 to the 2099 wrap, with the
+    // week day register seeded by the driver's DayOfWeek
+    for (uint8_t year = 0; year < 100; year++)
+    {
+        for (uint8_t month = 1; month <= 12; month++)
+        {
+            uint32_t last = CRTC::Timestamp(year, month, 1, 23, 59, 59).epoch
+                + ((DaysInMonth(year, month) - 1) * 86400UL);
+            uint32_t next = (last + 1) % CENTURY;
+            CRTC::RTC rtc_last;
+
+            CRTC::Timestamp(last).ToRTC(rtc_last);
+            rtc.SetRTC(rtc_last);
+            g_clock.Step(SECOND);
+
+            // Week day counter keeps counting across the century wrap
+            uint8_t week_day = (CRTC::Timestamp(last).WeekDay() % 7) + 1;
+
+            if ((rtc.GetRTC(read) != CRTC::STATUS_OK) || !Matches(read, next) || (read.week_day != week_day)
+                || (model.GetCentury() != (next < last)))
+            {
+                printf("rollover error after %02u-%02u-%02u\n", rtc_last.year, rtc_last.month, rtc_last.day);
+                rollover_errors++;
+            }
+        }
+    }
+
+    // Daily alarms at random times through years of simulated time,
+    // starting late enough to cross the 2099 to 2000 wrap
+    CRTC::RTC origin;
+    CRTC::Timestamp(97, 1 + Random(12), 1 + Random(28), Random(24), Random(60), Random(60)).ToRTC(origin);
+    rtc.SetRTC(origin);
+    g_clock.Step(Random(SECOND));
+
+    uint64_t end = g_clock.Now() + (years * 36525ULL * 864ULL * SECOND);
+    uint32_t alarms = 0;
+    uint32_t missed = 0;
+    uint32_t early = 0;
+    uint32_t mismatched = 0;
+    uint32_t interrupts = 0;
+    uint32_t wraps = 0;
+
+    while (g_clock.Now() < end)
+    {
+        uint8_t hour = Random(24);
+        uint8_t minute = Random(60);
+        uint8_t second = Random(60);
+
+        if (rtc.SetAlarmTime(hour, minute, second) != CRTC::STATUS_OK)
+        {
+            mismatched++;
+            continue;
+        }
+
+        // Seconds until the next match, from the model's own time
+        uint32_t now = model.GetEpoch();
+        uint32_t target = (3600UL * hour) + (60UL * minute) + second;
+        uint32_t delay = (target + 86400 - (now % 86400)) % 86400;
+
+        if (delay == 0)
+        {
+            delay = 86400;
+        }
+
+        g_clock.Step((delay - 1) * SECOND);
+
+        if (rtc.IsAlarmTriggered())
+        {
+            early++;
+        }
+
+        interrupts = g_interrupts;
+        g_clock.Step(SECOND);
+        alarms++;
+
+        if (!rtc.IsAlarmTriggered() || (g_interrupts != (interrupts + 1)))
+        {
+            missed++;
+        }
+
+        uint32_t expected = (now + delay) % CENTURY;
+
+        if ((rtc.GetRTC(read) != CRTC::STATUS_OK) || !Matches(read, expected))
+        {
+            mismatched++;
+        }
+
+        wraps += (expected < now) ? 1 : 0;
+        rtc.AlarmReset();
+
+        // Idle a random part of a day before the next alarm
+        g_clock.Step(Random(43200) * SECOND + Random(SECOND));
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double days = g_clock.Now() / (86400.0 * SECOND);
+
+    printf("rollovers: 1200 checked, %u errors\n", rollover_errors);
+    printf("alarms: %u fired, %u missed, %u early, %u time mismatches, %u century wraps\n",
+        alarms, missed, early, mismatched, wraps);
+    printf("simulated %.0f days in %.2f s (%.0f days/s), %u bus transfers, %u clock events\n",
+        days, elapsed, days / elapsed, bus.GetTransfers(), g_clock.GetEvents());
+
+    return (rollover_errors || missed || early || mismatched) ? 1 : 0;
+}
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        TimeZoneTest.cpp
+ * @summary     Time zone transitions, local conversion and local alarms
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+// Build on the host from the library root with
+//   g++ -std=gnu++11 -O2 -I. DS323x.cpp nRTC.cpp RTCBus.cpp SimBus.cpp
+//   SimDS323x.cpp TimeZone.cpp VirtualClock.cpp extras/timezone/TimeZoneTest.cpp
+
+#include "DS323x.h"
+#include "SimDS323x.h"
+#include "TimeZone.h"
+#include <cstdio>
+
+static CVirtualClock g_clock;
+static uint32_t g_failures = 0;
+
+
+static void Check(const bool condition, const char *message)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", message);
+        g_failures++;
+    }
+}
+
+
+// Offset one second before and at a transition instant
+static void CheckTransition(const CTimeZone &zone, const CRTC::Timestamp utc,
+                            const int16_t before, const int16_t after, const char *message)
+{
+    Check((zone.GetOffset(CRTC::Timestamp(utc.epoch - 1)) == before)
+        && (zone.GetOffset(utc) == after), message);
+}
+
+
+static void TestTransitions(void)
+{
+    const CTimeZone &eu = TIMEZONE_CENTRAL_EUROPE;
+    const CTimeZone &us = TIMEZONE_US_EASTERN;
+
+    // EU changes at 01:00 UTC on the last Sunday of March and October
+    CheckTransition(eu, CRTC::Timestamp(26, 3, 29, 1, 0, 0), 60, 120, "EU spring 2026");
+    CheckTransition(eu, CRTC::Timestamp(26, 10, 25, 1, 0, 0), 120, 60, "EU autumn 2026");
+    CheckTransition(eu, CRTC::Timestamp(0, 3, 26, 1, 0, 0), 60, 120, "EU spring 2000");
+    CheckTransition(eu, CRTC::Timestamp(99, 10, 25, 1, 0, 0), 120, 60, "EU autumn 2099");
+
+    // US changes at 02:00 local, with the 2007 rule change
+    CheckTransition(us, CRTC::Timestamp(6, 4, 2, 7, 0, 0), -300, -240, "US spring 2006");
+    CheckTransition(us, CRTC::Timestamp(6, 10, 29, 6, 0, 0), -240, -300, "US autumn 2006");
+    CheckTransition(us, CRTC::Timestamp(7, 3, 11, 7, 0, 0), -300, -240, "US spring 2007");
+    CheckTransition(us, CRTC::Timestamp(26, 3, 8, 7, 0, 0), -300, -240, "US spring 2026");
+    CheckTransition(us, CRTC::Timestamp(26, 11, 1, 6, 0, 0), -240, -300, "US autumn 2026");
+
+    Check(eu.IsDST(CRTC::Timestamp(26, 7, 1, 12, 0, 0)) && !eu.IsDST(CRTC::Timestamp(26, 1, 1, 12, 0, 0)),
+        "EU summer and winter");
+    Check(TIMEZONE_UTC.GetOffset(CRTC::Timestamp(26, 7, 1, 12, 0, 0)) == 0, "UTC has no offset");
+
+    Check(eu.ToLocal(CRTC::Timestamp(26, 3, 29, 0, 59, 59)).epoch
+        == CRTC::Timestamp(26, 3, 29, 1, 59, 59).epoch, "EU local before spring");
+    Check(eu.ToLocal(CRTC::Timestamp(26, 3, 29, 1, 0, 0)).epoch
+        == CRTC::Timestamp(26, 3, 29, 3, 0, 0).epoch, "EU local at spring");
+    Check(us.ToLocal(CRTC::Timestamp(26, 11, 1, 5, 59, 59)).epoch
+        == CRTC::Timestamp(26, 11, 1, 1, 59, 59).epoch, "US local before autumn");
+    Check(us.ToLocal(CRTC::Timestamp(26, 11, 1, 6, 0, 0)).epoch
+        == CRTC::Timestamp(26, 11, 1, 1, 0, 0).epoch, "US local at autumn");
+
+    // Offsets that would leave 2000-2099 saturate instead of wrapping
+    Check(us.ToLocal(CRTC::Timestamp(0)).epoch == 0, "US local at the start of 2000");
+    Check(eu.ToUTC(CRTC::Timestamp(0)).epoch == 0, "EU UTC at the start of 2000");
+    Check(eu.ToLocal(CRTC::Timestamp(99, 12, 31, 23, 30, 0)).epoch
+        == CRTC::Timestamp(99, 12, 31, 23, 59, 59).epoch, "EU local at the end of 2099");
+    Check(us.ToUTC(CRTC::Timestamp(99, 12, 31, 23, 30, 0)).epoch
+        == CRTC::Timestamp(99, 12, 31, 23, 59, 59).epoch, "US UTC at the end of 2099");
+}
+
+
+static void TestToUTC(void)
+{
+    const CTimeZone &eu = TIMEZONE_CENTRAL_EUROPE;
+    const CTimeZone &us = TIMEZONE_US_EASTERN;
+
+    // Round trip; only the second pass through a repeated hour maps back
+    // to the first occurrence
+    const CTimeZone *zones[] = {&eu, &us};
+
+    for (uint8_t z = 0; z < 2; z++)
+    {
+        const CTimeZone &zone = *zones[z];
+
+        for (uint32_t epoch = 86400; epoch < CRTC::Timestamp(99, 12, 31, 0, 0, 0).epoch; epoch += 86400UL * 3 + 3607)
+        {
+            if (zone.ToUTC(zone.ToLocal(CRTC::Timestamp(epoch))).epoch != epoch)
+            {
+                Check(zone.IsDST(CRTC::Timestamp(epoch - 3600)) && !zone.IsDST(CRTC::Timestamp(epoch)),
+                    "round trip outside a repeated hour");
+            }
+        }
+    }
+
+    // Gap: a skipped local time moves forward by the gap
+    Check(eu.ToUTC(CRTC::Timestamp(26, 3, 29, 2, 30, 0)).epoch
+        == CRTC::Timestamp(26, 3, 29, 1, 30, 0).epoch, "EU skipped hour");
+    Check(us.ToUTC(CRTC::Timestamp(26, 3, 8, 2, 30, 0)).epoch
+        == CRTC::Timestamp(26, 3, 8, 7, 30, 0).epoch, "US skipped hour");
+    Check(eu.ToLocal(eu.ToUTC(CRTC::Timestamp(26, 3, 29, 2, 30, 0))).epoch
+        == CRTC::Timestamp(26, 3, 29, 3, 30, 0).epoch, "EU skipped hour reads back an hour later");
+
+    // Overlap: a repeated local time resolves to its first occurrence
+    Check(eu.ToUTC(CRTC::Timestamp(26, 10, 25, 2, 30, 0)).epoch
+        == CRTC::Timestamp(26, 10, 25, 0, 30, 0).epoch, "EU repeated hour");
+    Check(us.ToUTC(CRTC::Timestamp(26, 11, 1, 1, 30, 0)).epoch
+        == CRTC::Timestamp(26, 11, 1, 5, 30, 0).epoch, "US repeated hour");
+
+    // Either side of the gap and overlap is unambiguous
+    Check(eu.ToUTC(CRTC::Timestamp(26, 3, 29, 1, 59, 59)).epoch
+        == CRTC::Timestamp(26, 3, 29, 0, 59, 59).epoch, "EU before the gap");
+    Check(eu.ToUTC(CRTC::Timestamp(26, 3, 29, 3, 0, 0)).epoch
+        == CRTC::Timestamp(26, 3, 29, 1, 0, 0).epoch, "EU after the gap");
+    Check(us.ToUTC(CRTC::Timestamp(26, 11, 1, 2, 0, 0)).epoch
+        == CRTC::Timestamp(26, 11, 1, 7, 0, 0).epoch, "US after the overlap");
+}
+
+
+// Arms the alarm in local time at utc and runs the chip until it fires
+static void RunAlarm(CDS3231 &rtc, const CTimeZone &zone, const CRTC::Timestamp utc,
+                     const uint8_t hour, const uint8_t minute, const CRTC::Timestamp expected,
+                     const char *message)
+{
+    CRTC::RTC now;
+    CRTC::RTC local;
+    CRTC::RTC alarm;
+    bool triggered = true;
+
+    utc.ToRTC(now);
+    rtc.SetRTC(now);
+    rtc.AlarmReset();
+    local.hour = hour;
+    local.minute = minute;
+
+    Check(zone.SetAlarmLocal(rtc, local) == CRTC::STATUS_OK, message);
+    Check((rtc.GetAlarmRTC(alarm) == CRTC::STATUS_OK) && (alarm.hour == expected.Hour())
+        && (alarm.minute == expected.Minute()) && (alarm.second == 0), message);
+
+    // Quiet until the expected UTC instant, then fired
+    g_clock.Step(1000000ULL * (expected.epoch - utc.epoch - 1));
+    Check((rtc.IsAlarmTriggered(triggered) == CRTC::STATUS_OK) && !triggered, message);
+    g_clock.Step(2000000ULL);
+    Check((rtc.IsAlarmTriggered(triggered) == CRTC::STATUS_OK) && triggered, message);
+    Check((zone.GetLocalRTC(rtc, local) == CRTC::STATUS_OK)
+        && (local.hour == hour) && (local.minute == minute), message);
+
+    printf("alarm %02u:%02u local -> %02u:%02u UTC, fired at %02u:%02u:%02u local\n",
+        hour, minute, alarm.hour, alarm.minute, local.hour, local.minute, local.second);
+}
+
+
+static void TestAlarm(void)
+{
+    CSimBus bus;
+    CSimDS323x chip(g_clock);
+    CDS3231 rtc;
+
+    bus.Attach(chip);
+    g_clock.Attach(chip);
+    rtc.SetBus(bus);
+    rtc.Initialize();
+
+    // Armed in CET for a morning in CEST
+    RunAlarm(rtc, TIMEZONE_CENTRAL_EUROPE, CRTC::Timestamp(26, 3, 28, 23, 0, 0), 6, 30,
+        CRTC::Timestamp(26, 3, 29, 4, 30, 0), "EU alarm across spring");
+
+    // Already past today: the next morning, in CET again
+    RunAlarm(rtc, TIMEZONE_CENTRAL_EUROPE, CRTC::Timestamp(26, 10, 24, 12, 0, 0), 6, 30,
+        CRTC::Timestamp(26, 10, 25, 5, 30, 0), "EU alarm across autumn");
+
+    // Armed in EDT for a morning in EST
+    RunAlarm(rtc, TIMEZONE_US_EASTERN, CRTC::Timestamp(26, 11, 1, 4, 0, 0), 7, 0,
+        CRTC::Timestamp(26, 11, 1, 12, 0, 0), "US alarm across autumn");
+
+    // Local time written through the zone lands as UTC on the chip
+    CRTC::RTC local;
+    CRTC::RTC utc;
+
+    CRTC::Timestamp(26, 7, 1, 12, 0, 0).ToRTC(local);
+    Check(TIMEZONE_US_EASTERN.SetLocalRTC(rtc, local) == CRTC::STATUS_OK, "set local time");
+    Check((rtc.GetRTC(utc) == CRTC::STATUS_OK) && (utc.hour == 16) && (utc.day == 1), "chip runs in UTC");
+}
+
+
+int main(void)
+{
+    TestTransitions();
+    TestToUTC();
+    TestAlarm();
+
+    printf("%s (%u failures)\n", g_failures ? "FAILED" : "PASSED", g_failures);
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2018 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        TraceReplayTest.cpp
+ * @summary     Record a DS3231 session and replay it strictly, relaxed and with a mismatch
+ * @version     1.0
+ * @author      nitacku
+ * @data        19 October 2026
+ */
+
+// Build on the host from the library root with
+//   g++ -std=gnu++11 -O2 -I. DS323x.cpp nRTC.cpp RTCBus.cpp SimBus.cpp
+//   SimDS323x.cpp TraceBus.cpp VirtualClock.cpp extras/trace/TraceReplayTest.cpp
+
+#include "DS323x.h"
+#include "SimDS323x.h"
+#include "TraceBus.h"
+#include <cstdio>
+
+static CVirtualClock g_clock;
+static uint8_t g_trace[2048];
+static uint32_t g_size = 0;
+static uint32_t g_failures = 0;
+
+
+static void Check(const bool condition, const char *message)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s\n", message);
+        g_failures++;
+    }
+}
+
+
+static void Sink(const uint8_t data[], const uint8_t bytes)
+{
+    for (uint8_t i = 0; (i < bytes) && (g_size < sizeof(g_trace)); i++)
+    {
+        g_trace[g_size++] = data[i];
+    }
+}
+
+
+static uint32_t Tick(void)
+{
+    return (uint32_t)g_clock.Now();
+}
+
+
+struct Result
+{
+    CRTC::RTC time;
+    CRTC::RTC later;
+    bool triggered;
+    float temperature;
+};
+
+
+static bool Same(const CRTC::RTC &a, const CRTC::RTC &b)
+{
+    return (a.year == b.year) && (a.month == b.month) && (a.day == b.day)
+        && (a.hour == b.hour) && (a.minute == b.minute) && (a.second == b.second);
+}
+
+
+// Set the time, arm an alarm a few seconds out and watch it fire
+static void Session(CDS3231 &rtc, const uint8_t second, Result &result, const bool step)
+{
+    CRTC::RTC time;
+    CRTC::RTC alarm;
+
+    time.year = 26;
+    time.month = 10;
+    time.day = 19;
+    time.hour = 6;
+    time.minute = 29;
+    time.second = second;
+    alarm.hour = 6;
+    alarm.minute = 30;
+
+    rtc.Initialize();
+    rtc.SetRTC(time);
+    rtc.SetAlarmRTC(alarm);
+    rtc.GetRTC(result.time);
+
+    if (step)
+    {
+        g_clock.Step(5000000ULL);
+    }
+
+    rtc.GetRTC(result.later);
+    rtc.IsAlarmTriggered(result.triggered);
+    rtc.GetTemperature(result.temperature);
+}
+
+
+int main(void)
+{
+    CSimBus bus;
+    CSimDS323x chip(g_clock);
+    CTraceBus trace(bus, Sink, Tick);
+    CDS3231 recorder;
+    Result recorded = {};
+
+    bus.Attach(chip);
+    g_clock.Attach(chip);
+    recorder.SetBus(trace);
+    trace.Start();
+    Session(recorder, 57, recorded, true);
+    trace.Stop();
+
+    Check(recorded.triggered && (recorded.later.minute == 30) && (recorded.later.second == 2), "recorded session");
+    printf("recorded: %u bytes, %02u:%02u:%02u -> %02u:%02u:%02u, alarm %s\n", g_size,
+        recorded.time.hour, recorded.time.minute, recorded.time.second,
+        recorded.later.hour, recorded.later.minute, recorded.later.second,
+        recorded.triggered ? "fired" : "idle");
+
+    // Strict: the same driver calls reproduce every transfer and value
+    {
+        CReplayBus replay(g_trace, g_size);
+        CDS3231 rtc;
+        Result result = {};
+
+        Check(replay.IsValid(), "trace header");
+        rtc.SetBus(replay);
+        Session(rtc, 57, result, false);
+
+        Check(replay.GetDivergences() == 0, "strict replay without divergence");
+        Check(replay.IsFinished(), "strict replay consumed the trace");
+        Check(Same(result.time, recorded.time) && Same(result.later, recorded.later), "strict times");
+        Check(result.triggered && (result.temperature == recorded.temperature), "strict alarm and temperature");
+        Check(replay.GetTraceTime() >= 5000000UL, "recorded timing carried through");
+        printf("strict: %u transfers, %u divergences, trace time %u us\n",
+            replay.GetTransfers(), replay.GetDivergences(), replay.GetTraceTime());
+    }
+
+    // Relaxed: a driver that skips the alarm setup still gets the recorded reads
+    {
+        CReplayBus replay(g_trace, g_size);
+        CDS3231 rtc;
+        CRTC::RTC later;
+        bool triggered = false;
+
+        replay.SetStrict(false);
+        rtc.SetBus(replay);
+        rtc.Initialize();
+        rtc.SetRTC(recorded.time);
+
+        Check(rtc.GetRTC(later) == CRTC::STATUS_OK, "relaxed read served");
+        Check((rtc.IsAlarmTriggered(triggered) == CRTC::STATUS_OK) && triggered, "relaxed flag served");
+        Check(replay.GetDivergences() == 0, "relaxed replay skips the unused records");
+        printf("relaxed: %u transfers, %u divergences, first read %02u:%02u:%02u\n",
+            replay.GetTransfers(), replay.GetDivergences(), later.hour, later.minute, later.second);
+    }
+
+    // Mismatch: a different time written is counted but replay continues
+    {
+        CReplayBus replay(g_trace, g_size);
+        CDS3231 rtc;
+        Result result = {};
+
+        rtc.SetBus(replay);
+        Session(rtc, 58, result, false);
+
+        Check(replay.GetDivergences() == 1, "one divergence for the changed write");
+        Check(Same(result.later, recorded.later) && result.triggered, "reads still served after the mismatch");
+        printf("mismatch: %u transfers, %u divergence\n", replay.GetTransfers(), replay.GetDivergences());
+    }
+
+    // Re-initialized: a trace across several Initialize calls keeps one handle
+    {
+        const uint8_t SESSIONS = 6;
+        CRTC::RTC time[SESSIONS];
+        bool recorded_ok = true;
+        bool replayed_ok = true;
+
+        g_size = 0;
+        trace.Start();
+
+        for (uint8_t i = 0; i < SESSIONS; i++)
+        {
+            recorder.Initialize();
+            recorded_ok &= (recorder.GetRTC(time[i]) == CRTC::STATUS_OK);
+            g_clock.Step(1000000ULL);
+        }
+
+        trace.Stop();
+        Check(recorded_ok, "reads recorded across re-initialization");
+
+        CReplayBus replay(g_trace, g_size);
+        CDS3231 rtc;
+
+        rtc.SetBus(replay);
+
+        for (uint8_t i = 0; i < SESSIONS; i++)
+        {
+            CRTC::RTC result;
+
+            rtc.Initialize();
+            replayed_ok &= (rtc.GetRTC(result) == CRTC::STATUS_OK) && Same(result, time[i]);
+        }
+
+        Check(replayed_ok, "reads replayed across re-initialization");
+        Check((replay.GetDivergences() == 0) && replay.IsFinished(), "re-initialized replay matches");
+        printf("re-initialized: %u sessions, %u transfers, %u divergences\n",
+            SESSIONS, replay.GetTransfers(), replay.GetDivergences());
+    }
+
+    printf("%s (%u failures)\n", g_failures ? "FAILED" : "PASSED", g_failures);
+    return g_failures ? 1 : 0;
+}
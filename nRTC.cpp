@@ -26,67 +26,153 @@
  */
 
 #include "nRTC.h"
+#include "RTCPlatform.h"
 
 CRTC::CRTC(void)
+    : m_scope{nullptr}
+    , m_bus{CRTCBus::GetDefault()}
+    , m_bus_handle{CRTCBus::HANDLE_INVALID}
+    , m_speed{CRTCBus::Speed::FAST}
+    , m_recovery{nullptr}
+    , m_backoff{100}
+    , m_timeout{25}
+    , m_retries{2}
+    , m_status{STATUS_OK}
 {
 }
 
 
+void CRTC::SetBus(CRTCBus &bus, const CRTCBus::Speed speed)
+{
+    m_bus = &bus;
+    m_speed = speed;
+}
+
+
 void CRTC::Initialize(void)
 {
-    m_i2c_handle = nI2C->RegisterDevice(GetI2CAddress(), 1, CI2C::Speed::FAST);
+    if (m_bus)
+    {
+        m_bus_handle = m_bus->RegisterDevice(GetI2CAddress(), m_speed);
+    }
 }
 
 
 uint32_t CRTC::GetTimeSeconds(void)
 {
-    GetRTC(m_rtc); // Populate rtc with current values
+    RTC rtc;
 
-    return GetSeconds(m_rtc);
+    GetRTC(rtc); // Populate rtc with current values
+
+    return GetSeconds(rtc);
 }
 
 
-void CRTC::GetTime(uint8_t &hour, uint8_t &minute, uint8_t &second)
+CRTC::status_t CRTC::GetTime(uint8_t &hour, uint8_t &minute, uint8_t &second)
 {
-    GetRTC(m_rtc); // Populate rtc with current values
+    RTC rtc;
+    status_t status = GetRTC(rtc); // Populate rtc with current values
+
+    second = rtc.second;
+    minute = rtc.minute;
+    hour = rtc.hour;
 
-    second = m_rtc.second;
-    minute = m_rtc.minute;
-    hour = m_rtc.hour;
+    return status;
 }
 
 
-void CRTC::GetDate(uint8_t &year, uint8_t &month, uint8_t &day)
+CRTC::status_t CRTC::GetDate(uint8_t &year, uint8_t &month, uint8_t &day)
 {
-    GetRTC(m_rtc); // Populate rtc with current values
+    RTC rtc;
+    status_t status = GetRTC(rtc); // Populate rtc with current values
 
-    day = m_rtc.day;
-    month = m_rtc.month;
-    year = m_rtc.year;
+    day = rtc.day;
+    month = rtc.month;
+    year = rtc.year;
+
+    return status;
 }
 
 
 CRTC::status_t CRTC::SetTime(const uint8_t hour, const uint8_t minute, const uint8_t second)
 {
-    GetRTC(m_rtc); // Populate rtc with current values
+    RTC rtc;
+    status_t status = GetRTC(rtc); // Populate rtc with current values
+
+    // Never write back a date that was not read from the device; out of
+    // range registers were replaced by the cached time and may be repaired
+    if ((status != STATUS_OK) && (status != STATUS_HALTED) && (status != STATUS_INVALID))
+    {
+        return status;
+    }
 
-    m_rtc.second = second;
-    m_rtc.minute = minute;
-    m_rtc.hour = hour;
+    rtc.second = second;
+    rtc.minute = minute;
+    rtc.hour = hour;
 
-    return SetRTC(m_rtc);
+    return SetRTC(rtc);
 }
 
 
 CRTC::status_t CRTC::SetDate(const uint8_t year, const uint8_t month, const uint8_t day)
 {
-    GetRTC(m_rtc); // Populate rtc with current values
+    RTC rtc;
+    status_t status = GetRTC(rtc); // Populate rtc with current values
+
+    // Never write back a time that was not read from the device; out of
+    // range registers were replaced by the cached time and may be repaired
+    if ((status != STATUS_OK) && (status != STATUS_HALTED) && (status != STATUS_INVALID))
+    {
+        return status;
+    }
+
+    rtc.day = day;
+    rtc.month = month;
+    rtc.year = year;
+
+    return SetRTC(rtc);
+}
+
+
+uint32_t CRTC::GetEpoch(void)
+{
+    Timestamp time;
+
+    GetTimestamp(time);
+    return time.epoch;
+}
+
+
+CRTC::status_t CRTC::GetEpoch(uint32_t &epoch)
+{
+    Timestamp time;
+    status_t status = GetTimestamp(time);
+
+    epoch = time.epoch;
+    return status;
+}
+
+
+CRTC::status_t CRTC::GetTimestamp(Timestamp &time)
+{
+    RTC rtc;
+    status_t status = GetRTC(rtc); // Populate cache with current values
+
+    time = m_time;
+    return status;
+}
+
+
+// Valid from 2000-01-01 to 2099-12-31
+uint32_t CRTC::ToEpoch(const RTC &rtc)
+{
+    return Timestamp(rtc).epoch;
+}
 
-    m_rtc.day = day;
-    m_rtc.month = month;
-    m_rtc.year = year;
 
-    return SetRTC(m_rtc);
+void CRTC::FromEpoch(const uint32_t epoch, RTC &rtc)
+{
+    Timestamp(epoch).ToRTC(rtc);
 }
 
 
@@ -143,39 +229,326 @@ float CRTC::ConvertTemperature(const float temperature, const Unit input_unit, c
 
 CRTC::status_t CRTC::SetAlarmTime(const uint8_t hour, const uint8_t minute, const uint8_t second)
 {
-    m_rtc.second = second;
-    m_rtc.minute = minute;
-    m_rtc.hour = hour;
+    RTC rtc;
+
+    rtc.second = second;
+    rtc.minute = minute;
+    rtc.hour = hour;
     
-    return SetAlarmRTC(m_rtc);
+    return SetAlarmRTC(rtc);
+}
+
+
+CRTC::status_t CRTC::GetAlarmState(State &state)
+{
+    // Drivers without their own overload report the status of their read
+    m_status = STATUS_OK;
+
+    State result = GetAlarmState();
+
+    if (m_status == STATUS_OK)
+    {
+        state = result;
+    }
+
+    return m_status;
 }
 
 
-void CRTC::GetAlarmTime(uint8_t &hour, uint8_t &minute, uint8_t &second)
+CRTC::status_t CRTC::IsAlarmTriggered(bool &triggered)
 {
-    GetAlarmRTC(m_rtc);
+    m_status = STATUS_OK;
+
+    bool result = IsAlarmTriggered();
 
-    second = m_rtc.second;
-    minute = m_rtc.minute;
-    hour = m_rtc.hour;
+    if (m_status == STATUS_OK)
+    {
+        triggered = result;
+    }
+
+    return m_status;
+}
+
+
+CRTC::status_t CRTC::SetAlarmImage(const AlarmImage &alarm)
+{
+    RTC rtc;
+
+    rtc.second = BCD_to_DEC(alarm.second);
+    rtc.minute = BCD_to_DEC(alarm.minute);
+    rtc.hour = BCD_to_DEC(alarm.hour);
+
+    return SetAlarmRTC(rtc);
+}
+
+
+CRTC::status_t CRTC::GetAlarmTime(uint8_t &hour, uint8_t &minute, uint8_t &second)
+{
+    RTC rtc;
+    status_t status = GetAlarmRTC(rtc);
+
+    second = rtc.second;
+    minute = rtc.minute;
+    hour = rtc.hour;
+
+    return status;
 }
 
 
 uint32_t CRTC::GetAlarmSeconds(void)
 {
-    GetAlarmRTC(m_rtc);
-    return GetSeconds(m_rtc);
+    RTC rtc;
+
+    GetAlarmRTC(rtc);
+    return GetSeconds(rtc);
+}
+
+
+void CRTC::SetRetry(const uint8_t retries, const uint16_t backoff_us, const uint16_t timeout_ms)
+{
+    m_retries = retries;
+    m_backoff = backoff_us;
+    m_timeout = timeout_ms;
+}
+
+
+void CRTC::SetBusRecovery(const recovery_t recovery)
+{
+    m_recovery = recovery;
+}
+
+
+// Status of the most recent bus transaction
+CRTC::status_t CRTC::GetStatus(void)
+{
+    return m_status;
+}
+
+
+// Release a slave holding SDA low by clocking SCL until it lets go.
+// The TWI peripheral must be disabled by the caller and re-enabled after.
+void CRTC::RecoverBus(const uint8_t scl_pin, const uint8_t sda_pin)
+{
+#if defined(ARDUINO)
+    pinMode(sda_pin, INPUT_PULLUP);
+    pinMode(scl_pin, INPUT_PULLUP);
+
+    for (uint8_t i = 0; (i < 9) && (digitalRead(sda_pin) == LOW); i++)
+    {
+        pinMode(scl_pin, OUTPUT);
+        digitalWrite(scl_pin, LOW);
+        delayMicroseconds(5);
+        pinMode(scl_pin, INPUT_PULLUP);
+        delayMicroseconds(5);
+    }
+
+    // Generate a STOP condition: SDA low to high while SCL is high
+    pinMode(sda_pin, OUTPUT);
+    digitalWrite(sda_pin, LOW);
+    delayMicroseconds(5);
+    pinMode(sda_pin, INPUT_PULLUP);
+    delayMicroseconds(5);
+#else
+    UNUSED(scl_pin); // Host adapters recover in the kernel driver
+    UNUSED(sda_pin);
+#endif
+}
+
+
+CRTC::status_t CRTC::GetSRAM(const uint8_t offset, uint8_t data[], const uint8_t bytes)
+{
+    UNUSED(offset);
+    UNUSED(data);
+    UNUSED(bytes);
+    return STATUS_ERROR;
+}
+
+
+CRTC::status_t CRTC::SetSRAM(const uint8_t offset, const uint8_t data[], const uint8_t bytes)
+{
+    UNUSED(offset);
+    UNUSED(data);
+    UNUSED(bytes);
+    return STATUS_ERROR;
+}
+
+
+uint8_t CRTC::GetSRAMSize(void)
+{
+    return 0;
+}
+
+
+CRTC::status_t CRTC::GetRTCAndSRAM(RTC &rtc, const uint8_t offset, uint8_t data[], const uint8_t bytes)
+{
+    status_t status = GetRTC(rtc);
+    status_t sram = GetSRAM(offset, data, bytes);
+
+    return (sram != STATUS_OK) ? sram : status;
+}
+
+
+uint32_t CRTC::GetReferenceFrequency(void)
+{
+    return 0;
+}
+
+
+CRTC::status_t CRTC::StartReference(uint8_t &saved)
+{
+    UNUSED(saved);
+    return STATUS_ERROR;
+}
+
+
+CRTC::status_t CRTC::StopReference(const uint8_t saved)
+{
+    UNUSED(saved);
+    return STATUS_ERROR;
+}
+
+
+CRTC::ReadScope::ReadScope(CRTC &rtc)
+    : m_rtc(rtc)
+    , m_status{STATUS_ERROR}
+    , m_address{0}
+    , m_bytes{0}
+{
+    uint8_t address = 0;
+    uint8_t bytes = 0;
+
+    if (rtc.m_scope != nullptr)
+    {
+        m_status = rtc.m_scope->m_status;
+        return; // Outer scope already serves reads
+    }
+
+    rtc.GetScopeRange(address, bytes);
+
+    if ((bytes == 0) || (bytes > SCOPE_SIZE))
+    {
+        return;
+    }
+
+    m_status = rtc.I2CTransfer(false, address, m_data, bytes);
+
+    if (m_status == STATUS_OK)
+    {
+        m_address = address;
+        m_bytes = bytes;
+        rtc.m_scope = this;
+    }
+}
+
+
+CRTC::ReadScope::~ReadScope()
+{
+    if (m_rtc.m_scope == this)
+    {
+        m_rtc.m_scope = nullptr;
+    }
+}
+
+
+bool CRTC::ReadScope::IsValid(void) const
+{
+    return (m_status == STATUS_OK);
+}
+
+
+CRTC::status_t CRTC::ReadScope::GetStatus(void) const
+{
+    return m_status;
+}
+
+
+bool CRTC::ReadScope::Read(const uint8_t address, uint8_t data[], const uint8_t bytes) const
+{
+    // Only requests entirely inside the window are served
+    if ((address < m_address) || (((uint16_t)address + bytes) > ((uint16_t)m_address + m_bytes)))
+    {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < bytes; i++)
+    {
+        data[i] = m_data[address - m_address + i];
+    }
+
+    return true;
+}
+
+
+void CRTC::ReadScope::Write(const uint8_t address, const uint8_t data[], const uint8_t bytes)
+{
+    for (uint8_t i = 0; i < bytes; i++)
+    {
+        uint16_t reg = (uint16_t)address + i;
+
+        // The chip no longer holds what was written; stop serving the window
+        if ((reg < 0x100) && m_rtc.IsScopeVolatile(reg))
+        {
+            m_bytes = 0;
+            m_rtc.m_scope = nullptr;
+            return;
+        }
+    }
+
+    for (uint8_t i = 0; i < bytes; i++)
+    {
+        uint16_t reg = (uint16_t)address + i;
+
+        if ((reg >= m_address) && (reg < ((uint16_t)m_address + m_bytes)))
+        {
+            m_data[reg - m_address] = data[i];
+        }
+    }
 }
 
 
 /// Protected Functions ---------------------------------------
 
+void CRTC::GetScopeRange(uint8_t &address, uint8_t &bytes)
+{
+    address = 0;
+    bytes = 0;
+}
+
+
+bool CRTC::IsScopeVolatile(const uint8_t address)
+{
+    UNUSED(address);
+    return false;
+}
+
+
 uint32_t CRTC::GetSeconds(const CRTC::RTC &rtc)
 {
     return ((3600 * (uint32_t)rtc.hour) + (60 * (uint32_t)rtc.minute) + (uint32_t)rtc.second);
 }
 
 
+// Range check decoded registers and cache them as the last valid time
+CRTC::status_t CRTC::ValidateRTC(RTC &rtc, const bool halted)
+{
+    static const uint8_t t[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+    if ((rtc.second > 59) || (rtc.minute > 59) || (rtc.hour > 23) || (rtc.year > 99)
+        || (rtc.week_day < 1) || (rtc.week_day > 7)
+        || (rtc.month < 1) || (rtc.month > 12) || (rtc.day < 1)
+        || (rtc.day > (t[rtc.month - 1] + ((rtc.month == 2) && ((rtc.year % 4) == 0)))))
+    {
+        m_time.ToRTC(rtc); // Fall back to cached value
+
+        // A stopped oscillator explains the garbage; report the cause
+        return halted ? STATUS_HALTED : STATUS_INVALID;
+    }
+
+    m_time = Timestamp(rtc);
+    return halted ? STATUS_HALTED : STATUS_OK;
+}
+
+
 // Valid from 00-03-01 to 99-02-28
 // Input: y = 00-99, m = 1-12, d = 1-31
 // Output: Sunday = 1, Saturday = 7
@@ -199,12 +572,6 @@ uint8_t CRTC::BCD_to_DEC(const uint8_t b)
 }
 
 
-uint8_t CRTC::GetSRAMSize(void)
-{
-    return 0;
-}
-
-
 uint8_t CRTC::FitSRAMRange(const uint8_t offset, const uint8_t bytes)
 {
     uint8_t length;
@@ -229,7 +596,14 @@ uint8_t CRTC::FitSRAMRange(const uint8_t offset, const uint8_t bytes)
 
 CRTC::status_t CRTC::I2CWrite(const uint8_t address, const uint8_t data[], const uint8_t bytes)
 {
-    return (nI2C->Write(m_i2c_handle, address, data, bytes) == 0) ? STATUS_OK : STATUS_ERROR;
+    status_t status = I2CTransfer(true, address, const_cast<uint8_t*>(data), bytes);
+
+    if ((status == STATUS_OK) && (m_scope != nullptr))
+    {
+        m_scope->Write(address, data, bytes);
+    }
+
+    return status;
 }
 
 
@@ -242,14 +616,92 @@ CRTC::status_t CRTC::I2CWriteByte(const uint8_t address, const uint8_t data)
 
 CRTC::status_t CRTC::I2CRead(const uint8_t address, uint8_t data[], const uint8_t bytes)
 {
-    return (nI2C->Read(m_i2c_handle, address, data, bytes) == 0) ? STATUS_OK : STATUS_ERROR;
+    if ((m_scope != nullptr) && m_scope->Read(address, data, bytes))
+    {
+        m_status = STATUS_OK;
+        return m_status;
+    }
+
+    return I2CTransfer(false, address, data, bytes);
 }
 
 
-uint8_t CRTC::I2CReadByte(const uint8_t address)
+CRTC::status_t CRTC::I2CReadByte(const uint8_t address, uint8_t &data)
 {
-    uint8_t data[1] = {0};
+    return I2CRead(address, &data, 1);
+}
+
+
+CRTC::status_t CRTC::I2CTransfer(const bool write, const uint8_t address, uint8_t data[], const uint8_t bytes)
+{
+    uint32_t start = millis();
+    uint16_t backoff = m_backoff;
+
+    if (m_bus == nullptr)
+    {
+        m_status = STATUS_BUS_ERROR;
+        return m_status;
+    }
+
+    for (uint8_t attempt = 0; ; attempt++)
+    {
+        uint8_t result = write ? m_bus->Write(m_bus_handle, address, data, bytes)
+                               : m_bus->Read(m_bus_handle, address, data, bytes);
+
+        if (result == 0)
+        {
+            m_status = STATUS_OK;
+            break;
+        }
+
+        if (attempt >= m_retries)
+        {
+            m_status = STATUS_BUS_ERROR;
+            break;
+        }
+
+        uint32_t elapsed = (millis() - start);
+
+        if (elapsed >= m_timeout)
+        {
+            m_status = STATUS_TIMEOUT;
+            break;
+        }
+
+        if (m_recovery)
+        {
+            m_recovery();
+        }
+
+        // Exponential backoff between attempts, never past the time budget.
+        // delayMicroseconds is only accurate to about 16 ms on AVR, so
+        // whole milliseconds go through delay.
+        uint32_t sleep = (m_timeout - elapsed) * 1000UL;
+
+        if (backoff < sleep)
+        {
+            sleep = backoff;
+        }
+
+        if (sleep >= 1000)
+        {
+            delay(sleep / 1000);
+        }
+
+        if (sleep % 1000)
+        {
+            delayMicroseconds(sleep % 1000);
+        }
+
+        backoff = (backoff > 0x7FFF) ? 0xFFFF : (backoff << 1);
+
+        // The budget may have run out while sleeping
+        if ((millis() - start) >= m_timeout)
+        {
+            m_status = STATUS_TIMEOUT;
+            break;
+        }
+    }
 
-    I2CRead(address, data, 1);
-    return data[0];
+    return m_status;
 }
@@ -28,9 +28,10 @@
 #ifndef _RTC_H_
 #define _RTC_H_
 
-#include <avr/interrupt.h>
 #include <inttypes.h>
-#include <nI2C.h>
+#include "RTCBus.h"
+
+#define UNUSED(x) (void)(x)
 
 class CRTC
 {
@@ -39,7 +40,12 @@ class CRTC
     enum status_t : uint8_t
     {
         STATUS_OK = 0,
-        STATUS_ERROR,
+        STATUS_ERROR,       // Generic failure
+        STATUS_BUS_ERROR,   // Transaction failed after all retries
+        STATUS_TIMEOUT,     // Retries abandoned after the time budget
+        STATUS_STALE,       // Bus read failed; cached data returned
+        STATUS_HALTED,      // Oscillator stopped; time may be wrong
+        STATUS_INVALID,     // Register contents out of range
     };
     
     enum class State : uint8_t
@@ -65,12 +71,20 @@ class CRTC
             , month{0}
             , year{0}
             , week_day{0}
-            , am{0}
-            , twelve_hour{0}
         {
             // empty
         }
         
+        bool IsAM(void) const
+        {
+            return (hour < 12);
+        }
+        
+        uint8_t TwelveHour(void) const
+        {
+            return ((hour % 12) == 0) ? 12 : (hour % 12);
+        }
+        
         uint8_t second;
         uint8_t minute;
         uint8_t hour;
@@ -78,54 +92,269 @@ class CRTC
         uint8_t month;
         uint8_t year;
         uint8_t week_day;
-        bool am;
-        uint8_t twelve_hour;
     };
     
+    // Packed date-time: seconds since 2000-01-01 00:00:00 (valid to 2099)
+    struct Timestamp
+    {
+        constexpr Timestamp()
+            : epoch{0}
+        {
+            // empty
+        }
+        
+        constexpr explicit Timestamp(const uint32_t value)
+            : epoch{value}
+        {
+            // empty
+        }
+        
+        constexpr Timestamp(const uint8_t y, const uint8_t m, const uint8_t d,
+                            const uint8_t h, const uint8_t mi, const uint8_t s)
+            : epoch{(uint32_t)((86400UL * DaysFromCivil(y, m, d)) + (3600UL * h) + (60UL * mi) + s)}
+        {
+            // empty
+        }
+        
+        explicit Timestamp(const RTC &rtc)
+            : Timestamp(rtc.year, rtc.month, rtc.day, rtc.hour, rtc.minute, rtc.second)
+        {
+            // empty
+        }
+        
+        constexpr uint8_t Second(void) const { return (epoch % 60); }
+        constexpr uint8_t Minute(void) const { return ((epoch / 60) % 60); }
+        constexpr uint8_t Hour(void) const { return ((epoch / 3600) % 24); }
+        constexpr uint8_t Year(void) const { return YearFromDays(Days()); }
+        constexpr uint8_t Month(void) const { return MonthFromDay(DayOfYear(), Year()); }
+        constexpr uint8_t Day(void) const { return DayFromDay(DayOfYear(), Year()); }
+        constexpr uint8_t WeekDay(void) const { return (1 + ((Days() + 6) % 7)); } // Sunday = 1
+        constexpr bool IsAM(void) const { return (Hour() < 12); }
+        constexpr uint8_t TwelveHour(void) const { return ((Hour() % 12) == 0) ? 12 : (Hour() % 12); }
+        constexpr uint16_t Days(void) const { return (epoch / 86400); }
+        constexpr uint16_t DayOfYear(void) const { return DayOfYearFromDays(Days()); } // 0-365
+        
+        void ToRTC(RTC &rtc) const
+        {
+            uint16_t day_of_year = DayOfYear();
+            
+            rtc.second = Second();
+            rtc.minute = Minute();
+            rtc.hour = Hour();
+            rtc.year = Year();
+            rtc.month = MonthFromDay(day_of_year, rtc.year);
+            rtc.day = DayFromDay(day_of_year, rtc.year);
+            rtc.week_day = WeekDay();
+        }
+        
+        // Days since 2000-01-01 for y = 00-99, m = 1-12, d = 1-31
+        static constexpr uint16_t DaysFromCivil(const uint8_t y, const uint8_t m, const uint8_t d)
+        {
+            return (365 * y) + ((y + 3) / 4) + (((367 * m) - 362) / 12) + d - 1
+                - ((m > 2) ? (((y % 4) == 0) ? 1 : 2) : 0);
+        }
+        
+        // Four year cycles starting with a leap year
+        static constexpr uint8_t YearFromDays(const uint16_t days)
+        {
+            return (4 * (days / 1461))
+                + (((days % 1461) < 366) ? 0 : (1 + (((days % 1461) - 366) / 365)));
+        }
+        
+        static constexpr uint16_t DayOfYearFromDays(const uint16_t days)
+        {
+            return ((days % 1461) < 366) ? (days % 1461) : (((days % 1461) - 366) % 365);
+        }
+        
+        // Days since March 1st, or negative for January and February
+        static constexpr int16_t DayOfMarchYear(const uint16_t day_of_year, const uint8_t y)
+        {
+            return (int16_t)day_of_year - 59 - (((y % 4) == 0) ? 1 : 0);
+        }
+        
+        static constexpr uint8_t MonthFromDay(const uint16_t day_of_year, const uint8_t y)
+        {
+            return (DayOfMarchYear(day_of_year, y) >= 0)
+                ? (3 + (((5 * DayOfMarchYear(day_of_year, y)) + 2) / 153))
+                : ((day_of_year < 31) ? 1 : 2);
+        }
+        
+        static constexpr uint8_t DayFromDay(const uint16_t day_of_year, const uint8_t y)
+        {
+            return (DayOfMarchYear(day_of_year, y) >= 0)
+                ? (1 + DayOfMarchYear(day_of_year, y)
+                    - (((153 * ((((5 * DayOfMarchYear(day_of_year, y)) + 2) / 153))) + 2) / 5))
+                : ((day_of_year < 31) ? (day_of_year + 1) : (day_of_year - 30));
+        }
+        
+        uint32_t epoch;
+    };
+    
+    // Daily alarm as BCD register values (see AlarmDaily in RTCLiteral.h)
+    struct AlarmImage
+    {
+        constexpr AlarmImage(const uint8_t s, const uint8_t m, const uint8_t h)
+            : second{s}
+            , minute{m}
+            , hour{h}
+        {
+            // empty
+        }
+        
+        uint8_t second;
+        uint8_t minute;
+        uint8_t hour;
+    };
+    
+    // RTC with sub-second resolution
+    struct RTCX : public RTC
+    {
+        RTCX()
+            : RTC()
+            , centisecond{0}
+        {
+            // empty
+        }
+
+        uint8_t centisecond;
+    };
+
+    // Reads the driver's register window in one burst and serves every
+    // getter from it while in scope, so date, time and alarm values are
+    // coherent and the bus is read once. Writes go through to the device
+    // and update the window, except a write to a volatile register, after
+    // which getters read the bus again. An inner scope defers to the outer.
+    class ReadScope
+    {
+        public:
+        enum scope_t : uint8_t
+        {
+            SCOPE_SIZE = 20,
+        };
+
+        explicit ReadScope(CRTC &rtc);
+        ~ReadScope();
+        ReadScope(const ReadScope &) = delete;
+        ReadScope &operator=(const ReadScope &) = delete;
+
+        // False when the burst failed; getters then use the bus as usual
+        bool IsValid(void) const;
+        status_t GetStatus(void) const;
+
+        protected:
+        friend class CRTC;
+
+        bool Read(const uint8_t address, uint8_t data[], const uint8_t bytes) const;
+        void Write(const uint8_t address, const uint8_t data[], const uint8_t bytes);
+
+        CRTC &m_rtc;
+        status_t m_status;
+        uint8_t m_address;
+        uint8_t m_bytes;
+        uint8_t m_data[SCOPE_SIZE];
+    };
+
+    // Bus recovery hook, called before each retry
+    typedef void (*recovery_t)(void);
+    
     protected:
-    RTC m_rtc;
-    CI2C::Handle m_i2c_handle;
+    Timestamp m_time; // Last valid time read
+    ReadScope *m_scope;
+    CRTCBus *m_bus;
+    CRTCBus::handle_t m_bus_handle;
+    CRTCBus::Speed m_speed;
+    recovery_t m_recovery;
+    uint16_t m_backoff;
+    uint16_t m_timeout;
+    uint8_t m_retries;
+    status_t m_status;
     
     public:
     // Default constructor
     CRTC(void);
     
+    // Select the transport before Initialize (default nI2C on Arduino)
+    void SetBus(CRTCBus &bus, const CRTCBus::Speed speed = CRTCBus::Speed::FAST);
+    
     // Initialize the RTC
     virtual void Initialize(void);
     
     // RTC functions
-    virtual void GetRTC(RTC &rtc) = 0;
+    virtual status_t GetRTC(RTC &rtc) = 0;
     virtual status_t SetRTC(const RTC &rtc) = 0;
     
     // Time functions
     uint32_t GetTimeSeconds(void);
-    void GetTime(uint8_t &hour, uint8_t &minute, uint8_t &second);
+    status_t GetTime(uint8_t &hour, uint8_t &minute, uint8_t &second);
     status_t SetTime(const uint8_t hour, const uint8_t minute, const uint8_t second);
     
     // Date functions
-    void GetDate(uint8_t &year, uint8_t &month, uint8_t &day);
+    status_t GetDate(uint8_t &year, uint8_t &month, uint8_t &day);
     status_t SetDate(const uint8_t year, const uint8_t month, const uint8_t day);
     
+    // Epoch functions (seconds since 2000-01-01 00:00:00)
+    uint32_t GetEpoch(void);
+    status_t GetEpoch(uint32_t &epoch);
+    uint32_t ToEpoch(const RTC &rtc);
+    void FromEpoch(const uint32_t epoch, RTC &rtc);
+    status_t GetTimestamp(Timestamp &time);
+    
     // Temperature functions
     float ConvertTemperature(const float temperature, const Unit input_unit, const Unit output_unit);
     
     // Alarm functions
     virtual status_t SetAlarmRTC(const RTC &rtc) = 0;
-    virtual void GetAlarmRTC(RTC &rtc) = 0;
+    virtual status_t GetAlarmRTC(RTC &rtc) = 0;
     virtual status_t SetAlarmState(const State state) = 0;
     virtual State GetAlarmState(void) = 0;
     virtual bool IsAlarmTriggered(void) = 0;
+    
+    // As above, but a failed read is reported instead of read as
+    // disabled/not triggered; the output is left unchanged on failure
+    virtual status_t GetAlarmState(State &state);
+    virtual status_t IsAlarmTriggered(bool &triggered);
     virtual status_t AlarmReset(void) = 0;
     
     uint32_t GetAlarmSeconds(void);
     status_t SetAlarmTime(const uint8_t hour, const uint8_t minute, const uint8_t second);
-    void GetAlarmTime(uint8_t &hour, uint8_t &minute, uint8_t &second);
+    status_t GetAlarmTime(uint8_t &hour, uint8_t &minute, uint8_t &second);
     
-    protected:
+    // Pre-encoded alarm; drivers whose registers match write it unconverted
+    virtual status_t SetAlarmImage(const AlarmImage &alarm);
+    
+    // Bus error handling
+    void SetRetry(const uint8_t retries, const uint16_t backoff_us, const uint16_t timeout_ms);
+    void SetBusRecovery(const recovery_t recovery);
+    status_t GetStatus(void);
+    static void RecoverBus(const uint8_t scl_pin, const uint8_t sda_pin);
+    
+    // Battery backed SRAM functions (size 0 when not available)
+    virtual status_t GetSRAM(const uint8_t offset, uint8_t data[], const uint8_t bytes);
+    virtual status_t SetSRAM(const uint8_t offset, const uint8_t data[], const uint8_t bytes);
     virtual uint8_t GetSRAMSize(void);
+    
+    // Time and SRAM together, in one transfer where the registers allow
+    virtual status_t GetRTCAndSRAM(RTC &rtc, const uint8_t offset, uint8_t data[], const uint8_t bytes);
+    
+    // Precise clock output for calibrating the MCU oscillator (0 Hz when
+    // none). StartReference enables it and returns the previous output
+    // configuration, which StopReference restores.
+    virtual uint32_t GetReferenceFrequency(void);
+    virtual status_t StartReference(uint8_t &saved);
+    virtual status_t StopReference(const uint8_t saved);
+    
+    protected:
     virtual uint8_t GetI2CAddress(void) = 0;
     
+    // Register window captured by ReadScope (none by default)
+    virtual void GetScopeRange(uint8_t &address, uint8_t &bytes);
+
+    // Register the chip changes on or after a write (flags cleared by
+    // writing, self-clearing bits); writing one ends ReadScope caching
+    virtual bool IsScopeVolatile(const uint8_t address);
+    
     uint32_t GetSeconds(const RTC &rtc);
+    status_t ValidateRTC(RTC &rtc, const bool halted);
     uint8_t DayOfWeek(uint16_t y, const uint8_t m, const uint8_t d);
     uint8_t DEC_to_BCD(const uint8_t d);
     uint8_t BCD_to_DEC(const uint8_t b);
@@ -134,7 +363,10 @@ class CRTC
     status_t I2CWrite(const uint8_t address, const uint8_t data[], const uint8_t bytes);
     status_t I2CWriteByte(const uint8_t address, const uint8_t data);
     status_t I2CRead(const uint8_t address, uint8_t data[], const uint8_t bytes);
-    uint8_t I2CReadByte(const uint8_t address);
+    status_t I2CReadByte(const uint8_t address, uint8_t &data);
+    status_t I2CTransfer(const bool write, const uint8_t address, uint8_t data[], const uint8_t bytes);
 };
+
+static_assert(sizeof(CRTC::Timestamp) == 4, "Timestamp must stay packed");
     
 #endif